@@ -0,0 +1,75 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+/* -------------------------------------------------------------------------- */
+/*        Aligned arena for boards and scratch buffers (huge page aware)       */
+/* -------------------------------------------------------------------------- */
+
+// An arena is one mapping that boards and scratch buffers are carved from by bumping
+// a pointer. Nothing is freed on its own: arenaReset hands everything back at once so
+// the same memory serves the next run (the growing board starts over in its arena when
+// it is rewound or loaded, and moves into a spare one it zeroed ahead), and arenaFree
+// returns the mapping to the system.
+
+// Enum for the pages backing an arena.
+enum ArenaPages
+{
+    ARENA_NORMAL_PAGES = 1,
+    ARENA_TRANSPARENT_HUGE_PAGES = 2,
+    ARENA_EXPLICIT_HUGE_PAGES = 3
+};
+typedef enum ArenaPages ArenaPages;
+
+// Alignment of every board row, a cache line
+#define ARENA_CACHE_LINE 64
+
+typedef struct Arena Arena;
+
+// Map an arena. Explicit huge pages fall back to transparent ones, and those to normal pages, when the system has none
+//    Param: (size_t) capacity (Bytes the arena must be able to hand out)
+//           (ArenaPages) pages (Pages wanted for the arena)
+//    Return: (Arena*) The arena, NULL if no memory could be mapped
+Arena *arenaCreate(size_t capacity, ArenaPages pages);
+
+// Hand out a block of the arena
+//    Param: (Arena*) arena (The arena)
+//           (size_t) size (Size of the block in bytes)
+//           (size_t) alignment (Alignment of the block, a power of two)
+//    Return: (void*) The block, NULL if the arena is full
+void *arenaAllocate(Arena *arena, size_t size, size_t alignment);
+
+// Bytes a board takes in an arena, to size the arena before allocating boards
+//    Param: (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//    Return: (size_t) Size in bytes, alignment included
+size_t arenaBoardSize(int HEIGHT, int WIDTH);
+
+// Hand out a board: row pointers and cache line aligned rows in one block
+// A fresh arena gives dead boards, after arenaReset the Cells hold whatever was there before
+//    Param: (Arena*) arena (The arena)
+//           (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//    Return: (int**) The board, NULL if the arena is full
+int **arenaBoardAllocate(Arena *arena, int HEIGHT, int WIDTH);
+
+// Take back everything handed out, keeping the memory for the next run
+//    Param: (Arena*) arena (The arena)
+void arenaReset(Arena *arena);
+
+// Bytes the arena can hand out, at least the capacity it was created with
+//    Param: (Arena*) arena (The arena)
+//    Return: (size_t) Size in bytes
+size_t arenaCapacity(Arena *arena);
+
+// Pages that really back the arena
+//    Param: (Arena*) arena (The arena)
+//    Return: (ArenaPages) The pages
+ArenaPages arenaPages(Arena *arena);
+
+// Unmap the arena, every block handed out becomes invalid
+//    Param: (Arena*) arena (The arena)
+void arenaFree(Arena *arena);
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stdint.h>
+
+/* -------------------------------------------------------------------------- */
+/*       Batch of independent boards of one size, stepped in lockstep         */
+/* -------------------------------------------------------------------------- */
+
+// The boards of a batch are bit-sliced: every Cell position is one 64-bit word, and bit
+// i of the word is that Cell on board i (its lane). The bitwise adders of the fixed-size
+// engines then count the neighbours of a Cell on all 64 boards at once. Lanes are loaded
+// and extracted one by one, so a board that settled can be swapped for a fresh one while
+// the others keep going.
+
+// Boards in a batch, one per bit of a Cell word
+#define BATCH_LANES 64
+
+typedef struct Batch Batch;
+
+// Create a batch of dead boards
+//    Param: (int) HEIGHT (HEIGHT of every Board)
+//           (int) WIDTH (WIDTH of every Board)
+//    Return: (Batch*) The batch, NULL if its memory could not be allocated
+Batch *batchCreate(int HEIGHT, int WIDTH);
+
+// Put a board into a lane, starting it again at generation 0
+//    Param: (Batch*) batch (The batch)
+//           (int) lane (Lane of the board, 0 to BATCH_LANES - 1)
+//           (int**) board (Pointer to A 2D Dynamic Interger Array that serves as the Game Board, as lifeBoard gives it)
+void batchLoad(Batch *batch, int lane, int **board);
+
+// Put random Cells into a lane, drawn from rand() in the same order as lifeRandomize
+// so that a seed gives the same board in a batch as in the game
+//    Param: (Batch*) batch (The batch)
+//           (int) lane (Lane of the board)
+void batchRandomize(Batch *batch, int lane);
+
+// Copy the board of a lane out
+//    Param: (Batch*) batch (The batch)
+//           (int) lane (Lane of the board)
+//           (int**) board (Pointer to A 2D Dynamic Interger Array that receives the Game Board)
+void batchExtract(Batch *batch, int lane, int **board);
+
+// Write the board of a lane to a file, in the format lifeLoad reads
+//    Param: (Batch*) batch (The batch)
+//           (int) lane (Lane of the board)
+//           (string) fileName (Name of the board file)
+//    Return: (int) 0 on success, -1 if the file could not be written
+int batchSave(Batch *batch, int lane, char *fileName);
+
+// Calculate a number of generations on every lane
+//    Param: (Batch*) batch (The batch)
+//           (int) generations (Number of generations to calculate)
+void batchStep(Batch *batch, int generations);
+
+// Lanes whose board has settled: it did not change in the last generation, or came back to
+// the board of the generation before (still lifes, blinkers and dead boards)
+//    Param: (Batch*) batch (The batch)
+//    Return: (uint64_t) Bit i is set if lane i has settled, lanes never loaded count as settled
+uint64_t batchStable(Batch *batch);
+
+// Generations calculated since the board of a lane was loaded
+//    Param: (Batch*) batch (The batch)
+//           (int) lane (Lane of the board)
+//    Return: (long) The generation
+long batchGeneration(Batch *batch, int lane);
+
+// Free a batch
+//    Param: (Batch*) batch (The batch)
+void batchFree(Batch *batch);
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef CHANGELIST_H
+#define CHANGELIST_H
+
+#include <stdio.h>
+#include <stats.h>
+
+/* -------------------------------------------------------------------------- */
+/*        Engine visiting only the Cells next to those that just changed       */
+/* -------------------------------------------------------------------------- */
+
+// Every Cell keeps its live neighbour count, updated when a neighbour is born or dies,
+// and the engine keeps the list of Cells that flipped in the last generation. Only a Cell
+// that flipped or whose count changed can flip next, so a generation visits the flipped
+// Cells and their neighbours and nothing else: a still board with a few blinkers costs
+// the blinkers. The board is the row-major one of the caller, written Cell by Cell.
+
+typedef struct ChangeList ChangeList;
+
+// Create the engine for a board
+//    Param: (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//    Return: (ChangeList*) The engine, NULL if it could not be allocated or the board is too large to index
+ChangeList *changeListCreate(int HEIGHT, int WIDTH);
+
+// Count the neighbours of every Cell of a board and mark every live Cell as changed
+// Cells that are not 1 are written as 0, as the other engines do on their first generation
+//    Param: (ChangeList*) list (The engine)
+//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
+void changeListLoad(ChangeList *list, int **currentBoard);
+
+// Calculate a number of generations, same result as calling calculateNextBoard as many times
+//    Param: (ChangeList*) list (The engine, loaded with the board)
+//           (int) generations (Number of generations to calculate)
+//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board, updated in place)
+//           (StatsRecorder*) recorder (Receives the statistics of every generation, or NULL)
+void changeListStep(ChangeList *list, int generations, int **currentBoard, StatsRecorder *recorder);
+
+// Print how many Cells a generation visited and flipped on average
+//    Param: (ChangeList*) list (The engine)
+//           (FILE*) stream (Where to print)
+void changeListReport(ChangeList *list, FILE *stream);
+
+// Free the engine
+//    Param: (ChangeList*) list (The engine)
+void changeListFree(ChangeList *list);
+
+#endif
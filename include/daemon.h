@@ -0,0 +1,134 @@
+#ifndef DAEMON_H
+#define DAEMON_H
+
+#include <stdint.h>
+#include <stats.h>
+#include <life.h>
+
+/* -------------------------------------------------------------------------- */
+/*        Life as a local service, driven over a UNIX domain socket           */
+/* -------------------------------------------------------------------------- */
+
+// The daemon keeps boards resident between requests and serves any number of clients,
+// each connection being a session. A client may send many requests without waiting for
+// the replies: the daemon reads what has arrived, up to a megabyte, runs it in order as
+// one batch and sends the replies back in one write, or as they come once they pass a
+// megabyte, as the frames of a long step do. Sessions are served in parallel on a pool of
+// worker threads; requests on one board are serialised, boards are shared by id.
+//
+// Every message is a fixed header followed by `length` bytes of payload, all in the byte
+// order and layout of the machine, clients being local. Cells travel packed in bits, row
+// by row, the first Cell in the lowest bit of the first byte.
+
+// Largest payload accepted, a session sending more is closed
+#define DAEMON_MAX_PAYLOAD (64u << 20)
+
+// Enum for the requests, and the frames the daemon pushes to subscribed sessions.
+//    DAEMON_CREATE     payload DaemonCreate, replies the new board in the header
+//    DAEMON_LOAD       payload the name of a board file, replies the new board in the header; names are relative to the
+//                      working directory of the daemon and may not climb out of it with "..", as for DAEMON_SAVE
+//    DAEMON_RANDOMIZE  payload uint32_t seed, replaces the board with random Cells
+//    DAEMON_STEP       payload int32_t generations, replies the GenerationStats of the last one
+//    DAEMON_STATS      replies the GenerationStats of the board
+//    DAEMON_REGION     payload DaemonRegion, replies the region clipped to the board and its Cells
+//    DAEMON_SET        payload DaemonRegion and its Cells, written over the board
+//    DAEMON_SAVE       payload the name of a board file
+//    DAEMON_SUBSCRIBE  payload int32_t every, frames of every such generation follow (0 stops them);
+//                      a subscriber that stops reading holds up the board once its socket is full
+//    DAEMON_FREE       frees the board
+//    DAEMON_FRAME      pushed, never requested: GenerationStats, DaemonRegion of the whole board and its Cells
+enum DaemonOpcode
+{
+    DAEMON_CREATE = 1,
+    DAEMON_LOAD = 2,
+    DAEMON_RANDOMIZE = 3,
+    DAEMON_STEP = 4,
+    DAEMON_STATS = 5,
+    DAEMON_REGION = 6,
+    DAEMON_SET = 7,
+    DAEMON_SAVE = 8,
+    DAEMON_SUBSCRIBE = 9,
+    DAEMON_FREE = 10,
+    DAEMON_FRAME = 11
+};
+typedef enum DaemonOpcode DaemonOpcode;
+
+// Enum for the status of a reply.
+enum DaemonStatus
+{
+    DAEMON_OK = 0,
+    DAEMON_BAD_REQUEST = -1,
+    DAEMON_NO_BOARD = -2,
+    DAEMON_FILE_ERROR = -3,
+    DAEMON_NO_MEMORY = -4
+};
+typedef enum DaemonStatus DaemonStatus;
+
+// Header of a request. The tag is chosen by the client and returned in the reply.
+struct DaemonRequest
+{
+    uint32_t length;
+    uint16_t opcode;
+    uint16_t flags;
+    uint32_t tag;
+    int32_t board;
+};
+typedef struct DaemonRequest DaemonRequest;
+
+// Header of a reply or frame, status being a DaemonStatus.
+struct DaemonReply
+{
+    uint32_t length;
+    uint16_t opcode;
+    int16_t status;
+    uint32_t tag;
+    int32_t board;
+};
+typedef struct DaemonReply DaemonReply;
+
+// Payload of DAEMON_CREATE, engine 0 meaning the engine the daemon was started with (LARGER_ENGINE plays its rule, GROWING_ENGINE grows up to its limit).
+struct DaemonCreate
+{
+    int32_t HEIGHT;
+    int32_t WIDTH;
+    int32_t engine;
+};
+typedef struct DaemonCreate DaemonCreate;
+
+// A rectangle of Cells, followed by its Cells where there are some.
+struct DaemonRegion
+{
+    int32_t top;
+    int32_t left;
+    int32_t height;
+    int32_t width;
+};
+typedef struct DaemonRegion DaemonRegion;
+
+// Serve clients until SIGINT or SIGTERM (Server side)
+//    Param: (string) path (Path of the UNIX domain socket, replaced if it exists, only the user of the daemon may connect to it)
+//           (LifeOptions*) options (Options of the boards created, the engine being the default one)
+//           (int) workers (Threads serving sessions, 0 for one per core)
+//    Return: (int) 0 after a clean shutdown, -1 if the socket could not be set up
+int daemonServe(char *path, LifeOptions *options, int workers);
+
+// Connect to a daemon (Client side)
+//    Param: (string) path (Path of the UNIX domain socket)
+//    Return: (int) The connected socket, -1 if no daemon listens there
+int daemonConnect(char *path);
+
+// Send a request, all of it
+//    Param: (int) fd (The connected socket)
+//           (DaemonRequest*) request (The header, its length being that of the payload)
+//           (void*) payload (The payload, NULL when the length is 0)
+//    Return: (int) 0 on success, -1 if the connection broke
+int daemonSend(int fd, DaemonRequest *request, void *payload);
+
+// Receive the next reply or frame
+//    Param: (int) fd (The connected socket)
+//           (DaemonReply*) reply (Receives the header)
+//           (void**) payload (Receives the payload, allocated, to be freed by the caller, NULL when empty)
+//    Return: (int) 0 on success, -1 if the connection broke
+int daemonReceive(int fd, DaemonReply *reply, void **payload);
+
+#endif
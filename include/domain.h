@@ -0,0 +1,59 @@
+#ifndef DOMAIN_H
+#define DOMAIN_H
+
+#include <stats.h>
+#include <lifenuma.h>
+
+/* -------------------------------------------------------------------------- */
+/*   Multi-process domain decomposition of a Life board (Coordinator side)    */
+/* -------------------------------------------------------------------------- */
+
+// The board is cut into horizontal stripes, one per worker process. Every worker
+// keeps its stripe in its own memory and trades one halo row with each neighbour
+// per generation. The coordinator (the interactive program) only starts, steps,
+// gathers and stops the workers.
+
+// Enum for the way halo rows travel between neighbouring workers.
+enum DomainTransport
+{
+    SHARED_MEMORY = 1,
+    UNIX_SOCKET = 2
+};
+typedef enum DomainTransport DomainTransport;
+
+typedef struct Domain Domain;
+
+// Start the worker processes and hand them the initial board
+//    Param: (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//           (int) processes (Number of worker processes, reduced if the board has fewer rows)
+//           (DomainTransport) transport (How halo rows are exchanged)
+//           (NumaPinning) pinning (How to pin the worker processes)
+//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
+//    Return: (Domain*) The running domain, NULL if the workers could not be started
+Domain *domainStart(int HEIGHT, int WIDTH, int processes, DomainTransport transport, NumaPinning pinning, int **currentBoard);
+
+// Advance every stripe by a number of generations and wait for all workers to finish
+//    Param: (Domain*) domain (The running domain)
+//           (int) generations (Number of generations to calculate)
+//           (StatsRecorder*) recorder (Receives the statistics of every generation, or NULL)
+//    Return: (int) 0 on success, -1 if a worker died (the domain can only be stopped)
+int domainStep(Domain *domain, int generations, StatsRecorder *recorder);
+
+// Collect the stripes of all workers into a board (For rendering and saving)
+//    Param: (Domain*) domain (The running domain)
+//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that receives the Game Board)
+//    Return: (int) 0 on success, -1 if a worker died (the board is left untouched)
+int domainGather(Domain *domain, int **currentBoard);
+
+// Replace the stripes of all workers with a board (After the board was changed outside of the domain)
+//    Param: (Domain*) domain (The running domain)
+//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
+//    Return: (int) 0 on success, -1 if a worker died
+int domainScatter(Domain *domain, int **currentBoard);
+
+// Stop the worker processes and release the shared memory, killing them if one of them died
+//    Param: (Domain*) domain (The running domain)
+void domainStop(Domain *domain);
+
+#endif
@@ -143,6 +143,40 @@ bool econio_kbhit();
 int econio_getch();
 
 
+/**
+ * Start composing a frame. Drawing calls of the frame only fill a buffer,
+ * nothing reaches the terminal until econio_frame_commit(). If clear is true,
+ * the frame starts by clearing the screen.
+ */
+void econio_frame_begin(bool clear);
+
+
+/**
+ * Put a glyph (one or more UTF-8 characters, one column each) at position
+ * (x, y) of the frame, with the given text and background colors. Cursor
+ * jumps and color changes are only emitted when they are really needed.
+ */
+void econio_frame_put(int x, int y, char const *glyph, int fg, int bg);
+
+
+/** Jump to position (x, y) in the frame. Upper left corner is (0, 0). */
+void econio_frame_gotoxy(int x, int y);
+
+
+/**
+ * Append formatted text to the frame at the current position, in the default
+ * colors. Works like printf().
+ */
+void econio_frame_printf(char const *format, ...);
+
+
+/**
+ * Send the whole frame to the terminal at once. Anything still waiting in
+ * stdout is flushed first, so the frame is shown after it.
+ */
+void econio_frame_commit();
+
+
 /**
  * Delay for the specified amount of time (sec can be an arbitrary floating
  * point number, not just integer).
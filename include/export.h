@@ -0,0 +1,67 @@
+#ifndef EXPORT_H
+#define EXPORT_H
+
+/* -------------------------------------------------------------------------- */
+/*        Export of generations to images, encoded on a pool of threads       */
+/* -------------------------------------------------------------------------- */
+
+// Boards handed to an exporter are copied into a small ring of frames and return at
+// once; encoder threads turn the frames into images behind the simulation. Every frame
+// becomes its own PPM or PNG file, or all of them one animated GIF, written in order.
+// Live Cells are green and dead Cells black, as on screen, every Cell a square of pixels.
+
+// Pixels per Cell side and hundredths of a second per GIF frame when none are given
+#define EXPORT_DEFAULT_SCALE 4
+#define EXPORT_DEFAULT_DELAY 10
+
+// Enum for the image formats: numbered PPM or PNG files, or one animated GIF.
+enum ExportFormat
+{
+    EXPORT_PPM = 1,
+    EXPORT_PNG = 2,
+    EXPORT_GIF = 3
+};
+typedef enum ExportFormat ExportFormat;
+
+// Options of an exporter, filled with exportDefaultOptions and changed as needed.
+struct ExportOptions
+{
+    ExportFormat format;
+    int scale;
+    int threads;
+    int delay;
+};
+typedef struct ExportOptions ExportOptions;
+
+typedef struct Exporter Exporter;
+
+// Fill options with the defaults: GIF, EXPORT_DEFAULT_SCALE pixels per Cell side, one encoder per core and EXPORT_DEFAULT_DELAY per frame
+//    Param: (ExportOptions*) options (The options)
+void exportDefaultOptions(ExportOptions *options);
+
+// Format of a file name from its extension (.ppm, .png or .gif)
+//    Param: (string) fileName (Name of the file)
+//    Return: (ExportFormat) The format, 0 if the extension is none of them
+ExportFormat exportFormatOf(char *fileName);
+
+// Create an exporter and start its encoder threads
+// PPM and PNG frames are written next to the given name, numbered by generation (life.png gives life_000042.png)
+//    Param: (string) fileName (Name of the GIF, or of the frames before numbering)
+//           (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//           (ExportOptions*) options (The options, copied)
+//    Return: (Exporter*) The exporter, NULL if it could not be created
+Exporter *exporterCreate(char *fileName, int HEIGHT, int WIDTH, ExportOptions *options);
+
+// Hand a board over as the next frame, waiting only while every frame of the ring is still being encoded
+//    Param: (Exporter*) exporter (The exporter)
+//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board, copied)
+//           (long) generation (Generation of the board, numbers PPM and PNG frames)
+void exporterSubmit(Exporter *exporter, int **currentBoard, long generation);
+
+// Wait for every frame to be written, finish the files and free the exporter
+//    Param: (Exporter*) exporter (The exporter)
+//    Return: (long) Number of frames written, -1 if a file could not be written
+long exporterFinish(Exporter *exporter);
+
+#endif
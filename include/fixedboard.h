@@ -0,0 +1,35 @@
+#ifndef FIXEDBOARD_H
+#define FIXEDBOARD_H
+
+#include <stats.h>
+
+/* -------------------------------------------------------------------------- */
+/*       Engines specialised for small boards of a size fixed at compile time   */
+/* -------------------------------------------------------------------------- */
+
+// A board of one of the sizes below is kept as a stack array of rows, one machine word
+// per row and one bit per Cell. Every size gets its own kernel with the dimensions as
+// constants, so the loops unroll and the neighbour counts are a handful of bit operations
+// per row. Any other size is left to the generic engine.
+
+// Sizes with a fixed-size engine, a board has to be square and match one of them exactly
+#define FIXEDBOARD_SMALL 32
+#define FIXEDBOARD_LARGE 64
+
+// Check whether a fixed-size engine exists for a board
+//    Param: (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//    Return: (int) 1 if it exists, 0 otherwise
+int fixedBoardSupports(int HEIGHT, int WIDTH);
+
+// Calculate a number of generations with the fixed-size engine of the board, same result as calling calculateNextBoard as many times
+//    Param: (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//           (int) generations (Number of generations to calculate)
+//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
+//           (int**) nextBoard (Pointer to A 2D Dynamic Interger Array that serves as the next Game Board after calculations)
+//           (StatsRecorder*) recorder (Receives the statistics of every generation, or NULL)
+//    Return: (int) 1 if the board was calculated, 0 if there is no engine for its size and it was left untouched
+int fixedBoardStep(int HEIGHT, int WIDTH, int generations, int **currentBoard, int **nextBoard, StatsRecorder *recorder);
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef GROWBOARD_H
+#define GROWBOARD_H
+
+#include <stdio.h>
+#include <stats.h>
+#include <arena.h>
+
+/* -------------------------------------------------------------------------- */
+/*       Board growing past its edges as live Cells come near them            */
+/* -------------------------------------------------------------------------- */
+
+// The board of the caller is a window onto a larger plane: Cells that leave it live on,
+// and come back into it as they would on an endless board. The engine keeps byte Cells
+// for an extent of the plane holding every live Cell, which moves out by a row or a
+// column whenever a live Cell reaches its edge and back in once they have left, so a
+// generation costs the extent and not the memory behind it. The memory, two boards from
+// one arena, has room around the extent; when the extent reaches it, twice as much is
+// taken, with the new room on the side the extent grows to, and the generation that
+// needs it is calculated straight from the old memory into the new one, so moving the
+// Cells costs no pass of its own. The new memory is a spare arena, large enough for the
+// memory doubled along both sides: it is mapped, zeroed and faulted in a slice every
+// generation, sized so that it is ready before the extent, growing a Cell a generation,
+// can reach the edge of the memory. The generation moving the memory then maps nothing,
+// and the memory it gives up is unmapped by the next slice. Memory far larger than the
+// extent is given back the same way. The extent never grows past the limit: there its
+// edge is dead, as the edge of the other engines. The window stays at the same place on
+// the plane, so the board of the caller, its statistics and its saves keep their
+// coordinates; the Cells outside of it are handed out and taken back as a list, for the
+// history and the board files.
+
+// Largest side of the extent when none is given, in Cells
+#define GROW_DEFAULT_LIMIT 8192
+
+typedef struct GrowBoard GrowBoard;
+
+// Create the engine for a board, as a window at the upper left corner of an empty plane
+//    Param: (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//           (int) limit (Largest HEIGHT and WIDTH of the extent, at least those of the board)
+//           (ArenaPages) pages (Pages wanted for the memory of the Cells)
+//    Return: (GrowBoard*) The engine, NULL if it could not be allocated
+GrowBoard *growBoardCreate(int HEIGHT, int WIDTH, int limit, ArenaPages pages);
+
+// Replace the Cells of the window with those of a board, the Cells outside of it live on
+//    Param: (GrowBoard*) board (The engine)
+//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
+void growBoardLoad(GrowBoard *board, int **currentBoard);
+
+// Kill every Cell of the plane and bring those given to life outside of the window, whose Cells growBoardLoad gives next
+//    Param: (GrowBoard*) board (The engine)
+//           (int*) cells (Rows and columns of the live Cells, in pairs)
+//           (long) count (Number of live Cells)
+//    Return: (int) 0 on success, -1 if the Cells and the window do not fit the limit or no memory could be mapped (the plane is left untouched)
+int growBoardLoadPlane(GrowBoard *board, int *cells, long count);
+
+// Live Cells of the plane, inside and outside the window
+//    Param: (GrowBoard*) board (The engine)
+//    Return: (long) Number of live Cells
+long growBoardPopulation(GrowBoard *board);
+
+// Copy the live Cells of the plane outside of the window
+//    Param: (GrowBoard*) board (The engine)
+//           (int*) cells (Receives their rows and columns in pairs, with room for growBoardPopulation Cells)
+//    Return: (long) Number of Cells copied
+long growBoardOutside(GrowBoard *board, int *cells);
+
+// Copy the Cells of the window to a board
+//    Param: (GrowBoard*) board (The engine)
+//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
+void growBoardStore(GrowBoard *board, int **currentBoard);
+
+// Calculate a number of generations on the plane
+// The statistics are those of the window, as with the other engines
+//    Param: (GrowBoard*) board (The engine)
+//           (int) generations (Number of generations to calculate)
+//           (StatsRecorder*) recorder (Receives the statistics of every generation, or NULL)
+void growBoardStep(GrowBoard *board, int generations, StatsRecorder *recorder);
+
+// Place of the extent on the plane, the window being at (0, 0)
+//    Param: (GrowBoard*) board (The engine)
+//           (int*) top (Receives the row of its upper left corner)
+//           (int*) left (Receives the column of its upper left corner)
+//           (int*) HEIGHT (Receives its HEIGHT)
+//           (int*) WIDTH (Receives its WIDTH)
+void growBoardExtent(GrowBoard *board, int *top, int *left, int *HEIGHT, int *WIDTH);
+
+// Copy a rectangle of the plane, the Cells outside of the extent being dead
+//    Param: (GrowBoard*) board (The engine)
+//           (int) top (First row of the rectangle)
+//           (int) left (First column of the rectangle)
+//           (int) HEIGHT (HEIGHT of the rectangle)
+//           (int) WIDTH (WIDTH of the rectangle)
+//           (int**) cells (Receives the Cells, cells[r][c] being Cell (top + r, left + c) of the plane)
+void growBoardCopy(GrowBoard *board, int top, int left, int HEIGHT, int WIDTH, int **cells);
+
+// Print the extent, the memory behind it, how often the memory was replaced and what those generations cost
+//    Param: (GrowBoard*) board (The engine)
+//           (FILE*) stream (Where to print)
+void growBoardReport(GrowBoard *board, FILE *stream);
+
+// Free the engine
+//    Param: (GrowBoard*) board (The engine)
+void growBoardFree(GrowBoard *board);
+
+#endif
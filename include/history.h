@@ -0,0 +1,68 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <stddef.h>
+#include <stats.h>
+
+/* -------------------------------------------------------------------------- */
+/*        History of recent generations: keyframes and deltas in memory        */
+/* -------------------------------------------------------------------------- */
+
+// Every recorded board is kept either as a keyframe (all Cells, one bit each) or as a
+// delta (the Cells that changed since the board recorded before it). A keyframe is
+// taken every few boards, so going back never replays more than that many deltas.
+// When the history grows past its memory cap, the oldest keyframe and its deltas go.
+// A board may bring the live Cells of the plane outside of it (those of the growing
+// board), which are kept with it as they are, a list being as small as they get.
+
+// Keyframe interval and memory cap used when none is given
+#define HISTORY_DEFAULT_INTERVAL 16
+#define HISTORY_DEFAULT_MEGABYTES 64
+
+typedef struct History History;
+
+// Create an empty history
+//    Param: (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//           (int) interval (A keyframe is taken every interval boards)
+//           (size_t) capacity (Memory cap in bytes, the latest keyframe and its deltas are kept even past it)
+//    Return: (History*) The history, NULL if it could not be allocated
+History *historyCreate(int HEIGHT, int WIDTH, int interval, size_t capacity);
+
+// Record a board, after every board recorded before it
+//    Param: (History*) history (The history)
+//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
+//           (GenerationStats*) stats (Statistics of the board, given back when the history returns to it)
+//           (int*) outside (Rows and columns of the live Cells outside of the board in pairs, NULL if there are none)
+//           (long) count (Number of live Cells outside of the board)
+void historyPush(History *history, int **currentBoard, GenerationStats *stats, int *outside, long count);
+
+// Go back a number of recorded boards, forgetting the boards after the one returned to
+//    Param: (History*) history (The history)
+//           (int) steps (Number of boards to go back, reduced to what is still recorded)
+//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that receives the Game Board)
+//           (GenerationStats*) stats (Receives the statistics of the board)
+//    Return: (int) Number of boards gone back, 0 if the board was left untouched
+int historyBack(History *history, int steps, int **currentBoard, GenerationStats *stats);
+
+// Live Cells outside of the latest recorded board, as given to historyPush
+//    Param: (History*) history (The history)
+//           (long*) count (Receives their number)
+//    Return: (int*) Their rows and columns in pairs, owned by the history, NULL if there are none
+int *historyOutside(History *history, long *count);
+
+// Number of boards that can be gone back
+//    Param: (History*) history (The history)
+//    Return: (int) Number of boards
+int historyDepth(History *history);
+
+// Bytes the history takes
+//    Param: (History*) history (The history)
+//    Return: (size_t) Size in bytes
+size_t historySize(History *history);
+
+// Free a history
+//    Param: (History*) history (The history)
+void historyFree(History *history);
+
+#endif
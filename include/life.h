@@ -0,0 +1,283 @@
+#ifndef LIFE_H
+#define LIFE_H
+
+#include <stdio.h>
+
+/* -------------------------------------------------------------------------- */
+/*     liblife: Conway's Game of Life engine, with no terminal input/output    */
+/* -------------------------------------------------------------------------- */
+
+// A Life owns the board, the engine that calculates it, the statistics and the history.
+// The board is handed out as row pointers into the Life's own memory (no copies): it
+// holds the latest generation after every call, and may be written to as long as
+// lifeBoardChanged is called before the next step. Board files use the format of the
+// interactive game: HEIGHT and WIDTH, then every Cell row by row, all as native ints.
+// The growing board is a window onto a plane whose Cells live on past its edges: its
+// files go on with the live Cells outside of the board, their number and then the row
+// and column of each, which the other engines do not read, and its history keeps them.
+// The options are opaque as well, so that new ones do not change what programs built
+// against an older liblife.so pass to it.
+
+// Version of the API, raised whenever a declaration below changes incompatibly, and the major version of liblife.so with it
+#define LIFE_API_VERSION 7
+
+// Enum for the engines that calculate the next board: the single process engine, the multi-process domain,
+// the multi-threaded tile scheduler, the temporally blocked stepper, the Z-order tiled board, the
+// single process engine calculating in place, with one board instead of two, the change list
+// engine visiting only the Cells next to those that changed, the Larger than Life engine,
+// calculating the radius-R rule of the options instead of Conway's, and the growing board,
+// whose Cells live on past the edges of the board.
+enum LifeEngine
+{
+    GENERIC_ENGINE = 1,
+    DOMAIN_ENGINE = 2,
+    TILE_ENGINE = 3,
+    TEMPORAL_ENGINE = 4,
+    ZORDER_ENGINE = 5,
+    INPLACE_ENGINE = 6,
+    CHANGELIST_ENGINE = 7,
+    LARGER_ENGINE = 8,
+    GROWING_ENGINE = 9
+};
+typedef enum LifeEngine LifeEngine;
+
+typedef struct LifeOptions LifeOptions;
+typedef struct Life Life;
+
+// Defined in stats.h and perfcount.h, for the programs reading them
+typedef struct GenerationStats GenerationStats;
+typedef struct StatsSeries StatsSeries;
+typedef struct PerfCounters PerfCounters;
+
+// Create options with the defaults: the single process engine on normal pages with default tiles, no history, no series, no pinning, no counters, Conway's rule
+// and GROW_DEFAULT_LIMIT (growboard.h) Cells a side for the growing board
+//    Return: (LifeOptions*) The options, NULL if they could not be allocated
+LifeOptions *lifeOptionsCreate(void);
+
+// Copy options
+//    Param: (LifeOptions*) options (The options)
+//    Return: (LifeOptions*) The copy, NULL if it could not be allocated
+LifeOptions *lifeOptionsCopy(LifeOptions *options);
+
+// Free options
+//    Param: (LifeOptions*) options (The options)
+void lifeOptionsFree(LifeOptions *options);
+
+// Engine calculating the board, the other options only matter to the engines using them
+//    Param: (LifeOptions*) options (The options)
+//           (LifeEngine) engine (The engine)
+//    Return: (LifeEngine) The engine, for lifeOptionsEngine
+void lifeOptionsSetEngine(LifeOptions *options, LifeEngine engine);
+LifeEngine lifeOptionsEngine(LifeOptions *options);
+
+// Processes of the domain engine, and how the board is passed to them
+//    Param: (LifeOptions*) options (The options)
+//           (int) processes (Number of processes, at least 1)
+//           (int) transport (A DomainTransport of domain.h)
+void lifeOptionsSetProcesses(LifeOptions *options, int processes);
+void lifeOptionsSetTransport(LifeOptions *options, int transport);
+
+// Threads and tiles of the tile scheduler (and threads of the Larger than Life engine)
+//    Param: (LifeOptions*) options (The options)
+//           (int) threads (Number of threads, at least 1)
+//           (int) tileSize (Side of the tiles in Cells, 0 for the default)
+void lifeOptionsSetThreads(LifeOptions *options, int threads);
+void lifeOptionsSetTileSize(LifeOptions *options, int tileSize);
+
+// Generations the temporal stepper calculates per pass over the board
+//    Param: (LifeOptions*) options (The options)
+//           (int) depth (The depth, 0 for the one fitting the cache)
+void lifeOptionsSetDepth(LifeOptions *options, int depth);
+
+// Pages wanted for the memory of the board
+//    Param: (LifeOptions*) options (The options)
+//           (int) pages (An ArenaPages of arena.h)
+void lifeOptionsSetPages(LifeOptions *options, int pages);
+
+// Size of the history, 0 for none, and generations between the boards it records
+//    Param: (LifeOptions*) options (The options)
+//           (int) megabytes (Memory of the history)
+//           (int) interval (Generations between recorded boards, at least 1)
+//    Return: (int) The interval, for lifeOptionsInterval
+void lifeOptionsSetHistory(LifeOptions *options, int megabytes);
+void lifeOptionsSetInterval(LifeOptions *options, int interval);
+int lifeOptionsInterval(LifeOptions *options);
+
+// Keep the statistics of every generation (see lifeSeries)
+//    Param: (LifeOptions*) options (The options)
+//           (int) keep (1 to keep them, 0 not to)
+void lifeOptionsSetSeries(LifeOptions *options, int keep);
+
+// Where the threads and the memory of the tile scheduler are placed
+//    Param: (LifeOptions*) options (The options)
+//           (int) pinning (A NumaPinning of lifenuma.h)
+void lifeOptionsSetPinning(LifeOptions *options, int pinning);
+
+// Open the hardware counters (see lifeCounters)
+//    Param: (LifeOptions*) options (The options)
+//           (int) counters (1 to open them, 0 not to)
+void lifeOptionsSetCounters(LifeOptions *options, int counters);
+
+// Rule calculated by the Larger than Life engine, the others calculating Conway's
+//    Param: (LifeOptions*) options (The options)
+//           (string) rule (The rule, written as in Golly or the name of a known one, see ltl.h)
+//    Return: (int) 0 on success, -1 if the rule is not valid or not supported (the rule is left alone)
+int lifeOptionsSetRule(LifeOptions *options, const char *rule);
+
+// Largest side of the extent of the growing board
+//    Param: (LifeOptions*) options (The options)
+//           (int) limit (The limit in Cells, at least the sides of the board)
+void lifeOptionsSetGrowLimit(LifeOptions *options, int limit);
+
+// Create a Life with a dead board
+//    Param: (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//           (LifeOptions*) options (The options, copied)
+//    Return: (Life*) The Life, NULL if its memory could not be allocated
+Life *lifeCreate(int HEIGHT, int WIDTH, LifeOptions *options);
+
+// Read the size of the board in a board file
+//    Param: (string) fileName (Name of the board file)
+//           (int*) HEIGHT (Receives the HEIGHT of the board)
+//           (int*) WIDTH (Receives the WIDTH of the board)
+//    Return: (int) 0 on success, -1 if the file could not be read
+int lifeReadSize(char *fileName, int *HEIGHT, int *WIDTH);
+
+// Replace the board with the board of a file of the same size
+//    Param: (Life*) life (The Life)
+//           (string) fileName (Name of the board file)
+//    Return: (int) 0 on success, -1 if the file could not be read, holds a board of another size or, for the started growing board,
+//            Cells past its limit (the board is left untouched)
+int lifeLoad(Life *life, char *fileName);
+
+// Write the board to a file
+//    Param: (Life*) life (The Life)
+//           (string) fileName (Name of the board file)
+//    Return: (int) 0 on success, -1 if the file could not be written
+int lifeSave(Life *life, char *fileName);
+
+// Replace the board with random Cells drawn from rand()
+//    Param: (Life*) life (The Life)
+void lifeRandomize(Life *life);
+
+// Start the chosen engine on the board, falling back to the single process engine if it can not start
+// Stepping a Life that was not started starts it first
+//    Param: (Life*) life (The Life)
+//    Return: (int) 1 if the chosen engine runs, 0 if the single process engine runs instead
+int lifeStart(Life *life);
+
+// Calculate a number of generations with the chosen engine
+// The history records the board once the generations are calculated, not every generation in between
+//    Param: (Life*) life (The Life)
+//           (int) generations (Number of generations to calculate)
+void lifeStep(Life *life, int generations);
+
+// Calculate a number of generations with the fastest engine available for the board
+// The single process engine borrows the tile scheduler on all cores (or the temporal stepper on one core)
+// As with lifeStep, the history records only the board reached
+//    Param: (Life*) life (The Life)
+//           (int) generations (Number of generations to calculate)
+void lifeStepFastest(Life *life, int generations);
+
+// Take the board back to a board recorded in the history
+//    Param: (Life*) life (The Life)
+//           (int) steps (Number of recorded boards to go back)
+//    Return: (int) Number of boards gone back, 0 without history or when there is nothing to go back to
+int lifeRewind(Life *life, int steps);
+
+// Publish the board to a shared memory object that viewers in other processes can read (see publish.h)
+// The board is published now, then after every rewind or change and every given number of generations
+//    Param: (Life*) life (The Life)
+//           (string) name (Name of the shared memory object)
+//           (int) every (Publish every generation that is a multiple of it, 1 for all of them)
+//    Return: (int) 0 on success, -1 if the shared memory object could not be created, -2 if another object has that name
+int lifePublish(Life *life, char *name, int every);
+
+// The board, as row pointers into the memory of the Life, up to date until the board is stepped again
+//    Param: (Life*) life (The Life)
+//    Return: (int**) The board, Cell (r, c) being board[r][c] with 1 for alive and 0 for dead
+int **lifeBoard(Life *life);
+
+// Hand the board to the engine (and the history) after it was written to from outside
+//    Param: (Life*) life (The Life)
+void lifeBoardChanged(Life *life);
+
+// Read a Cell
+//    Param: (Life*) life (The Life)
+//           (int) r (Row of the Cell)
+//           (int) c (Column of the Cell)
+//    Return: (int) 1 if the Cell is alive, 0 otherwise
+int lifeGetCell(Life *life, int r, int c);
+
+// Write a Cell, call lifeBoardChanged once all Cells are written
+//    Param: (Life*) life (The Life)
+//           (int) r (Row of the Cell)
+//           (int) c (Column of the Cell)
+//           (int) value (1 for alive, anything else for dead)
+void lifeSetCell(Life *life, int r, int c, int value);
+
+// Part of the plane holding the board and every live Cell, the board being at rows 0 to HEIGHT - 1 and columns 0 to WIDTH - 1 of it
+// Only the started growing board has Cells past the edges of the board, for the other engines this is the board itself
+//    Param: (Life*) life (The Life)
+//           (int*) top (Receives the row of its upper left corner)
+//           (int*) left (Receives the column of its upper left corner)
+//           (int*) HEIGHT (Receives its HEIGHT)
+//           (int*) WIDTH (Receives its WIDTH)
+void lifeExtent(Life *life, int *top, int *left, int *HEIGHT, int *WIDTH);
+
+// Copy a rectangle of the plane, the Cells outside of the extent being dead
+//    Param: (Life*) life (The Life)
+//           (int) top (First row of the rectangle)
+//           (int) left (First column of the rectangle)
+//           (int) HEIGHT (HEIGHT of the rectangle)
+//           (int) WIDTH (WIDTH of the rectangle)
+//           (int**) cells (Receives the Cells, cells[r][c] being Cell (top + r, left + c) of the plane with 1 for alive and 0 for dead)
+void lifeCopyPlane(Life *life, int top, int left, int HEIGHT, int WIDTH, int **cells);
+
+// Size of the board
+//    Param: (Life*) life (The Life)
+//    Return: (int) HEIGHT or WIDTH of the board
+int lifeHeight(Life *life);
+int lifeWidth(Life *life);
+
+// Generation of the board, 0 for the starting board
+//    Param: (Life*) life (The Life)
+//    Return: (long) The generation
+long lifeGeneration(Life *life);
+
+// Statistics of the latest generation calculated
+//    Param: (Life*) life (The Life)
+//    Return: (GenerationStats*) The statistics, owned by the Life
+GenerationStats *lifeStats(Life *life);
+
+// Statistics of every generation calculated, kept when the options ask for a series
+//    Param: (Life*) life (The Life)
+//    Return: (StatsSeries*) The series owned by the Life, NULL if none is kept
+StatsSeries *lifeSeries(Life *life);
+
+// Hardware counters of the calculation, opened when the options ask for them (see perfcount.h)
+// Every run of generations the engine calculates in one go is a sample, the report prints the totals
+//    Param: (Life*) life (The Life)
+//    Return: (PerfCounters*) The counters owned by the Life, NULL if none are kept
+PerfCounters *lifeCounters(Life *life);
+
+// Engine calculating the board
+//    Param: (Life*) life (The Life)
+//    Return: (LifeEngine) The engine
+LifeEngine lifeEngine(Life *life);
+
+// Name of an engine, for the user
+//    Param: (LifeEngine) engine (The engine)
+//    Return: (string) The name
+const char *lifeEngineName(LifeEngine engine);
+
+// Print what the engine has to report (the load balance and NUMA placement of the tile scheduler, the work of the change list, the rule and time split of Larger than Life, the extent and memory of the growing board, the hardware counters), if anything
+//    Param: (Life*) life (The Life)
+//           (FILE*) stream (Where to print)
+void lifeReport(Life *life, FILE *stream);
+
+// Stop the engine and free the Life, the board included
+//    Param: (Life*) life (The Life)
+void lifeFree(Life *life);
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef LIFENUMA_H
+#define LIFENUMA_H
+
+/* -------------------------------------------------------------------------- */
+/*          NUMA topology, thread pinning and placement of the board          */
+/* -------------------------------------------------------------------------- */
+
+// The topology is read from /sys once: the NUMA nodes and the CPUs of each of them
+// that the process may run on. A machine without that information is one node. Workers
+// are given to the nodes in contiguous blocks, worker k of n on node k * nodes / n, so
+// neighbouring workers (and the neighbouring tiles or rows they calculate) share a node.
+
+// Enum for pinning workers: not at all, each to one core, or each to every core of its node.
+enum NumaPinning
+{
+    NUMA_PIN_NONE = 1,
+    NUMA_PIN_CORES = 2,
+    NUMA_PIN_NODES = 3
+};
+typedef enum NumaPinning NumaPinning;
+
+// Number of NUMA nodes with CPUs the process may run on
+//    Return: (int) Number of nodes, at least 1
+int numaNodes();
+
+// Pin the calling thread (or process) as one of a number of workers
+//    Param: (int) index (Index of the worker)
+//           (int) count (Number of workers)
+//           (NumaPinning) pinning (How to pin)
+//    Return: (int) The CPU pinned to with NUMA_PIN_CORES, the node with NUMA_PIN_NODES, -1 if not pinned
+int numaPin(int index, int count, NumaPinning pinning);
+
+// Node of the CPU the calling thread is running on
+//    Return: (int) The node, -1 if unknown
+int numaCurrentNode();
+
+// Node holding the page of an address
+//    Param: (void*) address (The address)
+//    Return: (int) The node, -1 if the page was never touched or the system can not tell
+int numaNodeOfAddress(void *address);
+
+// Name of a pinning, for reports
+//    Param: (NumaPinning) pinning (The pinning)
+//    Return: (string) The name
+const char *numaPinningName(NumaPinning pinning);
+
+#endif
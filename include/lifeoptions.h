@@ -0,0 +1,38 @@
+#ifndef LIFEOPTIONS_H
+#define LIFEOPTIONS_H
+
+#include <life.h>
+#include <arena.h>
+#include <domain.h>
+#include <lifenuma.h>
+#include <ltl.h>
+
+/* -------------------------------------------------------------------------- */
+/*     Options of a Life, private to liblife: programs use the setters of life.h */
+/* -------------------------------------------------------------------------- */
+
+// The engines, the tuner and the daemon read the fields, copy the options by value and
+// keep arrays of them; the layout may change with any version of the library.
+struct LifeOptions
+{
+    LifeEngine engine;
+    int processes;
+    DomainTransport transport;
+    int threads;
+    int tileSize;
+    int depth;
+    ArenaPages pages;
+    int interval;
+    int historyMegabytes;
+    int keepSeries;
+    NumaPinning pinning;
+    int counters;
+    LtlRule rule;
+    int growLimit;
+};
+
+// Fill options with the defaults of lifeOptionsCreate
+//    Param: (LifeOptions*) options (The options)
+void lifeDefaultOptions(LifeOptions *options);
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef LTL_H
+#define LTL_H
+
+#include <stdio.h>
+#include <stats.h>
+
+/* -------------------------------------------------------------------------- */
+/*     Larger than Life: radius-R rules counted from a summed-area table      */
+/* -------------------------------------------------------------------------- */
+
+// A Larger than Life rule counts the live Cells in the (2R+1)x(2R+1) square around a
+// Cell instead of its 8 neighbours: a dead Cell is born when the count is in the birth
+// range, a live one survives when it is in the survival range. Counting every square
+// costs R^2 per Cell, so every generation first builds the summed-area table of the
+// board, where entry (i, j) holds the live Cells above and left of it; the count of any
+// square is then 4 entries of the table, whatever the radius. Cells outside the board
+// are dead, as with the other engines. Rules are written as in Golly, for instance
+// Bosco's rule: R5,C0,M1,S34..58,B34..45,NM.
+
+// Largest radius accepted
+#define LTL_MAX_RADIUS 500
+
+// Conway's Game of Life, written as a Larger than Life rule
+#define LTL_CONWAY "R1,C0,M0,S2..3,B3..3,NM"
+
+// A Larger than Life rule: the radius, whether the Cell counts itself, and the inclusive ranges of counts.
+struct LtlRule
+{
+    int radius;
+    int middle;
+    int survivalMin;
+    int survivalMax;
+    int birthMin;
+    int birthMax;
+};
+typedef struct LtlRule LtlRule;
+
+typedef struct LtlStepper LtlStepper;
+
+// Read a rule written as in Golly (R, C, M, S, B and N, only two states and the square neighbourhood NM),
+// or the name of a known one (conway, bosco, majority)
+//    Param: (string) text (The rule)
+//           (LtlRule*) rule (Receives the rule)
+//    Return: (int) 0 on success, -1 if the rule is not valid or not supported
+int ltlParseRule(const char *text, LtlRule *rule);
+
+// Write a rule as in Golly
+//    Param: (LtlRule*) rule (The rule)
+//           (string) text (Receives the rule)
+//           (size_t) size (Size of the text)
+void ltlFormatRule(LtlRule *rule, char *text, size_t size);
+
+// Create a stepper for a board and a rule
+//    Param: (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//           (LtlRule*) rule (The rule, copied)
+//           (int) threads (Threads building the table and applying the rule, each taking a share of the rows)
+//    Return: (LtlStepper*) The stepper, NULL if it could not be created
+LtlStepper *ltlStepperCreate(int HEIGHT, int WIDTH, LtlRule *rule, int threads);
+
+// Calculate a number of generations of the rule, writing the board in place
+//    Param: (LtlStepper*) stepper (The stepper)
+//           (int) generations (Number of generations to calculate)
+//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
+//           (StatsRecorder*) recorder (Receives the statistics of every generation, or NULL)
+void ltlStepperStep(LtlStepper *stepper, int generations, int **currentBoard, StatsRecorder *recorder);
+
+// Print the rule and the time a generation took, split between building the table and applying the rule
+//    Param: (LtlStepper*) stepper (The stepper)
+//           (FILE*) stream (Where to print)
+void ltlStepperReport(LtlStepper *stepper, FILE *stream);
+
+// Free the stepper
+//    Param: (LtlStepper*) stepper (The stepper)
+void ltlStepperFree(LtlStepper *stepper);
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef PATSEARCH_H
+#define PATSEARCH_H
+
+#include <stdio.h>
+
+/* -------------------------------------------------------------------------- */
+/*        Search of a board for every occurrence of a set of patterns         */
+/* -------------------------------------------------------------------------- */
+
+// Every pattern is compiled once into variants: each phase it goes through (as it evolves on
+// its own, until it repeats) in each of the 8 orientations, without duplicates. A variant is
+// a window of bit masks, one 64-bit word per row: the Cells that must be alive, and the Cells
+// that must be dead, namely the rest of the pattern's box and a margin around it, so that a
+// glider is only found when nothing touches it. The board is packed into bits, one word per
+// 64 Cells, and every variant is tested at 64 columns at once: each Cell of the window is one
+// shift and one AND over the packed row. Bands of rows are searched on several threads.
+// Cells outside the board are dead, so patterns are found up to the edges.
+
+// Margin of dead Cells required around a pattern when none is given
+#define SEARCH_DEFAULT_MARGIN 1
+
+// Most phases compiled for a pattern that does not repeat sooner
+#define SEARCH_MAX_PHASES 64
+
+// Widest and highest pattern, margins included, one word per row of the window
+#define SEARCH_MAX_SIZE 64
+
+// An occurrence of a pattern: the upper left corner of its box (margins excluded) on the board,
+// and the orientation and phase of the variant found.
+struct SearchMatch
+{
+    int pattern;
+    int row;
+    int column;
+    int orientation;
+    int phase;
+};
+typedef struct SearchMatch SearchMatch;
+
+typedef struct PatternSearch PatternSearch;
+
+// Create a search without patterns
+//    Param: (int) margin (Dead Cells required around the patterns, 0 for none)
+//           (int) threads (Threads searching bands of rows, 0 for one per core)
+//    Return: (PatternSearch*) The search, NULL if it could not be allocated
+PatternSearch *searchCreate(int margin, int threads);
+
+// Compile a pattern into its variants
+//    Param: (PatternSearch*) search (The search)
+//           (string) name (Name of the pattern, copied)
+//           (int**) cells (Pointer to A 2D Dynamic Interger Array holding the pattern, 1 for alive)
+//           (int) HEIGHT (HEIGHT of the pattern)
+//           (int) WIDTH (WIDTH of the pattern)
+//           (int) phases (Phases to compile, 0 for all of them until the pattern repeats, at most SEARCH_MAX_PHASES)
+//    Return: (int) Index of the pattern, -1 if it has no live Cell, grows beyond SEARCH_MAX_SIZE or memory ran out
+int searchAddPattern(PatternSearch *search, const char *name, int **cells, int HEIGHT, int WIDTH, int phases);
+
+// Compile a pattern known by name (glider, lwss, blinker, block, beehive, eater) or read from a board file
+//    Param: (PatternSearch*) search (The search)
+//           (string) name (Name of the pattern or of the board file, the board being cropped to its live Cells)
+//    Return: (int) Index of the pattern, -1 if it is unknown, can not be read or compiled
+int searchAddNamed(PatternSearch *search, const char *name);
+
+// Search a board for every pattern
+//    Param: (PatternSearch*) search (The search)
+//           (int**) board (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
+//           (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//           (SearchMatch**) matches (Receives the matches in board order, owned by the search until the next search)
+//    Return: (int) Number of matches, -1 if memory ran out
+int searchRun(PatternSearch *search, int **board, int HEIGHT, int WIDTH, SearchMatch **matches);
+
+// Number of patterns and of variants compiled from them
+//    Param: (PatternSearch*) search (The search)
+//    Return: (int) The number
+int searchPatterns(PatternSearch *search);
+int searchVariants(PatternSearch *search);
+
+// Name of a pattern
+//    Param: (PatternSearch*) search (The search)
+//           (int) pattern (Index of the pattern)
+//    Return: (string) The name
+const char *searchPatternName(PatternSearch *search, int pattern);
+
+// Name of an orientation: the pattern mirrored left to right or not, then turned clockwise
+//    Param: (int) orientation (The orientation, 0 to 7)
+//    Return: (string) The name
+const char *searchOrientationName(int orientation);
+
+// Write matches as CSV rows: generation, pattern, row, column, orientation and phase
+//    Param: (PatternSearch*) search (The search)
+//           (FILE*) stream (Where to write)
+//           (long) generation (Generation of the board searched)
+//           (SearchMatch*) matches (The matches)
+//           (int) count (Number of matches)
+void searchWriteMatches(PatternSearch *search, FILE *stream, long generation, SearchMatch *matches, int count);
+
+// Free the search
+//    Param: (PatternSearch*) search (The search)
+void searchFree(PatternSearch *search);
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef PERFCOUNT_H
+#define PERFCOUNT_H
+
+#include <stdio.h>
+
+/* -------------------------------------------------------------------------- */
+/*     Hardware performance counters around the calculation of generations     */
+/* -------------------------------------------------------------------------- */
+
+// The counters are opened with perf_event_open by the thread that calculates the board,
+// before it starts any worker: threads and processes started afterwards inherit them, and
+// reading a counter adds up the counts of all of them. Events the kernel refuses (no PMU
+// in a virtual machine or container, perf_event_paranoid, seccomp) are left out, and the
+// ratios that need them are reported as unavailable instead of failing the run.
+
+// Enum for the hardware events counted.
+enum PerfEvent
+{
+    PERF_CYCLES = 0,
+    PERF_INSTRUCTIONS = 1,
+    PERF_CACHE_MISSES = 2,
+    PERF_BRANCHES = 3,
+    PERF_BRANCH_MISSES = 4,
+    PERF_EVENTS = 5
+};
+typedef enum PerfEvent PerfEvent;
+
+// Counts of a run of generations calculated in one go, -1 for an event that is not counted.
+struct PerfSample
+{
+    long first;
+    long generations;
+    double cells;
+    double counts[PERF_EVENTS];
+};
+typedef struct PerfSample PerfSample;
+
+typedef struct PerfCounters PerfCounters;
+
+// Open a counter for every event on the calling thread and the threads and processes it starts from now on
+//    Return: (PerfCounters*) The counters, possibly counting nothing, NULL if out of memory
+PerfCounters *perfCountersOpen();
+
+// Number of events the kernel agreed to count
+//    Param: (PerfCounters*) counters (The counters)
+//    Return: (int) Number of events counted, 0 when counters are unavailable
+int perfCountersAvailable(PerfCounters *counters);
+
+// Start counting a run of generations
+//    Param: (PerfCounters*) counters (The counters)
+void perfCountersStart(PerfCounters *counters);
+
+// Stop counting a run of generations, keep its sample and add it to the totals
+//    Param: (PerfCounters*) counters (The counters)
+//           (long) first (First generation calculated)
+//           (long) generations (Number of generations calculated)
+//           (double) cells (Cells calculated per generation)
+void perfCountersStop(PerfCounters *counters, long first, long generations, double cells);
+
+// Counts of every generation calculated so far
+//    Param: (PerfCounters*) counters (The counters)
+//    Return: (PerfSample*) The totals, owned by the counters
+PerfSample *perfCountersTotal(PerfCounters *counters);
+
+// Instructions per cycle, last level cache misses per Cell and branch miss rate of a sample
+//    Param: (PerfSample*) sample (The sample)
+//    Return: (double) The ratio, -1 if an event it needs is not counted
+double perfSampleIpc(PerfSample *sample);
+double perfSampleMissesPerCell(PerfSample *sample);
+double perfSampleBranchMissRate(PerfSample *sample);
+
+// Print the totals and their ratios, or why there are none
+//    Param: (PerfCounters*) counters (The counters)
+//           (FILE*) stream (Where to print)
+void perfCountersReport(PerfCounters *counters, FILE *stream);
+
+// Write every sample as CSV, one run of generations per line, with the counts per generation
+//    Param: (PerfCounters*) counters (The counters)
+//           (string) fileName (Name of the CSV file)
+//    Return: (int) 0 on success, -1 if the file could not be written
+int perfCountersWrite(PerfCounters *counters, char *fileName);
+
+// Close the counters
+//    Param: (PerfCounters*) counters (The counters)
+void perfCountersClose(PerfCounters *counters);
+
+#endif
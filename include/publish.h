@@ -0,0 +1,61 @@
+#ifndef PUBLISH_H
+#define PUBLISH_H
+
+#include <stats.h>
+
+/* -------------------------------------------------------------------------- */
+/*      Frames of a running game published in POSIX shared memory (seqlock)   */
+/* -------------------------------------------------------------------------- */
+
+// The game writes finished generations into a small ring of frames in a named shared
+// memory object. Every frame is guarded by a sequence counter that is odd while the
+// frame is written (a seqlock): the writer never waits, and a viewer copies the newest
+// frame and keeps it only if the counter did not move while it was copying.
+
+// Frames in the ring, a viewer slower than the game reads the newest one and skips the rest
+#define PUBLISH_SLOTS 4
+
+typedef struct Publisher Publisher;
+typedef struct Viewer Viewer;
+
+// Create the shared memory object and start publishing into it (Writer side)
+//    Param: (string) name (Name of the shared memory object, a leading '/' is added if missing)
+//           (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//    Return: (Publisher*) The publisher, NULL if the object could not be created, errno being EEXIST if the name is taken
+//                        (by another game publishing, or one that crashed and left the object behind)
+Publisher *publisherCreate(char *name, int HEIGHT, int WIDTH);
+
+// Publish a board as the newest frame, without ever waiting for a viewer
+//    Param: (Publisher*) publisher (The publisher)
+//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
+//           (GenerationStats*) stats (Statistics of the board, holding its generation)
+void publisherPublish(Publisher *publisher, int **currentBoard, GenerationStats *stats);
+
+// Stop publishing and remove the shared memory object, viewers attached keep their last frame
+//    Param: (Publisher*) publisher (The publisher)
+void publisherFree(Publisher *publisher);
+
+// Attach to the frames of a running game (Viewer side)
+//    Param: (string) name (Name of the shared memory object, a leading '/' is added if missing)
+//    Return: (Viewer*) The viewer, NULL if no game publishes under that name or the object is not a ring of frames that fits in it
+Viewer *viewerOpen(char *name);
+
+// Size of the published board
+//    Param: (Viewer*) viewer (The viewer)
+//    Return: (int) HEIGHT or WIDTH of the board
+int viewerHeight(Viewer *viewer);
+int viewerWidth(Viewer *viewer);
+
+// Copy the newest consistent frame, if it was published since the last one copied
+//    Param: (Viewer*) viewer (The viewer)
+//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array of the published size that receives the board)
+//           (GenerationStats*) stats (Receives the statistics of the board)
+//    Return: (int) 1 if a frame was copied, 0 if nothing new was published or the writer kept overwriting it
+int viewerRead(Viewer *viewer, int **currentBoard, GenerationStats *stats);
+
+// Detach from the frames
+//    Param: (Viewer*) viewer (The viewer)
+void viewerClose(Viewer *viewer);
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <stats.h>
+
+/* -------------------------------------------------------------------------- */
+/*      Rendering of Life's board, shared by the game and the viewer          */
+/* -------------------------------------------------------------------------- */
+
+// Color a Cell is drawn in
+//    Param: (int) color (The color of the cell)
+//    Return: (int) The econio color
+int cellColor(int color);
+
+// Print a Cell for Life's board
+//    Param: (int) color (The color of the cell)
+void printCell(int color);
+
+// Put a Cell for Life's board into the frame being composed
+//    Param: (int) x (Column of the Cell on screen, the left border being column 0)
+//           (int) y (Row of the Cell on screen, the top border being row 0)
+//           (int) color (The color of the cell)
+void frameCell(int x, int y, int color);
+
+// Put a row line (A row full of white Cell, acting as a border) into the frame being composed
+//    Param: (int) y (Row of the line on screen)
+//           (int) WIDTH (The width of the board)
+void frameRowLine(int y, int WIDTH);
+
+// Print the statistics of a generation on one line, into the frame being composed
+//    Param: (GenerationStats*) stats (Statistics of the generation)
+void printStats(GenerationStats *stats);
+
+// Begin a frame with the board in its border and the statistics below it
+// The frame is left open for the caller to add its own lines and commit it
+//    Param: (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//           (int**) board (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
+//           (GenerationStats*) stats (Statistics of the board shown, or NULL)
+void frameBoard(int HEIGHT, int WIDTH, int **board, GenerationStats *stats);
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef STATS_H
+#define STATS_H
+
+/* -------------------------------------------------------------------------- */
+/*     Statistics of a generation, gathered by the kernels while stepping     */
+/* -------------------------------------------------------------------------- */
+
+// Statistics of one generation. The bounding box is inclusive, and top is -1 when no Cell is alive.
+struct GenerationStats
+{
+    long generation;
+    long population;
+    long births;
+    long deaths;
+    int top;
+    int left;
+    int bottom;
+    int right;
+};
+typedef struct GenerationStats GenerationStats;
+
+// Statistics of many generations, kept in order of calculation.
+struct StatsSeries
+{
+    GenerationStats *entries;
+    int count;
+    int capacity;
+};
+typedef struct StatsSeries StatsSeries;
+
+// Where the engines report the statistics of every generation they calculate.
+struct StatsRecorder
+{
+    long generation;
+    GenerationStats last;
+    StatsSeries *series;
+};
+typedef struct StatsRecorder StatsRecorder;
+
+// Empty the statistics of a generation (No Cell alive, no births, no deaths)
+//    Param: (GenerationStats*) stats (The statistics)
+//           (long) generation (Number of the generation)
+void statsReset(GenerationStats *stats, long generation);
+
+// Add the statistics of a part of the board to the statistics of the whole board
+//    Param: (GenerationStats*) stats (Statistics of the whole board)
+//           (GenerationStats*) part (Statistics of a part of the board)
+void statsMerge(GenerationStats *stats, GenerationStats *part);
+
+// Grow the bounding box to contain a run of live Cells on a row
+//    Param: (GenerationStats*) stats (The statistics)
+//           (int) row (Row of the run)
+//           (int) first (Column of the first live Cell of the run)
+//           (int) last (Column of the last live Cell of the run)
+void statsIncludeRun(GenerationStats *stats, int row, int first, int last);
+
+// Account a row of byte Cells (0 or 1) before and after a generation, eight Cells per 64-bit word
+//    Param: (GenerationStats*) stats (The statistics)
+//           (unsigned char*) before (Cells of the row before the generation)
+//           (unsigned char*) after (Cells of the row after the generation)
+//           (int) count (Number of Cells)
+//           (int) row (Row on the board)
+//           (int) column (Column on the board of the first Cell)
+void statsAccountBytes(GenerationStats *stats, unsigned char *before, unsigned char *after, int count, int row, int column);
+
+// Number the statistics of a newly calculated generation, keep them as the latest and append them to the series if there is one
+//    Param: (StatsRecorder*) recorder (The recorder)
+//           (GenerationStats*) stats (Statistics of the generation)
+void statsRecord(StatsRecorder *recorder, GenerationStats *stats);
+
+// Create an empty series
+//    Return: (StatsSeries*) The series, NULL if it could not be allocated
+StatsSeries *statsSeriesCreate();
+
+// Append the statistics of a generation to a series
+//    Param: (StatsSeries*) series (The series)
+//           (GenerationStats*) stats (Statistics of the generation)
+void statsSeriesAppend(StatsSeries *series, GenerationStats *stats);
+
+// Drop the statistics of every generation after a given one, when the board is taken back to it
+//    Param: (StatsSeries*) series (The series)
+//           (long) generation (Last generation to keep)
+void statsSeriesTruncate(StatsSeries *series, long generation);
+
+// Write a series as CSV, one generation per line
+//    Param: (StatsSeries*) series (The series)
+//           (string) fileName (Name of the CSV file)
+//    Return: (int) 0 on success, -1 if the file could not be written
+int statsSeriesWrite(StatsSeries *series, char *fileName);
+
+// Free a series
+//    Param: (StatsSeries*) series (The series)
+void statsSeriesFree(StatsSeries *series);
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef TEMPORAL_H
+#define TEMPORAL_H
+
+#include <stats.h>
+
+/* -------------------------------------------------------------------------- */
+/*       Temporal blocking: several generations per cache-resident tile       */
+/* -------------------------------------------------------------------------- */
+
+// Every tile is loaded with a halo of depth k into a small byte buffer, advanced
+// k generations while it stays in the cache, and written back once. The halo cells
+// are calculated redundantly by the neighbour tiles, in exchange the board itself is
+// read and written once every k generations instead of every generation.
+
+typedef struct TemporalStepper TemporalStepper;
+
+// Size of the per-core cache the tiles should fit in (L2, or L1 if L2 is unknown)
+//    Return: (long) Size in bytes, a safe guess if the system does not tell
+long temporalCacheSize();
+
+// Create a temporally blocked stepper
+//    Param: (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//           (int) depth (Generations per tile pass, 0 to choose from the cache size)
+//    Return: (TemporalStepper*) The stepper, NULL if it could not be created
+TemporalStepper *temporalStepperCreate(int HEIGHT, int WIDTH, int depth);
+
+// Calculate a number of generations, same result as calling calculateNextBoard as many times
+//    Param: (TemporalStepper*) stepper (The stepper)
+//           (int) generations (Number of generations to calculate)
+//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
+//           (int**) nextBoard (Pointer to A 2D Dynamic Interger Array used as scratch board)
+//           (StatsRecorder*) recorder (Receives the statistics of every generation, or NULL)
+void temporalStepperStep(TemporalStepper *stepper, int generations, int **currentBoard, int **nextBoard, StatsRecorder *recorder);
+
+// Generations advanced per tile pass
+//    Param: (TemporalStepper*) stepper (The stepper)
+//    Return: (int) Depth of the halo
+int temporalStepperDepth(TemporalStepper *stepper);
+
+// Side of the tiles written back per pass
+//    Param: (TemporalStepper*) stepper (The stepper)
+//    Return: (int) Side of a tile in Cells
+int temporalStepperTileSize(TemporalStepper *stepper);
+
+// Free the stepper
+//    Param: (TemporalStepper*) stepper (The stepper)
+void temporalStepperFree(TemporalStepper *stepper);
+
+#endif
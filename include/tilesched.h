@@ -0,0 +1,78 @@
+#ifndef TILESCHED_H
+#define TILESCHED_H
+
+#include <stdio.h>
+#include <stats.h>
+#include <lifenuma.h>
+
+/* -------------------------------------------------------------------------- */
+/*        Tile based multi-threaded stepping with work-stealing deques        */
+/* -------------------------------------------------------------------------- */
+
+// The board is cut into square tiles. Every generation, only the tiles that could
+// change (the tile or one of its 8 neighbour tiles changed last generation) become
+// tasks. Tasks are dealt to the threads in contiguous blocks, and a thread that runs
+// out of tasks steals pending ones from the others. On NUMA machines the threads can be
+// pinned, and can first touch the tiles they calculate so that their memory is local.
+
+// Load balance counters of one thread, accumulated since the scheduler was created.
+struct TileThreadStats
+{
+    long tiles;
+    long steals;
+    double busySeconds;
+};
+typedef struct TileThreadStats TileThreadStats;
+
+typedef struct TileScheduler TileScheduler;
+
+// Create a scheduler and start its threads
+//    Param: (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//           (int) threads (Number of threads, including the calling thread)
+//           (int) tileSize (Side of a tile in Cells, 0 for the default)
+//           (NumaPinning) pinning (How to pin the threads, the calling thread is pinned when it first steps)
+//    Return: (TileScheduler*) The scheduler, NULL if it could not be created
+TileScheduler *tileSchedulerCreate(int HEIGHT, int WIDTH, int threads, int tileSize, NumaPinning pinning);
+
+// Have every thread touch the tiles it will calculate first, before anything else writes the boards
+// The pages of a fresh board are then placed on the NUMA node of the thread calculating them
+//    Param: (TileScheduler*) scheduler (The scheduler)
+//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
+//           (int**) nextBoard (Pointer to A 2D Dynamic Interger Array used as scratch board)
+void tileSchedulerFirstTouch(TileScheduler *scheduler, int **currentBoard, int **nextBoard);
+
+// Calculate a number of generations, same result as calling calculateNextBoard as many times
+// The board must not be changed outside of the scheduler between two calls, unless tileSchedulerReset is called
+//    Param: (TileScheduler*) scheduler (The scheduler)
+//           (int) generations (Number of generations to calculate)
+//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
+//           (int**) nextBoard (Pointer to A 2D Dynamic Interger Array used as scratch board)
+//           (StatsRecorder*) recorder (Receives the statistics of every generation, or NULL)
+void tileSchedulerStep(TileScheduler *scheduler, int generations, int **currentBoard, int **nextBoard, StatsRecorder *recorder);
+
+// Forget which tiles are stable, after the board was changed outside of the scheduler
+//    Param: (TileScheduler*) scheduler (The scheduler)
+void tileSchedulerReset(TileScheduler *scheduler);
+
+// Get the load balance counters of one thread
+//    Param: (TileScheduler*) scheduler (The scheduler)
+//           (int) thread (Index of the thread)
+//    Return: (TileThreadStats) Counters of the thread
+TileThreadStats tileSchedulerThreadStats(TileScheduler *scheduler, int thread);
+
+// Print utilisation, tiles and steals of every thread
+//    Param: (TileScheduler*) scheduler (The scheduler)
+//           (FILE*) out (Where to print the report)
+void tileSchedulerReport(TileScheduler *scheduler, FILE *out);
+
+// Print the NUMA placement: where every thread is pinned and runs, and how much of its tiles' memory is local
+//    Param: (TileScheduler*) scheduler (The scheduler)
+//           (FILE*) out (Where to print the report)
+void tileSchedulerPlacement(TileScheduler *scheduler, FILE *out);
+
+// Stop the threads and free the scheduler
+//    Param: (TileScheduler*) scheduler (The scheduler)
+void tileSchedulerFree(TileScheduler *scheduler);
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef TUNE_H
+#define TUNE_H
+
+#include <stdio.h>
+#include <life.h>
+
+/* -------------------------------------------------------------------------- */
+/*        Choice of the fastest engine for a board size, on this machine       */
+/* -------------------------------------------------------------------------- */
+
+// The candidates are every engine, the tile scheduler with several thread counts and tile
+// sizes, the temporal stepper with several depths and the worker processes with several
+// counts. Each one calculates the same random board of the requested size, settled for a
+// few generations first, for a fixed time; the fastest per generation wins. The winner is
+// kept in a profile file, one line per CPU model, core count and board size, so that later
+// runs on the same machine and size read it back instead of measuring again.
+
+// Generations calculated on the random board before it is measured, so that it looks like a running game
+#define TUNE_SETTLE_GENERATIONS 32
+
+// Seconds every candidate calculates for, at least
+#define TUNE_SECONDS 0.2
+
+// Tile sides tried with the tile scheduler
+#define TUNE_TILE_SIZES {32, 64, 128}
+
+// Describe the engine options chosen by a tuning, for the user
+//    Param: (LifeOptions*) options (The options)
+//           (string) description (Receives the description)
+//           (size_t) size (Size of the description)
+void tuneDescribe(LifeOptions *options, char *description, size_t size);
+
+// Read the options tuned for a board size on this machine from a profile
+//    Param: (string) profileName (Name of the profile file)
+//           (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//           (LifeOptions*) options (Receives the engine options tuned, the others are left alone)
+//    Return: (int) 0 if the profile has them, -1 otherwise
+int tuneLookup(char *profileName, int HEIGHT, int WIDTH, LifeOptions *options);
+
+// Measure every candidate on a board of the size and keep the fastest in the options
+//    Param: (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//           (LifeOptions*) options (Options the candidates start from, receives the engine options of the fastest)
+//           (FILE*) progress (Where to print every candidate and its time, or NULL)
+//    Return: (double) Seconds per generation of the fastest, -1 if no candidate could run
+double tuneMeasure(int HEIGHT, int WIDTH, LifeOptions *options, FILE *progress);
+
+// Add the options tuned for a board size on this machine to a profile, replacing any tuned before
+//    Param: (string) profileName (Name of the profile file)
+//           (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//           (LifeOptions*) options (The engine options tuned)
+//           (double) seconds (Seconds per generation they took)
+//    Return: (int) 0 on success, -1 if the profile could not be written
+int tuneStore(char *profileName, int HEIGHT, int WIDTH, LifeOptions *options, double seconds);
+
+// Tune the options for a board size: read them from the profile, or measure them and store them there
+//    Param: (string) profileName (Name of the profile file)
+//           (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//           (LifeOptions*) options (Options the candidates start from, receives the engine options tuned)
+//           (FILE*) progress (Where to print the measurements, or NULL)
+//    Return: (int) 1 if read from the profile, 0 if measured now, -1 if no candidate could run
+int tuneOptions(char *profileName, int HEIGHT, int WIDTH, LifeOptions *options, FILE *progress);
+
+#endif
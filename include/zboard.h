@@ -0,0 +1,60 @@
+#ifndef ZBOARD_H
+#define ZBOARD_H
+
+#include <stats.h>
+
+/* -------------------------------------------------------------------------- */
+/*            Board stored in square tiles placed in Z-order (Morton)         */
+/* -------------------------------------------------------------------------- */
+
+// Cells are bytes grouped in square tiles of ZBOARD_TILE x ZBOARD_TILE, every tile
+// being contiguous in memory. Tiles are placed in Morton order, so tiles that are
+// neighbours on the board are mostly neighbours in memory as well, in both directions.
+// Renderers and file I/O go through the accessors, never through the raw memory.
+
+// Side of a tile in Cells, a tile of bytes fills exactly one 4 KB page
+#define ZBOARD_TILE 64
+
+typedef struct ZBoard ZBoard;
+
+// Allocate an empty (all dead) tiled board
+//    Param: (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//    Return: (ZBoard*) The board, NULL if it could not be allocated
+ZBoard *zboardCreate(int HEIGHT, int WIDTH);
+
+// Free a tiled board
+//    Param: (ZBoard*) board (The board)
+void zboardFree(ZBoard *board);
+
+// Read a Cell
+//    Param: (ZBoard*) board (The board)
+//           (int) r (Row of the Cell)
+//           (int) c (Column of the Cell)
+//    Return: (int) 1 if the Cell is alive, 0 otherwise
+int zboardGet(ZBoard *board, int r, int c);
+
+// Write a Cell
+//    Param: (ZBoard*) board (The board)
+//           (int) r (Row of the Cell)
+//           (int) c (Column of the Cell)
+//           (int) value (1 for alive, anything else for dead)
+void zboardSet(ZBoard *board, int r, int c, int value);
+
+// Copy a row-major board into the tiled board
+//    Param: (ZBoard*) board (The tiled board)
+//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
+void zboardLoad(ZBoard *board, int **currentBoard);
+
+// Copy the tiled board into a row-major board (For rendering and saving)
+//    Param: (ZBoard*) board (The tiled board)
+//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that receives the Game Board)
+void zboardStore(ZBoard *board, int **currentBoard);
+
+// Calculate a number of generations tile by tile, same result as calling calculateNextBoard as many times
+//    Param: (ZBoard*) board (The tiled board)
+//           (int) generations (Number of generations to calculate)
+//           (StatsRecorder*) recorder (Receives the statistics of every generation, or NULL)
+void zboardStep(ZBoard *board, int generations, StatsRecorder *recorder);
+
+#endif
@@ -0,0 +1,195 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <arena.h>
+
+/* -------------------------------------------------------------------------- */
+/*        Aligned arena for boards and scratch buffers (huge page aware)       */
+/* -------------------------------------------------------------------------- */
+
+// Size of a huge page on the systems we run on
+#define ARENA_HUGE_PAGE (2UL * 1024 * 1024)
+
+struct Arena
+{
+    // The mapping as returned by mmap, and the aligned part handed out
+    void *mapping;
+    size_t mappingSize;
+    unsigned char *base;
+    size_t capacity;
+    size_t used;
+    ArenaPages pages;
+};
+
+/* ---------------------------- Utilities of an Arena ------------------------ */
+// Round a size up to a multiple of an alignment
+//    Param: (size_t) size (The size)
+//           (size_t) alignment (The alignment, a power of two)
+//    Return: (size_t) Rounded size
+static size_t arenaRound(size_t size, size_t alignment)
+{
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+// Map memory backed by explicit huge pages from the hugetlbfs pool
+//    Param: (Arena*) arena (The arena to fill)
+//           (size_t) capacity (Bytes needed)
+//    Return: (int) 1 on success, 0 if the pool can not provide them
+static int arenaMapExplicit(Arena *arena, size_t capacity)
+{
+#ifdef MAP_HUGETLB
+    size_t size = arenaRound(capacity, ARENA_HUGE_PAGE);
+    void *mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (mapping == MAP_FAILED)
+    {
+        return 0;
+    }
+
+    arena->mapping = mapping;
+    arena->mappingSize = size;
+    arena->base = (unsigned char *)mapping;
+    arena->capacity = size;
+    arena->pages = ARENA_EXPLICIT_HUGE_PAGES;
+    return 1;
+#else
+    (void)arena;
+    (void)capacity;
+    return 0;
+#endif
+}
+
+// Map normal memory, aligned to a huge page and advised to use transparent huge pages if asked
+//    Param: (Arena*) arena (The arena to fill)
+//           (size_t) capacity (Bytes needed)
+//           (int) huge (1 to ask for transparent huge pages)
+//    Return: (int) 1 on success, 0 if no memory could be mapped
+static int arenaMapNormal(Arena *arena, size_t capacity, int huge)
+{
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t alignment = huge ? ARENA_HUGE_PAGE : page;
+    size_t size = arenaRound(capacity, alignment);
+
+    // Map one extra alignment unit, so the start can be moved to a huge page boundary
+    size_t mappingSize = size + (huge ? ARENA_HUGE_PAGE : 0);
+    void *mapping = mmap(NULL, mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED)
+    {
+        return 0;
+    }
+
+    arena->mapping = mapping;
+    arena->mappingSize = mappingSize;
+    arena->base = (unsigned char *)arenaRound((uintptr_t)mapping, alignment);
+    arena->capacity = size;
+    arena->pages = ARENA_NORMAL_PAGES;
+
+#ifdef MADV_HUGEPAGE
+    if (huge && madvise(arena->base, size, MADV_HUGEPAGE) == 0)
+    {
+        arena->pages = ARENA_TRANSPARENT_HUGE_PAGES;
+    }
+#endif
+    return 1;
+}
+
+/* --------------------------------- Arena API ------------------------------- */
+Arena *arenaCreate(size_t capacity, ArenaPages pages)
+{
+    Arena *arena = (Arena *)calloc(1, sizeof(Arena));
+    if (arena == NULL)
+    {
+        return NULL;
+    }
+
+    capacity = capacity > 0 ? capacity : 1;
+
+    int mapped = pages == ARENA_EXPLICIT_HUGE_PAGES && arenaMapExplicit(arena, capacity);
+    if (!mapped)
+    {
+        mapped = arenaMapNormal(arena, capacity, pages != ARENA_NORMAL_PAGES);
+    }
+    if (!mapped)
+    {
+        free(arena);
+        return NULL;
+    }
+
+    return arena;
+}
+
+void *arenaAllocate(Arena *arena, size_t size, size_t alignment)
+{
+    size_t start = arenaRound(arena->used, alignment);
+    if (start + size > arena->capacity)
+    {
+        return NULL;
+    }
+
+    arena->used = start + size;
+    return arena->base + start;
+}
+
+// Ints in a board row once padded to whole cache lines
+//    Param: (int) WIDTH (WIDTH of Board)
+//    Return: (size_t) Ints per row
+static size_t arenaRowStride(int WIDTH)
+{
+    return arenaRound((size_t)WIDTH * sizeof(int), ARENA_CACHE_LINE) / sizeof(int);
+}
+
+size_t arenaBoardSize(int HEIGHT, int WIDTH)
+{
+    size_t pointers = arenaRound((size_t)HEIGHT * sizeof(int *), ARENA_CACHE_LINE);
+    size_t rows = (size_t)HEIGHT * arenaRowStride(WIDTH) * sizeof(int);
+
+    // One cache line of slack for aligning the block itself
+    return pointers + rows + ARENA_CACHE_LINE;
+}
+
+int **arenaBoardAllocate(Arena *arena, int HEIGHT, int WIDTH)
+{
+    size_t stride = arenaRowStride(WIDTH);
+    size_t pointers = arenaRound((size_t)HEIGHT * sizeof(int *), ARENA_CACHE_LINE);
+
+    unsigned char *block = (unsigned char *)arenaAllocate(arena, pointers + (size_t)HEIGHT * stride * sizeof(int), ARENA_CACHE_LINE);
+    if (block == NULL)
+    {
+        return NULL;
+    }
+
+    int **board = (int **)block;
+    int *cells = (int *)(block + pointers);
+    for (int i = 0; i < HEIGHT; i++)
+    {
+        board[i] = cells + (size_t)i * stride;
+    }
+    return board;
+}
+
+void arenaReset(Arena *arena)
+{
+    arena->used = 0;
+}
+
+size_t arenaCapacity(Arena *arena)
+{
+    return arena->capacity;
+}
+
+ArenaPages arenaPages(Arena *arena)
+{
+    return arena->pages;
+}
+
+void arenaFree(Arena *arena)
+{
+    if (arena == NULL)
+    {
+        return;
+    }
+
+    munmap(arena->mapping, arena->mappingSize);
+    free(arena);
+}
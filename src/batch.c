@@ -0,0 +1,250 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <arena.h>
+#include <batch.h>
+
+/* -------------------------------------------------------------------------- */
+/*       Batch of independent boards of one size, stepped in lockstep         */
+/* -------------------------------------------------------------------------- */
+
+struct Batch
+{
+    int HEIGHT;
+    int WIDTH;
+
+    // Both boards have a border of dead Cells, so every Cell of the board has all eight neighbours
+    int stride;
+    Arena *arena;
+    uint64_t *currentBoard;
+    uint64_t *olderBoard;
+
+    // Settled lanes as of the last generation, and the generation each lane was loaded at
+    uint64_t stable;
+    long generation;
+    long loadedAt[BATCH_LANES];
+};
+
+/* ------------------------- Utilities of the Kernel ------------------------- */
+// Next state of a Cell on every lane at once, from its Cell word and the words of its neighbours
+// The eight neighbours are added with the bitwise adders of the fixed-size engines: ones, twos and "four or more"
+//    Param: (uint64_t) upLeft, up, upRight (Neighbours in the row above)
+//           (uint64_t) left, cell, right (The Cell and its neighbours in its row)
+//           (uint64_t) downLeft, down, downRight (Neighbours in the row below)
+//    Return: (uint64_t) The Cell after one generation, on every lane
+static inline uint64_t batchNextCell(uint64_t upLeft, uint64_t up, uint64_t upRight,
+                                     uint64_t left, uint64_t cell, uint64_t right,
+                                     uint64_t downLeft, uint64_t down, uint64_t downRight)
+{
+    // Sum of each row of three (two for the middle row), as a ones and a twos bit
+    uint64_t upOnes = upLeft ^ up ^ upRight;
+    uint64_t upTwos = (upLeft & up) | (upRight & (upLeft ^ up));
+    uint64_t midOnes = left ^ right;
+    uint64_t midTwos = left & right;
+    uint64_t downOnes = downLeft ^ down ^ downRight;
+    uint64_t downTwos = (downLeft & down) | (downRight & (downLeft ^ down));
+
+    // Add the three rows: ones, then twos with the carry of the ones
+    uint64_t ones = upOnes ^ midOnes ^ downOnes;
+    uint64_t carry = (upOnes & midOnes) | (downOnes & (upOnes ^ midOnes));
+    uint64_t twosSum = upTwos ^ midTwos ^ downTwos;
+    uint64_t twosCarry = (upTwos & midTwos) | (downTwos & (upTwos ^ midTwos));
+    uint64_t twos = twosSum ^ carry;
+    uint64_t fours = twosCarry | (twosSum & carry);
+
+    // Alive with exactly 3 neighbours, or with 2 if it was alive
+    return twos & ~fours & (ones | cell);
+}
+
+// Word of a Cell in a board of the batch
+//    Param: (Batch*) batch (The batch)
+//           (uint64_t*) board (One of the two boards)
+//           (int) r (Row of the Cell)
+//           (int) c (Column of the Cell)
+//    Return: (uint64_t*) The word holding the Cell on every lane
+static uint64_t *batchCell(Batch *batch, uint64_t *board, int r, int c)
+{
+    return board + (size_t)(r + 1) * batch->stride + c + 1;
+}
+
+// Write a Cell on one lane of both boards, so the lane does not look settled against a stale older board
+//    Param: (Batch*) batch (The batch)
+//           (int) r (Row of the Cell)
+//           (int) c (Column of the Cell)
+//           (uint64_t) bit (Bit of the lane)
+//           (int) alive (1 for alive)
+static void batchWriteCell(Batch *batch, int r, int c, uint64_t bit, int alive)
+{
+    uint64_t *current = batchCell(batch, batch->currentBoard, r, c);
+    uint64_t *older = batchCell(batch, batch->olderBoard, r, c);
+
+    *current = alive ? *current | bit : *current & ~bit;
+    *older = *current;
+}
+
+// Start a lane again after its Cells were written
+//    Param: (Batch*) batch (The batch)
+//           (int) lane (Lane of the board)
+static void batchRestartLane(Batch *batch, int lane)
+{
+    batch->stable &= ~((uint64_t)1 << lane);
+    batch->loadedAt[lane] = batch->generation;
+}
+
+/* -------------------------------- Batch API -------------------------------- */
+Batch *batchCreate(int HEIGHT, int WIDTH)
+{
+    Batch *batch = (Batch *)calloc(1, sizeof(Batch));
+    if (batch == NULL)
+    {
+        return NULL;
+    }
+
+    batch->HEIGHT = HEIGHT;
+    batch->WIDTH = WIDTH;
+    batch->stride = WIDTH + 2;
+
+    size_t boardSize = (size_t)(HEIGHT + 2) * batch->stride * sizeof(uint64_t);
+    batch->arena = arenaCreate(2 * (boardSize + ARENA_CACHE_LINE), ARENA_NORMAL_PAGES);
+    if (batch->arena != NULL)
+    {
+        batch->currentBoard = (uint64_t *)arenaAllocate(batch->arena, boardSize, ARENA_CACHE_LINE);
+        batch->olderBoard = (uint64_t *)arenaAllocate(batch->arena, boardSize, ARENA_CACHE_LINE);
+    }
+    if (batch->currentBoard == NULL || batch->olderBoard == NULL)
+    {
+        batchFree(batch);
+        return NULL;
+    }
+
+    // Every board starts dead, which is settled
+    for (size_t i = 0; i < boardSize / sizeof(uint64_t); i++)
+    {
+        batch->currentBoard[i] = 0;
+        batch->olderBoard[i] = 0;
+    }
+    batch->stable = ~(uint64_t)0;
+
+    return batch;
+}
+
+void batchLoad(Batch *batch, int lane, int **board)
+{
+    uint64_t bit = (uint64_t)1 << lane;
+
+    for (int i = 0; i < batch->HEIGHT; i++)
+    {
+        for (int j = 0; j < batch->WIDTH; j++)
+        {
+            batchWriteCell(batch, i, j, bit, board[i][j] == 1);
+        }
+    }
+    batchRestartLane(batch, lane);
+}
+
+void batchRandomize(Batch *batch, int lane)
+{
+    uint64_t bit = (uint64_t)1 << lane;
+
+    for (int i = 0; i < batch->HEIGHT; i++)
+    {
+        for (int j = 0; j < batch->WIDTH; j++)
+        {
+            batchWriteCell(batch, i, j, bit, rand() % 2);
+        }
+    }
+    batchRestartLane(batch, lane);
+}
+
+void batchExtract(Batch *batch, int lane, int **board)
+{
+    for (int i = 0; i < batch->HEIGHT; i++)
+    {
+        for (int j = 0; j < batch->WIDTH; j++)
+        {
+            board[i][j] = (*batchCell(batch, batch->currentBoard, i, j) >> lane) & 1;
+        }
+    }
+}
+
+int batchSave(Batch *batch, int lane, char *fileName)
+{
+    FILE *board = fopen(fileName, "wb");
+    if (board == NULL)
+    {
+        return -1;
+    }
+
+    fwrite(&batch->HEIGHT, sizeof(int), 1, board);
+    fwrite(&batch->WIDTH, sizeof(int), 1, board);
+
+    for (int i = 0; i < batch->HEIGHT; i++)
+    {
+        for (int j = 0; j < batch->WIDTH; j++)
+        {
+            int cell = (*batchCell(batch, batch->currentBoard, i, j) >> lane) & 1;
+            fwrite(&cell, sizeof(int), 1, board);
+        }
+    }
+
+    return fclose(board) == 0 ? 0 : -1;
+}
+
+void batchStep(Batch *batch, int generations)
+{
+    int stride = batch->stride;
+
+    for (int g = 0; g < generations; g++)
+    {
+        // Lanes with a Cell that changed since the last generation, and since the one before
+        uint64_t changed = 0;
+        uint64_t returned = 0;
+
+        for (int i = 1; i <= batch->HEIGHT; i++)
+        {
+            uint64_t *up = batch->currentBoard + (size_t)(i - 1) * stride;
+            uint64_t *row = batch->currentBoard + (size_t)i * stride;
+            uint64_t *down = batch->currentBoard + (size_t)(i + 1) * stride;
+
+            // The older board is only read to compare with, so the next board overwrites it in place
+            uint64_t *next = batch->olderBoard + (size_t)i * stride;
+
+            // Every column is independent, the compiler is free to vectorise the loop across columns
+            for (int j = 1; j <= batch->WIDTH; j++)
+            {
+                uint64_t cell = batchNextCell(up[j - 1], up[j], up[j + 1], row[j - 1], row[j], row[j + 1], down[j - 1], down[j], down[j + 1]);
+                changed |= cell ^ row[j];
+                returned |= cell ^ next[j];
+                next[j] = cell;
+            }
+        }
+
+        uint64_t *swap = batch->currentBoard;
+        batch->currentBoard = batch->olderBoard;
+        batch->olderBoard = swap;
+
+        batch->stable = ~changed | ~returned;
+        batch->generation++;
+    }
+}
+
+uint64_t batchStable(Batch *batch)
+{
+    return batch->stable;
+}
+
+long batchGeneration(Batch *batch, int lane)
+{
+    return batch->generation - batch->loadedAt[lane];
+}
+
+void batchFree(Batch *batch)
+{
+    if (batch == NULL)
+    {
+        return;
+    }
+
+    arenaFree(batch->arena);
+    free(batch);
+}
@@ -0,0 +1,320 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <changelist.h>
+
+/* -------------------------------------------------------------------------- */
+/*        Engine visiting only the Cells next to those that just changed       */
+/* -------------------------------------------------------------------------- */
+
+// A Cell is one byte: its live neighbour count in the low bits, then its state and flags.
+// The board is padded with a ring of border Cells, so neighbours never need bounds checks.
+#define CHANGE_COUNT 0x0F
+#define CHANGE_ALIVE 0x10
+#define CHANGE_BORDER 0x20
+#define CHANGE_QUEUED 0x40
+
+struct ChangeList
+{
+    int HEIGHT;
+    int WIDTH;
+
+    // Cells of the padded board, row after row of WIDTH + 2
+    int stride;
+    unsigned char *cells;
+    int offsets[8];
+
+    // Padded indices of the Cells that flipped in the last generation, of those flipping in the next,
+    // and of the Cells to visit, each at most once
+    uint32_t *changed;
+    uint32_t *next;
+    uint32_t *candidates;
+    size_t changedCount;
+
+    // Live Cells per row and column, the bounding box only has to be searched again when a side empties
+    long population;
+    int *rowCounts;
+    int *columnCounts;
+    int top;
+    int left;
+    int bottom;
+    int right;
+
+    // For the report
+    long generations;
+    double visited;
+    double flipped;
+};
+
+/* --------------------------- Utilities of the List ------------------------- */
+// Shrink the bounding box past the rows and columns left without live Cells
+//    Param: (ChangeList*) list (The engine, whose box holds every live Cell)
+static void changeListShrinkBox(ChangeList *list)
+{
+    if (list->population == 0)
+    {
+        list->top = list->left = list->bottom = list->right = -1;
+        return;
+    }
+
+    while (list->rowCounts[list->top] == 0)
+    {
+        list->top++;
+    }
+    while (list->rowCounts[list->bottom] == 0)
+    {
+        list->bottom--;
+    }
+    while (list->columnCounts[list->left] == 0)
+    {
+        list->left++;
+    }
+    while (list->columnCounts[list->right] == 0)
+    {
+        list->right--;
+    }
+}
+
+// Grow the bounding box to hold a Cell
+//    Param: (ChangeList*) list (The engine)
+//           (int) r (Row of the Cell)
+//           (int) c (Column of the Cell)
+static void changeListGrowBox(ChangeList *list, int r, int c)
+{
+    if (list->top < 0)
+    {
+        list->top = list->bottom = r;
+        list->left = list->right = c;
+        return;
+    }
+
+    list->top = r < list->top ? r : list->top;
+    list->bottom = r > list->bottom ? r : list->bottom;
+    list->left = c < list->left ? c : list->left;
+    list->right = c > list->right ? c : list->right;
+}
+
+// Calculate one generation
+//    Param: (ChangeList*) list (The engine)
+//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board, updated in place)
+//           (StatsRecorder*) recorder (Receives the statistics of the generation, or NULL)
+static void changeListGeneration(ChangeList *list, int **currentBoard, StatsRecorder *recorder)
+{
+    unsigned char *cells = list->cells;
+    size_t candidateCount = 0;
+
+    // The Cells that flipped and their neighbours are the only ones whose state or count changed
+    for (size_t i = 0; i < list->changedCount; i++)
+    {
+        uint32_t p = list->changed[i];
+        if (!(cells[p] & CHANGE_QUEUED))
+        {
+            cells[p] |= CHANGE_QUEUED;
+            list->candidates[candidateCount++] = p;
+        }
+        for (int k = 0; k < 8; k++)
+        {
+            uint32_t q = p + list->offsets[k];
+            if (!(cells[q] & (CHANGE_QUEUED | CHANGE_BORDER)))
+            {
+                cells[q] |= CHANGE_QUEUED;
+                list->candidates[candidateCount++] = q;
+            }
+        }
+    }
+
+    // The rule is applied to every candidate before any of them flips, the counts are those of the current board
+    size_t nextCount = 0;
+    for (size_t i = 0; i < candidateCount; i++)
+    {
+        uint32_t p = list->candidates[i];
+        unsigned char cell = cells[p] & ~CHANGE_QUEUED;
+        int count = cell & CHANGE_COUNT;
+        int alive = (cell & CHANGE_ALIVE) != 0;
+
+        cells[p] = cell;
+        if (alive ? (count != 2 && count != 3) : count == 3)
+        {
+            list->next[nextCount++] = p;
+        }
+    }
+
+    GenerationStats stats;
+    statsReset(&stats, 0);
+    for (size_t i = 0; i < nextCount; i++)
+    {
+        uint32_t p = list->next[i];
+        int r = p / list->stride - 1;
+        int c = p % list->stride - 1;
+        int born = !(cells[p] & CHANGE_ALIVE);
+
+        // Border Cells are counted too, their counts are never read
+        cells[p] ^= CHANGE_ALIVE;
+        for (int k = 0; k < 8; k++)
+        {
+            cells[p + list->offsets[k]] += born ? 1 : -1;
+        }
+
+        currentBoard[r][c] = born;
+        list->rowCounts[r] += born ? 1 : -1;
+        list->columnCounts[c] += born ? 1 : -1;
+        if (born)
+        {
+            stats.births++;
+            list->population++;
+            changeListGrowBox(list, r, c);
+        }
+        else
+        {
+            stats.deaths++;
+            list->population--;
+        }
+    }
+    changeListShrinkBox(list);
+
+    // The Cells that flipped now are the only ones to start from next time
+    uint32_t *changed = list->changed;
+    list->changed = list->next;
+    list->next = changed;
+    list->changedCount = nextCount;
+
+    list->generations++;
+    list->visited += candidateCount;
+    list->flipped += nextCount;
+
+    if (recorder != NULL)
+    {
+        stats.population = list->population;
+        stats.top = list->top;
+        stats.left = list->left;
+        stats.bottom = list->bottom;
+        stats.right = list->right;
+        statsRecord(recorder, &stats);
+    }
+}
+
+/* ---------------------------- Change List API ------------------------------ */
+ChangeList *changeListCreate(int HEIGHT, int WIDTH)
+{
+    size_t padded = (size_t)(HEIGHT + 2) * (WIDTH + 2);
+    if (padded > UINT32_MAX)
+    {
+        return NULL;
+    }
+
+    ChangeList *list = (ChangeList *)calloc(1, sizeof(ChangeList));
+    if (list == NULL)
+    {
+        return NULL;
+    }
+
+    list->HEIGHT = HEIGHT;
+    list->WIDTH = WIDTH;
+    list->stride = WIDTH + 2;
+
+    size_t cellCount = (size_t)HEIGHT * WIDTH;
+    list->cells = (unsigned char *)malloc(padded);
+    list->changed = (uint32_t *)malloc(cellCount * sizeof(uint32_t));
+    list->next = (uint32_t *)malloc(cellCount * sizeof(uint32_t));
+    list->candidates = (uint32_t *)malloc(cellCount * sizeof(uint32_t));
+    list->rowCounts = (int *)malloc(HEIGHT * sizeof(int));
+    list->columnCounts = (int *)malloc(WIDTH * sizeof(int));
+    if (list->cells == NULL || list->changed == NULL || list->next == NULL || list->candidates == NULL || list->rowCounts == NULL || list->columnCounts == NULL)
+    {
+        changeListFree(list);
+        return NULL;
+    }
+
+    int k = 0;
+    for (int i = -1; i <= 1; i++)
+    {
+        for (int j = -1; j <= 1; j++)
+        {
+            if (i != 0 || j != 0)
+            {
+                list->offsets[k++] = i * list->stride + j;
+            }
+        }
+    }
+
+    return list;
+}
+
+void changeListLoad(ChangeList *list, int **currentBoard)
+{
+    int stride = list->stride;
+    unsigned char *cells = list->cells;
+
+    memset(cells, CHANGE_BORDER, (size_t)(list->HEIGHT + 2) * stride);
+    memset(list->rowCounts, 0, list->HEIGHT * sizeof(int));
+    memset(list->columnCounts, 0, list->WIDTH * sizeof(int));
+    list->population = 0;
+    list->changedCount = 0;
+    list->top = list->left = list->bottom = list->right = -1;
+
+    for (int i = 0; i < list->HEIGHT; i++)
+    {
+        memset(cells + (size_t)(i + 1) * stride + 1, 0, list->WIDTH);
+    }
+
+    // Every live Cell counts as just born, so the first generation visits all Cells that can change
+    for (int i = 0; i < list->HEIGHT; i++)
+    {
+        for (int j = 0; j < list->WIDTH; j++)
+        {
+            currentBoard[i][j] = currentBoard[i][j] == 1;
+            if (!currentBoard[i][j])
+            {
+                continue;
+            }
+
+            uint32_t p = (uint32_t)((i + 1) * (size_t)stride + j + 1);
+            cells[p] |= CHANGE_ALIVE;
+            for (int k = 0; k < 8; k++)
+            {
+                cells[p + list->offsets[k]]++;
+            }
+
+            list->changed[list->changedCount++] = p;
+            list->rowCounts[i]++;
+            list->columnCounts[j]++;
+            list->population++;
+            changeListGrowBox(list, i, j);
+        }
+    }
+}
+
+void changeListStep(ChangeList *list, int generations, int **currentBoard, StatsRecorder *recorder)
+{
+    for (int g = 0; g < generations; g++)
+    {
+        changeListGeneration(list, currentBoard, recorder);
+    }
+}
+
+void changeListReport(ChangeList *list, FILE *stream)
+{
+    double cellCount = (double)list->HEIGHT * list->WIDTH;
+    double visited = list->generations > 0 ? list->visited / list->generations : 0;
+    double flipped = list->generations > 0 ? list->flipped / list->generations : 0;
+
+    fprintf(stream, "Change list: %ld generations, %.1f Cells visited (%.2f%% of the board) and %.1f flipped per generation\n",
+            list->generations, visited, 100 * visited / cellCount, flipped);
+}
+
+void changeListFree(ChangeList *list)
+{
+    if (list == NULL)
+    {
+        return;
+    }
+
+    free(list->cells);
+    free(list->changed);
+    free(list->next);
+    free(list->candidates);
+    free(list->rowCounts);
+    free(list->columnCounts);
+    free(list);
+}
@@ -0,0 +1,1282 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <daemon.h>
+#include <lifeoptions.h>
+
+/* -------------------------------------------------------------------------- */
+/*        Life as a local service, driven over a UNIX domain socket           */
+/* -------------------------------------------------------------------------- */
+
+// Bytes read from a session at least per call, the buffer grows for larger batches
+#define DAEMON_READ_CHUNK 65536
+
+// Bytes of requests read for one batch, more wait in the socket for the next batch (a larger request is read whole)
+#define DAEMON_BATCH_BYTES (1u << 20)
+
+// Bytes of replies and frames held for a session before they are sent, so that a long step sends its frames as it goes
+#define DAEMON_FLUSH_BYTES (1u << 20)
+
+// Connections waiting to be accepted
+#define DAEMON_BACKLOG 64
+
+// A growing buffer of bytes, failed once an allocation did not succeed.
+struct DaemonBuffer
+{
+    unsigned char *data;
+    size_t length;
+    size_t capacity;
+    int failed;
+};
+typedef struct DaemonBuffer DaemonBuffer;
+
+// A connection. Its fd is only read by the worker serving it, written under writeLock by that
+// worker and by workers sending frames, and closed by the worker serving it, under writeLock.
+struct DaemonSession
+{
+    int fd;
+    atomic_int busy;
+    atomic_int closed;
+    atomic_int refs;
+    pthread_mutex_t writeLock;
+    DaemonBuffer in;
+    DaemonBuffer out;
+    struct DaemonSession *nextQueued;
+};
+typedef struct DaemonSession DaemonSession;
+
+// A session receiving the frames of a board, holding a reference to it.
+struct DaemonSubscriber
+{
+    DaemonSession *session;
+    int every;
+};
+typedef struct DaemonSubscriber DaemonSubscriber;
+
+// A resident board. The references are counted under the lock of the table, everything else is under the lock of the board.
+struct DaemonBoard
+{
+    int id;
+    Life *life;
+    pthread_mutex_t lock;
+    int refs;
+    DaemonSubscriber *subscribers;
+    int subscriberCount;
+    int subscriberCapacity;
+};
+typedef struct DaemonBoard DaemonBoard;
+
+struct Daemon
+{
+    LifeOptions options;
+
+    // Boards by id, ids are never reused
+    pthread_mutex_t tableLock;
+    DaemonBoard **boards;
+    int boardCount;
+    int boardCapacity;
+
+    // rand() is shared by every board
+    pthread_mutex_t randomLock;
+
+    // Sessions with requests waiting for a worker
+    pthread_mutex_t queueLock;
+    pthread_cond_t queueReady;
+    DaemonSession *queueHead;
+    DaemonSession *queueTail;
+    int stopping;
+
+    // Workers write a byte once they are done with a session, so that the main thread polls it again
+    int wake[2];
+};
+typedef struct Daemon Daemon;
+
+// Set by SIGINT and SIGTERM, which also write to the wake pipe
+static volatile sig_atomic_t daemonStopRequested = 0;
+static int daemonWakeFd = -1;
+
+/* ---------------------------- Utilities of I/O ----------------------------- */
+// Write all bytes to a socket, waiting while it is full
+//    Param: (int) fd (The socket)
+//           (void*) data (The bytes)
+//           (size_t) length (Number of bytes)
+//    Return: (int) 0 on success, -1 if the connection broke
+static int daemonWriteAll(int fd, void *data, size_t length)
+{
+    unsigned char *bytes = (unsigned char *)data;
+    while (length > 0)
+    {
+        ssize_t written = send(fd, bytes, length, MSG_NOSIGNAL);
+        if (written > 0)
+        {
+            bytes += written;
+            length -= written;
+        }
+        else if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            struct pollfd out = {.fd = fd, .events = POLLOUT};
+            poll(&out, 1, -1);
+        }
+        else if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        else
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Read exactly a number of bytes from a blocking socket
+//    Param: (int) fd (The socket)
+//           (void*) data (Receives the bytes)
+//           (size_t) length (Number of bytes)
+//    Return: (int) 0 on success, -1 if the connection broke or closed
+static int daemonReadAll(int fd, void *data, size_t length)
+{
+    unsigned char *bytes = (unsigned char *)data;
+    while (length > 0)
+    {
+        ssize_t got = recv(fd, bytes, length, 0);
+        if (got > 0)
+        {
+            bytes += got;
+            length -= got;
+        }
+        else if (got < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        else
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Make room in a buffer
+//    Param: (DaemonBuffer*) buffer (The buffer)
+//           (size_t) extra (Bytes needed after its length)
+//    Return: (int) 0 on success, -1 if out of memory (the buffer is marked failed)
+static int daemonReserve(DaemonBuffer *buffer, size_t extra)
+{
+    if (buffer->length + extra <= buffer->capacity)
+    {
+        return 0;
+    }
+
+    size_t capacity = buffer->capacity > 0 ? buffer->capacity : DAEMON_READ_CHUNK;
+    while (capacity < buffer->length + extra)
+    {
+        capacity *= 2;
+    }
+    unsigned char *data = (unsigned char *)realloc(buffer->data, capacity);
+    if (data == NULL)
+    {
+        buffer->failed = 1;
+        return -1;
+    }
+    buffer->data = data;
+    buffer->capacity = capacity;
+    return 0;
+}
+
+// Append bytes to a buffer
+//    Param: (DaemonBuffer*) buffer (The buffer)
+//           (void*) data (The bytes, NULL to append zeros)
+//           (size_t) length (Number of bytes)
+//    Return: (unsigned char*) Where the bytes were appended, NULL if out of memory
+static unsigned char *daemonAppend(DaemonBuffer *buffer, void *data, size_t length)
+{
+    if (daemonReserve(buffer, length) != 0)
+    {
+        return NULL;
+    }
+
+    unsigned char *at = buffer->data + buffer->length;
+    if (data != NULL)
+    {
+        memcpy(at, data, length);
+    }
+    else
+    {
+        memset(at, 0, length);
+    }
+    buffer->length += length;
+    return at;
+}
+
+/* ------------------------ Utilities of the Messages ------------------------ */
+// Bytes of the Cells of a region packed in bits
+//    Param: (DaemonRegion*) region (The region)
+//    Return: (size_t) Number of bytes
+static size_t daemonBitsSize(DaemonRegion *region)
+{
+    return ((size_t)region->height * region->width + 7) / 8;
+}
+
+// Pack the Cells of a region of the board in bits, row by row
+//    Param: (Life*) life (The board)
+//           (DaemonRegion*) region (The region, inside the board)
+//           (unsigned char*) bits (Receives the Cells, zero filled)
+static void daemonPack(Life *life, DaemonRegion *region, unsigned char *bits)
+{
+    int **board = lifeBoard(life);
+    size_t bit = 0;
+    for (int i = 0; i < region->height; i++)
+    {
+        for (int j = 0; j < region->width; j++, bit++)
+        {
+            bits[bit / 8] |= (board[region->top + i][region->left + j] == 1) << (bit % 8);
+        }
+    }
+}
+
+// Write Cells packed in bits over a region of the board
+//    Param: (Life*) life (The board)
+//           (DaemonRegion*) region (The region, inside the board)
+//           (unsigned char*) bits (The Cells)
+static void daemonUnpack(Life *life, DaemonRegion *region, unsigned char *bits)
+{
+    int **board = lifeBoard(life);
+    size_t bit = 0;
+    for (int i = 0; i < region->height; i++)
+    {
+        for (int j = 0; j < region->width; j++, bit++)
+        {
+            board[region->top + i][region->left + j] = (bits[bit / 8] >> (bit % 8)) & 1;
+        }
+    }
+}
+
+// Start a reply in the output of a session, its length is set by daemonReplyEnd
+//    Param: (DaemonBuffer*) out (Output of the session)
+//           (int) opcode (Opcode of the request, or DAEMON_FRAME)
+//           (int) status (The DaemonStatus)
+//           (uint32_t) tag (Tag of the request)
+//           (int) board (The board)
+//    Return: (size_t) Where the reply starts in the output
+static size_t daemonReplyBegin(DaemonBuffer *out, int opcode, int status, uint32_t tag, int board)
+{
+    DaemonReply reply = {.length = 0, .opcode = opcode, .status = status, .tag = tag, .board = board};
+    size_t start = out->length;
+    daemonAppend(out, &reply, sizeof(reply));
+    return start;
+}
+
+// Finish a reply once its payload is appended
+//    Param: (DaemonBuffer*) out (Output of the session)
+//           (size_t) start (Where the reply starts, from daemonReplyBegin)
+static void daemonReplyEnd(DaemonBuffer *out, size_t start)
+{
+    if (out->failed)
+    {
+        return;
+    }
+
+    uint32_t length = (uint32_t)(out->length - start - sizeof(DaemonReply));
+    memcpy(out->data + start, &length, sizeof(length));
+}
+
+// Append a whole reply with an optional payload
+//    Param: (DaemonBuffer*) out (Output of the session)
+//           (DaemonRequest*) request (The request)
+//           (int) status (The DaemonStatus)
+//           (int) board (The board)
+//           (void*) payload (The payload, NULL if none)
+//           (size_t) length (Bytes of the payload)
+static void daemonReply(DaemonBuffer *out, DaemonRequest *request, int status, int board, void *payload, size_t length)
+{
+    size_t start = daemonReplyBegin(out, request->opcode, status, request->tag, board);
+    if (payload != NULL)
+    {
+        daemonAppend(out, payload, length);
+    }
+    daemonReplyEnd(out, start);
+}
+
+// Append a frame of the whole board
+//    Param: (DaemonBuffer*) out (Where to append it)
+//           (DaemonBoard*) board (The board, locked)
+static void daemonFrame(DaemonBuffer *out, DaemonBoard *board)
+{
+    DaemonRegion region = {.top = 0, .left = 0, .height = lifeHeight(board->life), .width = lifeWidth(board->life)};
+    size_t start = daemonReplyBegin(out, DAEMON_FRAME, DAEMON_OK, 0, board->id);
+    daemonAppend(out, lifeStats(board->life), sizeof(GenerationStats));
+    daemonAppend(out, &region, sizeof(region));
+    unsigned char *bits = daemonAppend(out, NULL, daemonBitsSize(&region));
+    if (bits != NULL)
+    {
+        daemonPack(board->life, &region, bits);
+    }
+    daemonReplyEnd(out, start);
+}
+
+/* ------------------------- Utilities of the Sessions ----------------------- */
+// Create a session for an accepted connection
+//    Param: (int) fd (The connection, made non-blocking)
+//    Return: (DaemonSession*) The session with one reference, NULL if out of memory
+static DaemonSession *daemonSessionCreate(int fd)
+{
+    DaemonSession *session = (DaemonSession *)calloc(1, sizeof(DaemonSession));
+    if (session == NULL)
+    {
+        return NULL;
+    }
+
+    session->fd = fd;
+    atomic_init(&session->busy, 0);
+    atomic_init(&session->closed, 0);
+    atomic_init(&session->refs, 1);
+    pthread_mutex_init(&session->writeLock, NULL);
+    return session;
+}
+
+// Drop a reference to a session, freeing it with the last one
+//    Param: (DaemonSession*) session (The session)
+static void daemonSessionRelease(DaemonSession *session)
+{
+    if (atomic_fetch_sub(&session->refs, 1) != 1)
+    {
+        return;
+    }
+
+    if (!atomic_load(&session->closed))
+    {
+        close(session->fd);
+    }
+    pthread_mutex_destroy(&session->writeLock);
+    free(session->in.data);
+    free(session->out.data);
+    free(session);
+}
+
+// Close the connection of a session, the session itself lives on while referenced
+//    Param: (DaemonSession*) session (The session)
+static void daemonSessionClose(DaemonSession *session)
+{
+    pthread_mutex_lock(&session->writeLock);
+    if (!atomic_load(&session->closed))
+    {
+        close(session->fd);
+        atomic_store(&session->closed, 1);
+    }
+    pthread_mutex_unlock(&session->writeLock);
+}
+
+// Send bytes to a session, unless its connection is closed
+// A broken connection is shut down, so that the worker reading it sees the end and closes it
+//    Param: (DaemonSession*) session (The session)
+//           (void*) data (The bytes)
+//           (size_t) length (Number of bytes)
+static void daemonSessionWrite(DaemonSession *session, void *data, size_t length)
+{
+    pthread_mutex_lock(&session->writeLock);
+    if (!atomic_load(&session->closed) && daemonWriteAll(session->fd, data, length) != 0)
+    {
+        shutdown(session->fd, SHUT_RDWR);
+    }
+    pthread_mutex_unlock(&session->writeLock);
+}
+
+// Send what the output of a session holds once there is enough of it, or all of it
+//    Param: (DaemonSession*) session (The session)
+//           (int) all (1 to send whatever it holds, 0 only past DAEMON_FLUSH_BYTES)
+static void daemonSessionFlush(DaemonSession *session, int all)
+{
+    if (session->out.failed || session->out.length == 0 || (!all && session->out.length < DAEMON_FLUSH_BYTES))
+    {
+        return;
+    }
+    daemonSessionWrite(session, session->out.data, session->out.length);
+    session->out.length = 0;
+}
+
+/* -------------------------- Utilities of the Boards ------------------------ */
+// Add a board to the table
+//    Param: (Daemon*) daemon (The daemon)
+//           (Life*) life (The board)
+//    Return: (int) Id of the board, -1 if out of memory (the board is freed)
+static int daemonBoardAdd(Daemon *daemon, Life *life)
+{
+    DaemonBoard *board = (DaemonBoard *)calloc(1, sizeof(DaemonBoard));
+    if (board == NULL)
+    {
+        lifeFree(life);
+        return -1;
+    }
+    board->life = life;
+    board->refs = 1;
+    pthread_mutex_init(&board->lock, NULL);
+
+    pthread_mutex_lock(&daemon->tableLock);
+    if (daemon->boardCount == daemon->boardCapacity)
+    {
+        int capacity = daemon->boardCapacity > 0 ? 2 * daemon->boardCapacity : 16;
+        DaemonBoard **boards = (DaemonBoard **)realloc(daemon->boards, capacity * sizeof(DaemonBoard *));
+        if (boards == NULL)
+        {
+            pthread_mutex_unlock(&daemon->tableLock);
+            pthread_mutex_destroy(&board->lock);
+            lifeFree(life);
+            free(board);
+            return -1;
+        }
+        daemon->boards = boards;
+        daemon->boardCapacity = capacity;
+    }
+    board->id = daemon->boardCount;
+    daemon->boards[daemon->boardCount++] = board;
+    pthread_mutex_unlock(&daemon->tableLock);
+
+    return board->id;
+}
+
+// Free a board nobody references any more
+//    Param: (DaemonBoard*) board (The board)
+static void daemonBoardFree(DaemonBoard *board)
+{
+    for (int i = 0; i < board->subscriberCount; i++)
+    {
+        daemonSessionRelease(board->subscribers[i].session);
+    }
+    free(board->subscribers);
+    lifeFree(board->life);
+    pthread_mutex_destroy(&board->lock);
+    free(board);
+}
+
+// Find a board by id, reference it and lock it
+// The table is only locked while looking, so that a long step on one board holds up no other
+//    Param: (Daemon*) daemon (The daemon)
+//           (int) id (Id of the board)
+//    Return: (DaemonBoard*) The board, locked, NULL if there is no such board
+static DaemonBoard *daemonBoardAcquire(Daemon *daemon, int id)
+{
+    pthread_mutex_lock(&daemon->tableLock);
+    DaemonBoard *board = id >= 0 && id < daemon->boardCount ? daemon->boards[id] : NULL;
+    if (board != NULL)
+    {
+        board->refs++;
+    }
+    pthread_mutex_unlock(&daemon->tableLock);
+
+    if (board != NULL)
+    {
+        pthread_mutex_lock(&board->lock);
+    }
+    return board;
+}
+
+// Unlock a board and drop the reference, freeing it if it was removed and this was the last one
+//    Param: (Daemon*) daemon (The daemon)
+//           (DaemonBoard*) board (The board, locked)
+static void daemonBoardRelease(Daemon *daemon, DaemonBoard *board)
+{
+    pthread_mutex_unlock(&board->lock);
+
+    pthread_mutex_lock(&daemon->tableLock);
+    int last = --board->refs == 0;
+    pthread_mutex_unlock(&daemon->tableLock);
+
+    if (last)
+    {
+        daemonBoardFree(board);
+    }
+}
+
+// Remove a board from the table, it is freed once the last request using it is done
+//    Param: (Daemon*) daemon (The daemon)
+//           (DaemonBoard*) board (The board, acquired)
+static void daemonBoardRemove(Daemon *daemon, DaemonBoard *board)
+{
+    pthread_mutex_lock(&daemon->tableLock);
+    if (daemon->boards[board->id] == board)
+    {
+        daemon->boards[board->id] = NULL;
+        board->refs--;
+    }
+    pthread_mutex_unlock(&daemon->tableLock);
+}
+
+// Send a frame to the subscribers of a board, dropping those whose connection is closed
+//    Param: (DaemonBoard*) board (The board, locked)
+//           (DaemonSession*) current (Session of the request, whose frames go with its replies to keep them in order)
+//           (int) all (1 to send to every subscriber, 0 only to those of the generation)
+static void daemonBoardPublish(DaemonBoard *board, DaemonSession *current, int all)
+{
+    long generation = lifeGeneration(board->life);
+    DaemonBuffer frame = {0};
+
+    for (int i = 0; i < board->subscriberCount; i++)
+    {
+        DaemonSubscriber *subscriber = &board->subscribers[i];
+        if (atomic_load(&subscriber->session->closed))
+        {
+            daemonSessionRelease(subscriber->session);
+            board->subscribers[i--] = board->subscribers[--board->subscriberCount];
+            continue;
+        }
+        if (!all && generation % subscriber->every != 0)
+        {
+            continue;
+        }
+
+        if (subscriber->session == current)
+        {
+            daemonFrame(&current->out, board);
+            daemonSessionFlush(current, 0);
+            continue;
+        }
+
+        // The frame is packed once for every other subscriber
+        if (frame.length == 0)
+        {
+            daemonFrame(&frame, board);
+        }
+        if (!frame.failed)
+        {
+            daemonSessionWrite(subscriber->session, frame.data, frame.length);
+        }
+    }
+
+    free(frame.data);
+}
+
+// Calculate generations, stopping on every generation a subscriber has to receive
+//    Param: (DaemonBoard*) board (The board, locked)
+//           (int) generations (Number of generations)
+//           (DaemonSession*) current (Session of the request)
+static void daemonBoardStep(DaemonBoard *board, int generations, DaemonSession *current)
+{
+    while (generations > 0)
+    {
+        int chunk = generations;
+        long generation = lifeGeneration(board->life);
+        for (int i = 0; i < board->subscriberCount; i++)
+        {
+            long untilFrame = board->subscribers[i].every - generation % board->subscribers[i].every;
+            if (untilFrame < chunk)
+            {
+                chunk = (int)untilFrame;
+            }
+        }
+
+        lifeStep(board->life, chunk);
+        generations -= chunk;
+        if (board->subscriberCount > 0)
+        {
+            daemonBoardPublish(board, current, 0);
+        }
+    }
+}
+
+// Subscribe a session to the frames of a board, or unsubscribe it
+//    Param: (DaemonBoard*) board (The board, locked)
+//           (DaemonSession*) session (The session)
+//           (int) every (Send every such generation, 0 to unsubscribe)
+//    Return: (int) DAEMON_OK, or DAEMON_NO_MEMORY
+static int daemonBoardSubscribe(DaemonBoard *board, DaemonSession *session, int every)
+{
+    for (int i = 0; i < board->subscriberCount; i++)
+    {
+        if (board->subscribers[i].session != session)
+        {
+            continue;
+        }
+        if (every > 0)
+        {
+            board->subscribers[i].every = every;
+        }
+        else
+        {
+            daemonSessionRelease(session);
+            board->subscribers[i] = board->subscribers[--board->subscriberCount];
+        }
+        return DAEMON_OK;
+    }
+
+    if (every == 0)
+    {
+        return DAEMON_OK;
+    }
+
+    if (board->subscriberCount == board->subscriberCapacity)
+    {
+        int capacity = board->subscriberCapacity > 0 ? 2 * board->subscriberCapacity : 4;
+        DaemonSubscriber *subscribers = (DaemonSubscriber *)realloc(board->subscribers, capacity * sizeof(DaemonSubscriber));
+        if (subscribers == NULL)
+        {
+            return DAEMON_NO_MEMORY;
+        }
+        board->subscribers = subscribers;
+        board->subscriberCapacity = capacity;
+    }
+
+    atomic_fetch_add(&session->refs, 1);
+    board->subscribers[board->subscriberCount].session = session;
+    board->subscribers[board->subscriberCount].every = every;
+    board->subscriberCount++;
+    return DAEMON_OK;
+}
+
+/* ------------------------- Utilities of the Requests ----------------------- */
+// Name of a board file sent by a client, which may only name files under the working directory of the daemon
+//    Param: (DaemonRequest*) request (DAEMON_LOAD or DAEMON_SAVE)
+//           (unsigned char*) payload (The name, not terminated)
+//    Return: (string) The name, allocated, NULL if it is empty, absolute, has a ".." component or is out of memory
+static char *daemonFileName(DaemonRequest *request, unsigned char *payload)
+{
+    char *fileName = strndup((char *)payload, request->length);
+    if (fileName == NULL)
+    {
+        return NULL;
+    }
+
+    int allowed = fileName[0] != '\0' && fileName[0] != '/';
+    for (char *part = fileName; allowed && *part != '\0';)
+    {
+        size_t length = strcspn(part, "/");
+        allowed = length != 2 || strncmp(part, "..", 2) != 0;
+        part += part[length] == '/' ? length + 1 : length;
+    }
+
+    if (!allowed)
+    {
+        free(fileName);
+        return NULL;
+    }
+    return fileName;
+}
+
+// Create a board from a request, from its size or from a board file
+//    Param: (Daemon*) daemon (The daemon)
+//           (DaemonRequest*) request (DAEMON_CREATE or DAEMON_LOAD)
+//           (unsigned char*) payload (The payload)
+//           (DaemonBuffer*) out (Output of the session)
+static void daemonCreate(Daemon *daemon, DaemonRequest *request, unsigned char *payload, DaemonBuffer *out)
+{
+    LifeOptions options = daemon->options;
+    int HEIGHT, WIDTH;
+    char *fileName = NULL;
+
+    if (request->opcode == DAEMON_CREATE)
+    {
+        DaemonCreate create;
+        if (request->length != sizeof(create))
+        {
+            daemonReply(out, request, DAEMON_BAD_REQUEST, -1, NULL, 0);
+            return;
+        }
+        memcpy(&create, payload, sizeof(create));
+        if (create.HEIGHT < 1 || create.WIDTH < 1 || create.engine < 0 || create.engine > GROWING_ENGINE)
+        {
+            daemonReply(out, request, DAEMON_BAD_REQUEST, -1, NULL, 0);
+            return;
+        }
+        HEIGHT = create.HEIGHT;
+        WIDTH = create.WIDTH;
+        if (create.engine != 0)
+        {
+            options.engine = create.engine;
+        }
+    }
+    else
+    {
+        fileName = daemonFileName(request, payload);
+        if (fileName == NULL || lifeReadSize(fileName, &HEIGHT, &WIDTH) != 0)
+        {
+            free(fileName);
+            daemonReply(out, request, DAEMON_FILE_ERROR, -1, NULL, 0);
+            return;
+        }
+    }
+
+    Life *life = lifeCreate(HEIGHT, WIDTH, &options);
+    if (life != NULL && fileName != NULL && lifeLoad(life, fileName) != 0)
+    {
+        // The file changed or was cut short since its size was read
+        lifeFree(life);
+        free(fileName);
+        daemonReply(out, request, DAEMON_FILE_ERROR, -1, NULL, 0);
+        return;
+    }
+    free(fileName);
+
+    int id = life != NULL ? daemonBoardAdd(daemon, life) : -1;
+    daemonReply(out, request, id >= 0 ? DAEMON_OK : DAEMON_NO_MEMORY, id, NULL, 0);
+}
+
+// Run a request on a board
+//    Param: (Daemon*) daemon (The daemon)
+//           (DaemonSession*) session (Session of the request)
+//           (DaemonRequest*) request (The request)
+//           (unsigned char*) payload (The payload)
+//           (DaemonBoard*) board (The board, acquired)
+static void daemonBoardRequest(Daemon *daemon, DaemonSession *session, DaemonRequest *request, unsigned char *payload, DaemonBoard *board)
+{
+    DaemonBuffer *out = &session->out;
+    Life *life = board->life;
+    int32_t value = 0;
+    DaemonRegion region;
+
+    if (request->length == sizeof(value))
+    {
+        memcpy(&value, payload, sizeof(value));
+    }
+
+    switch (request->opcode)
+    {
+    case DAEMON_RANDOMIZE:
+        if (request->length != sizeof(value))
+        {
+            break;
+        }
+        pthread_mutex_lock(&daemon->randomLock);
+        srand((unsigned int)value);
+        lifeRandomize(life);
+        pthread_mutex_unlock(&daemon->randomLock);
+        daemonBoardPublish(board, session, 1);
+        daemonReply(out, request, DAEMON_OK, board->id, NULL, 0);
+        return;
+    case DAEMON_STEP:
+        if (request->length != sizeof(value) || value < 0)
+        {
+            break;
+        }
+        daemonBoardStep(board, value, session);
+        daemonReply(out, request, DAEMON_OK, board->id, lifeStats(life), sizeof(GenerationStats));
+        return;
+    case DAEMON_STATS:
+        daemonReply(out, request, DAEMON_OK, board->id, lifeStats(life), sizeof(GenerationStats));
+        return;
+    case DAEMON_REGION:
+    {
+        if (request->length != sizeof(region))
+        {
+            break;
+        }
+        memcpy(&region, payload, sizeof(region));
+
+        // Clipped to the board in 64 bits, so that no corner or size a client sends overflows; an empty region has no Cells
+        int64_t bottom = (int64_t)region.top + region.height;
+        int64_t right = (int64_t)region.left + region.width;
+        bottom = bottom < lifeHeight(life) ? bottom : lifeHeight(life);
+        right = right < lifeWidth(life) ? right : lifeWidth(life);
+        region.top = region.top < 0 ? 0 : region.top;
+        region.left = region.left < 0 ? 0 : region.left;
+        region.height = bottom > region.top ? (int32_t)(bottom - region.top) : 0;
+        region.width = right > region.left ? (int32_t)(right - region.left) : 0;
+
+        size_t start = daemonReplyBegin(out, request->opcode, DAEMON_OK, request->tag, board->id);
+        daemonAppend(out, &region, sizeof(region));
+        unsigned char *bits = daemonAppend(out, NULL, daemonBitsSize(&region));
+        if (bits != NULL)
+        {
+            daemonPack(life, &region, bits);
+        }
+        daemonReplyEnd(out, start);
+        return;
+    }
+    case DAEMON_SET:
+        if (request->length < sizeof(region))
+        {
+            break;
+        }
+        memcpy(&region, payload, sizeof(region));
+        if (region.top < 0 || region.left < 0 || region.height < 0 || region.width < 0 || region.height > lifeHeight(life) - region.top ||
+            region.width > lifeWidth(life) - region.left || request->length != sizeof(region) + daemonBitsSize(&region))
+        {
+            break;
+        }
+        daemonUnpack(life, &region, payload + sizeof(region));
+        lifeBoardChanged(life);
+        daemonBoardPublish(board, session, 1);
+        daemonReply(out, request, DAEMON_OK, board->id, NULL, 0);
+        return;
+    case DAEMON_SAVE:
+    {
+        char *fileName = daemonFileName(request, payload);
+        int saved = fileName != NULL && lifeSave(life, fileName) == 0;
+        free(fileName);
+        daemonReply(out, request, saved ? DAEMON_OK : DAEMON_FILE_ERROR, board->id, NULL, 0);
+        return;
+    }
+    case DAEMON_SUBSCRIBE:
+        if (request->length != sizeof(value) || value < 0)
+        {
+            break;
+        }
+        // The board as it is now comes first, as for a viewer of a published board
+        daemonReply(out, request, daemonBoardSubscribe(board, session, value), board->id, NULL, 0);
+        if (value > 0)
+        {
+            daemonFrame(out, board);
+        }
+        return;
+    case DAEMON_FREE:
+        daemonBoardRemove(daemon, board);
+        daemonReply(out, request, DAEMON_OK, board->id, NULL, 0);
+        return;
+    default:
+        break;
+    }
+
+    daemonReply(out, request, DAEMON_BAD_REQUEST, board->id, NULL, 0);
+}
+
+// Run a request, appending its reply to the output of the session
+//    Param: (Daemon*) daemon (The daemon)
+//           (DaemonSession*) session (Session of the request)
+//           (DaemonRequest*) request (The request)
+//           (unsigned char*) payload (The payload)
+static void daemonExecute(Daemon *daemon, DaemonSession *session, DaemonRequest *request, unsigned char *payload)
+{
+    if (request->opcode == DAEMON_CREATE || request->opcode == DAEMON_LOAD)
+    {
+        daemonCreate(daemon, request, payload, &session->out);
+        return;
+    }
+
+    DaemonBoard *board = daemonBoardAcquire(daemon, request->board);
+    if (board == NULL)
+    {
+        daemonReply(&session->out, request, DAEMON_NO_BOARD, request->board, NULL, 0);
+        return;
+    }
+    daemonBoardRequest(daemon, session, request, payload, board);
+    daemonBoardRelease(daemon, board);
+}
+
+// Whether the input of a session holds a batch to run: a whole first request, or a header breaking the protocol
+//    Param: (DaemonBuffer*) in (Input of the session)
+//    Return: (int) 1 if it does, 0 if more has to be read
+static int daemonBatchReady(DaemonBuffer *in)
+{
+    DaemonRequest request;
+    if (in->length < sizeof(request))
+    {
+        return 0;
+    }
+    memcpy(&request, in->data, sizeof(request));
+    return request.length > DAEMON_MAX_PAYLOAD || in->length - sizeof(request) >= request.length;
+}
+
+// Read what a session sent, up to DAEMON_BATCH_BYTES, run every complete request in order as one batch and send the replies in one go
+// Replies and frames past DAEMON_FLUSH_BYTES are sent as they are produced
+//    Param: (Daemon*) daemon (The daemon)
+//           (DaemonSession*) session (The session)
+//    Return: (int) 0 to keep the session, -1 once it ended or broke the protocol
+static int daemonServeSession(Daemon *daemon, DaemonSession *session)
+{
+    int ended = 0;
+    DaemonBuffer *in = &session->in;
+
+    // The rest of what was sent waits in the socket, which polls readable again once this batch is done
+    while (!ended && !(in->length >= DAEMON_BATCH_BYTES && daemonBatchReady(in)))
+    {
+        if (daemonReserve(in, DAEMON_READ_CHUNK) != 0)
+        {
+            return -1;
+        }
+        ssize_t got = recv(session->fd, in->data + in->length, in->capacity - in->length, 0);
+        if (got > 0)
+        {
+            in->length += got;
+        }
+        else if (got < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        else if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            break;
+        }
+        else
+        {
+            ended = 1;
+        }
+    }
+
+    size_t offset = 0;
+    while (in->length - offset >= sizeof(DaemonRequest))
+    {
+        DaemonRequest request;
+        memcpy(&request, in->data + offset, sizeof(request));
+        if (request.length > DAEMON_MAX_PAYLOAD)
+        {
+            ended = 1;
+            break;
+        }
+        if (in->length - offset - sizeof(request) < request.length)
+        {
+            break;
+        }
+
+        daemonExecute(daemon, session, &request, in->data + offset + sizeof(request));
+        offset += sizeof(request) + request.length;
+        daemonSessionFlush(session, 0);
+    }
+
+    // A request that did not fully arrive yet waits at the start of the buffer
+    memmove(in->data, in->data + offset, in->length - offset);
+    in->length -= offset;
+
+    if (session->out.failed)
+    {
+        return -1;
+    }
+    daemonSessionFlush(session, 1);
+    return ended ? -1 : 0;
+}
+
+/* ------------------------- Utilities of the Daemon ------------------------- */
+// Ask the main loop to stop (Handler of SIGINT and SIGTERM)
+//    Param: (int) signalNumber (The signal)
+static void daemonSignal(int signalNumber)
+{
+    (void)signalNumber;
+    daemonStopRequested = 1;
+    if (daemonWakeFd >= 0)
+    {
+        ssize_t ignored = write(daemonWakeFd, "", 1);
+        (void)ignored;
+    }
+}
+
+// Serve the sessions handed over by the main thread, one at a time (Worker thread)
+//    Param: (void*) argument (The daemon)
+static void *daemonWorker(void *argument)
+{
+    Daemon *daemon = (Daemon *)argument;
+
+    while (1)
+    {
+        pthread_mutex_lock(&daemon->queueLock);
+        while (daemon->queueHead == NULL && !daemon->stopping)
+        {
+            pthread_cond_wait(&daemon->queueReady, &daemon->queueLock);
+        }
+        if (daemon->stopping)
+        {
+            pthread_mutex_unlock(&daemon->queueLock);
+            return NULL;
+        }
+        DaemonSession *session = daemon->queueHead;
+        daemon->queueHead = session->nextQueued;
+        if (daemon->queueHead == NULL)
+        {
+            daemon->queueTail = NULL;
+        }
+        pthread_mutex_unlock(&daemon->queueLock);
+
+        if (daemonServeSession(daemon, session) != 0)
+        {
+            daemonSessionClose(session);
+        }
+
+        // Closed first, so that the main thread never polls a closed connection
+        atomic_store(&session->busy, 0);
+        ssize_t ignored = write(daemon->wake[1], "", 1);
+        (void)ignored;
+    }
+}
+
+// Hand a session with requests waiting over to the workers
+//    Param: (Daemon*) daemon (The daemon)
+//           (DaemonSession*) session (The session, marked busy)
+static void daemonQueue(Daemon *daemon, DaemonSession *session)
+{
+    pthread_mutex_lock(&daemon->queueLock);
+    session->nextQueued = NULL;
+    if (daemon->queueTail != NULL)
+    {
+        daemon->queueTail->nextQueued = session;
+    }
+    else
+    {
+        daemon->queueHead = session;
+    }
+    daemon->queueTail = session;
+    pthread_cond_signal(&daemon->queueReady);
+    pthread_mutex_unlock(&daemon->queueLock);
+}
+
+// Open the listening socket
+//    Param: (string) path (Path of the socket, replaced if it exists)
+//    Return: (int) The socket, -1 if it could not be set up
+static int daemonListen(char *path)
+{
+    struct sockaddr_un address;
+    if (strlen(path) >= sizeof(address.sun_path))
+    {
+        return -1;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    // Only the user of the daemon may connect, the socket being created without rights for anyone else
+    unlink(path);
+    mode_t mask = umask(0077);
+    int bound = bind(fd, (struct sockaddr *)&address, sizeof(address));
+    umask(mask);
+    if (bound != 0 || listen(fd, DAEMON_BACKLOG) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    return fd;
+}
+
+/* ---------------------------------- Server --------------------------------- */
+int daemonServe(char *path, LifeOptions *options, int workers)
+{
+    Daemon daemon;
+    memset(&daemon, 0, sizeof(daemon));
+    daemon.options = *options;
+
+    int listener = daemonListen(path);
+    if (listener < 0)
+    {
+        return -1;
+    }
+    if (pipe(daemon.wake) != 0)
+    {
+        close(listener);
+        unlink(path);
+        return -1;
+    }
+    fcntl(daemon.wake[0], F_SETFL, O_NONBLOCK);
+    fcntl(daemon.wake[1], F_SETFL, O_NONBLOCK);
+
+    pthread_mutex_init(&daemon.tableLock, NULL);
+    pthread_mutex_init(&daemon.randomLock, NULL);
+    pthread_mutex_init(&daemon.queueLock, NULL);
+    pthread_cond_init(&daemon.queueReady, NULL);
+
+    struct sigaction stop, oldInterrupt, oldTerminate;
+    memset(&stop, 0, sizeof(stop));
+    stop.sa_handler = daemonSignal;
+    sigemptyset(&stop.sa_mask);
+    daemonStopRequested = 0;
+    daemonWakeFd = daemon.wake[1];
+    sigaction(SIGINT, &stop, &oldInterrupt);
+    sigaction(SIGTERM, &stop, &oldTerminate);
+
+    if (workers < 1)
+    {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        workers = cores > 0 ? (int)cores : 1;
+    }
+    pthread_t *threads = (pthread_t *)malloc(workers * sizeof(pthread_t));
+    int started = 0;
+    while (threads != NULL && started < workers && pthread_create(&threads[started], NULL, daemonWorker, &daemon) == 0)
+    {
+        started++;
+    }
+
+    // The main thread accepts connections and polls the sessions no worker is serving
+    int sessionCount = 0, sessionCapacity = 16;
+    DaemonSession **sessions = (DaemonSession **)malloc(sessionCapacity * sizeof(DaemonSession *));
+    struct pollfd *polled = (struct pollfd *)malloc((sessionCapacity + 2) * sizeof(struct pollfd));
+    DaemonSession **polledSessions = (DaemonSession **)malloc((sessionCapacity + 2) * sizeof(DaemonSession *));
+    if (sessions == NULL || polled == NULL || polledSessions == NULL)
+    {
+        started = 0;
+    }
+
+    while (started > 0 && !daemonStopRequested)
+    {
+        for (int i = 0; i < sessionCount; i++)
+        {
+            if (atomic_load(&sessions[i]->closed) && !atomic_load(&sessions[i]->busy))
+            {
+                daemonSessionRelease(sessions[i]);
+                sessions[i--] = sessions[--sessionCount];
+            }
+        }
+
+        int count = 2;
+        polled[0] = (struct pollfd){.fd = listener, .events = POLLIN};
+        polled[1] = (struct pollfd){.fd = daemon.wake[0], .events = POLLIN};
+        for (int i = 0; i < sessionCount; i++)
+        {
+            if (!atomic_load(&sessions[i]->busy))
+            {
+                polledSessions[count] = sessions[i];
+                polled[count++] = (struct pollfd){.fd = sessions[i]->fd, .events = POLLIN};
+            }
+        }
+
+        if (poll(polled, count, -1) < 0)
+        {
+            continue;
+        }
+
+        if (polled[1].revents)
+        {
+            char drain[64];
+            while (read(daemon.wake[0], drain, sizeof(drain)) > 0)
+            {
+            }
+        }
+
+        for (int i = 2; i < count; i++)
+        {
+            if (polled[i].revents)
+            {
+                atomic_store(&polledSessions[i]->busy, 1);
+                daemonQueue(&daemon, polledSessions[i]);
+            }
+        }
+
+        if (polled[0].revents & POLLIN)
+        {
+            int fd;
+            while ((fd = accept(listener, NULL, NULL)) >= 0)
+            {
+                if (sessionCount == sessionCapacity)
+                {
+                    int capacity = 2 * sessionCapacity;
+                    DaemonSession **grownSessions = (DaemonSession **)realloc(sessions, capacity * sizeof(DaemonSession *));
+                    sessions = grownSessions != NULL ? grownSessions : sessions;
+                    struct pollfd *grownPolled = (struct pollfd *)realloc(polled, (capacity + 2) * sizeof(struct pollfd));
+                    polled = grownPolled != NULL ? grownPolled : polled;
+                    DaemonSession **grownPolledSessions = (DaemonSession **)realloc(polledSessions, (capacity + 2) * sizeof(DaemonSession *));
+                    polledSessions = grownPolledSessions != NULL ? grownPolledSessions : polledSessions;
+                    if (grownSessions == NULL || grownPolled == NULL || grownPolledSessions == NULL)
+                    {
+                        close(fd);
+                        break;
+                    }
+                    sessionCapacity = capacity;
+                }
+
+                DaemonSession *session = daemonSessionCreate(fd);
+                if (session == NULL)
+                {
+                    close(fd);
+                    continue;
+                }
+                fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+                sessions[sessionCount++] = session;
+            }
+        }
+    }
+
+    // Workers finish the batch they are serving, the sessions still waiting are dropped
+    pthread_mutex_lock(&daemon.queueLock);
+    daemon.stopping = 1;
+    pthread_cond_broadcast(&daemon.queueReady);
+    pthread_mutex_unlock(&daemon.queueLock);
+    for (int i = 0; i < started; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    for (int i = 0; i < sessionCount; i++)
+    {
+        daemonSessionClose(sessions[i]);
+        daemonSessionRelease(sessions[i]);
+    }
+    for (int i = 0; i < daemon.boardCount; i++)
+    {
+        if (daemon.boards[i] != NULL)
+        {
+            daemonBoardFree(daemon.boards[i]);
+        }
+    }
+
+    sigaction(SIGINT, &oldInterrupt, NULL);
+    sigaction(SIGTERM, &oldTerminate, NULL);
+    daemonWakeFd = -1;
+
+    close(listener);
+    unlink(path);
+    close(daemon.wake[0]);
+    close(daemon.wake[1]);
+    pthread_cond_destroy(&daemon.queueReady);
+    pthread_mutex_destroy(&daemon.queueLock);
+    pthread_mutex_destroy(&daemon.randomLock);
+    pthread_mutex_destroy(&daemon.tableLock);
+    free(daemon.boards);
+    free(sessions);
+    free(polled);
+    free(polledSessions);
+    free(threads);
+
+    return started > 0 ? 0 : -1;
+}
+
+/* ---------------------------------- Client --------------------------------- */
+int daemonConnect(char *path)
+{
+    struct sockaddr_un address;
+    if (strlen(path) >= sizeof(address.sun_path))
+    {
+        return -1;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0 && connect(fd, (struct sockaddr *)&address, sizeof(address)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int daemonSend(int fd, DaemonRequest *request, void *payload)
+{
+    if (daemonWriteAll(fd, request, sizeof(DaemonRequest)) != 0)
+    {
+        return -1;
+    }
+    return request->length > 0 ? daemonWriteAll(fd, payload, request->length) : 0;
+}
+
+int daemonReceive(int fd, DaemonReply *reply, void **payload)
+{
+    *payload = NULL;
+    if (daemonReadAll(fd, reply, sizeof(DaemonReply)) != 0)
+    {
+        return -1;
+    }
+    if (reply->length == 0)
+    {
+        return 0;
+    }
+
+    *payload = malloc(reply->length);
+    if (*payload == NULL || daemonReadAll(fd, *payload, reply->length) != 0)
+    {
+        free(*payload);
+        *payload = NULL;
+        return -1;
+    }
+    return 0;
+}
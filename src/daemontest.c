@@ -0,0 +1,140 @@
+#include <limits.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <daemon.h>
+
+/* -------------------------------------------------------------------------- */
+/*     Daemon test: regions a client may send, clipped to the board           */
+/* -------------------------------------------------------------------------- */
+
+// A daemon is forked on a socket of its own, a board of 20x30 Cells is created and every
+// region below is asked for; the reply must be the region clipped to the board, with as
+// many bytes of Cells as it has. Prints every region that fails, exits 1 if one did.
+
+#define TEST_HEIGHT 20
+#define TEST_WIDTH 30
+
+// Struct for a region asked for and the region the daemon must reply
+struct RegionCase
+{
+    DaemonRegion asked;
+    DaemonRegion clipped;
+};
+typedef struct RegionCase RegionCase;
+
+static RegionCase regionCases[] = {
+    {{0, 0, TEST_HEIGHT, TEST_WIDTH}, {0, 0, TEST_HEIGHT, TEST_WIDTH}},
+    {{-5, -7, 10, 10}, {0, 0, 5, 3}},
+    {{15, 25, INT_MAX, INT_MAX}, {15, 25, 5, 5}},
+    {{INT_MIN, 0, 10, 10}, {0, 0, 0, 10}},
+    {{0, INT_MIN, 10, 10}, {0, 0, 10, 0}},
+    {{INT_MIN, INT_MIN, INT_MAX, INT_MAX}, {0, 0, 0, 0}},
+    {{-1, -1, INT_MAX, INT_MAX}, {0, 0, TEST_HEIGHT, TEST_WIDTH}},
+    {{INT_MAX, 0, 10, 10}, {INT_MAX, 0, 0, 10}},
+    {{0, INT_MAX, INT_MAX, INT_MAX}, {0, INT_MAX, TEST_HEIGHT, 0}},
+    {{TEST_HEIGHT, TEST_WIDTH, 10, 10}, {TEST_HEIGHT, TEST_WIDTH, 0, 0}},
+    {{5, 5, -10, INT_MIN}, {5, 5, 0, 0}},
+};
+
+// Send a request and receive its reply
+//    Param: (int) fd (The connected socket)
+//           (DaemonOpcode) opcode (The request)
+//           (int) board (The board asked for)
+//           (void*) payload (The payload)
+//           (uint32_t) length (Bytes of the payload)
+//           (DaemonReply*) reply (Receives the header of the reply)
+//    Return: (void*) The payload of the reply, to be freed, NULL if empty or the connection broke
+static void *testRequest(int fd, DaemonOpcode opcode, int board, void *payload, uint32_t length, DaemonReply *reply)
+{
+    DaemonRequest request = {length, (uint16_t)opcode, 0, 1, board};
+    void *answer = NULL;
+
+    reply->status = DAEMON_BAD_REQUEST;
+    if (daemonSend(fd, &request, payload) != 0 || daemonReceive(fd, reply, &answer) != 0)
+    {
+        return NULL;
+    }
+    return answer;
+}
+
+int main(void)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/daemontest.%d.sock", (int)getpid());
+
+    LifeOptions *options = lifeOptionsCreate();
+    pid_t server = fork();
+    if (server == 0)
+    {
+        _exit(daemonServe(path, options, 1) == 0 ? 0 : 1);
+    }
+
+    // Wait for the daemon to listen
+    int fd = -1;
+    for (int attempt = 0; attempt < 200 && fd < 0; attempt++)
+    {
+        fd = daemonConnect(path);
+        if (fd < 0)
+        {
+            usleep(10000);
+        }
+    }
+    if (fd < 0)
+    {
+        printf("FAIL: no daemon listens on %s\n", path);
+        kill(server, SIGTERM);
+        waitpid(server, NULL, 0);
+        lifeOptionsFree(options);
+        return 1;
+    }
+
+    DaemonReply reply;
+    DaemonCreate create = {TEST_HEIGHT, TEST_WIDTH, 0};
+    free(testRequest(fd, DAEMON_CREATE, 0, &create, sizeof(create), &reply));
+    int board = reply.board;
+    int failed = reply.status != DAEMON_OK;
+    if (failed)
+    {
+        printf("FAIL: create %dx%d, status %d\n", TEST_HEIGHT, TEST_WIDTH, reply.status);
+    }
+
+    for (size_t i = 0; i < sizeof(regionCases) / sizeof(regionCases[0]) && !failed; i++)
+    {
+        DaemonRegion *asked = &regionCases[i].asked;
+        DaemonRegion *clipped = &regionCases[i].clipped;
+        unsigned char *answer = testRequest(fd, DAEMON_REGION, board, asked, sizeof(*asked), &reply);
+
+        DaemonRegion got = {0, 0, -1, -1};
+        if (answer != NULL && reply.length >= sizeof(got))
+        {
+            memcpy(&got, answer, sizeof(got));
+        }
+        uint32_t cells = (uint32_t)(((size_t)got.width * got.height + 7) / 8);
+        if (reply.status != DAEMON_OK || memcmp(&got, clipped, sizeof(got)) != 0 || reply.length != sizeof(got) + cells)
+        {
+            printf("FAIL: region (%d, %d) %dx%d replied (%d, %d) %dx%d with %u bytes, status %d\n", asked->top, asked->left,
+                   asked->height, asked->width, got.top, got.left, got.height, got.width, reply.length, reply.status);
+            failed = 1;
+        }
+        free(answer);
+    }
+
+    close(fd);
+    kill(server, SIGTERM);
+    int status = 0;
+    waitpid(server, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+        printf("FAIL: the daemon did not shut down cleanly\n");
+        failed = 1;
+    }
+    unlink(path);
+    lifeOptionsFree(options);
+
+    printf(failed ? "daemontest: FAILED\n" : "daemontest: passed\n");
+    return failed;
+}
@@ -0,0 +1,723 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+#include <domain.h>
+
+/* -------------------------------------------------------------------------- */
+/*          Multi-process domain decomposition with halo row exchange         */
+/* -------------------------------------------------------------------------- */
+
+// Number of halo rows a ring can hold before the sender has to wait for its neighbour
+#define DOMAIN_RING_SLOTS 4
+
+// Size of a cache line, shared counters are kept on their own lines
+#define DOMAIN_CACHE_LINE 64
+
+// Generations a worker can keep statistics for before the coordinator collects them
+#define DOMAIN_STATS_SLOTS 256
+
+// Waits of the coordinator between two looks for dead workers, once it has started to sleep
+#define DOMAIN_REAP_WAITS 256
+
+/* ------------------------ Data Structures of a Domain ---------------------- */
+// Enum for the commands the coordinator sends to the workers.
+enum DomainCommand
+{
+    DOMAIN_SCATTER = 1,
+    DOMAIN_GATHER = 2,
+    DOMAIN_STEP = 3,
+    DOMAIN_QUIT = 4
+};
+typedef enum DomainCommand DomainCommand;
+
+// Control block in shared memory: one command at a time, every worker being woken for it by its semaphore.
+struct DomainControl
+{
+    _Alignas(DOMAIN_CACHE_LINE) atomic_int command;
+    atomic_int argument;
+    _Alignas(DOMAIN_CACHE_LINE) atomic_int done;
+};
+typedef struct DomainControl DomainControl;
+
+// Single-producer single-consumer ring of halo rows in shared memory, one byte per Cell.
+struct HaloRing
+{
+    _Alignas(DOMAIN_CACHE_LINE) atomic_long head;
+    _Alignas(DOMAIN_CACHE_LINE) atomic_long tail;
+    _Alignas(DOMAIN_CACHE_LINE) unsigned char slots[];
+};
+typedef struct HaloRing HaloRing;
+
+// One direction of a boundary as seen by a worker: a ring or a UNIX socket.
+struct HaloChannel
+{
+    HaloRing *ring;
+    int fd;
+};
+typedef struct HaloChannel HaloChannel;
+
+struct Domain
+{
+    int HEIGHT;
+    int WIDTH;
+    int processes;
+    DomainTransport transport;
+    NumaPinning pinning;
+
+    // Worker processes, 0 once reaped; a domain that lost one can only be stopped
+    pid_t *workers;
+    int failed;
+
+    void *shared;
+    size_t sharedSize;
+    DomainControl *control;
+    int *frame;
+
+    // stats[worker * DOMAIN_STATS_SLOTS + g]: statistics of the stripe of a worker after generation g of a step
+    GenerationStats *stats;
+
+    // wake[worker]: posted once for every command, idle workers sleep on it instead of polling the control block
+    sem_t *wake;
+    int wakeReady;
+
+    // Boundary b lies between worker b and worker b + 1
+    HaloRing **downRings;
+    HaloRing **upRings;
+    int (*sockets)[2];
+};
+
+/* --------------------------- Utilities of a Domain ------------------------- */
+// Round a size up to a whole number of cache lines
+//    Param: (size_t) size (Size in bytes)
+//    Return: (size_t) Rounded size
+static size_t domainAlign(size_t size)
+{
+    return (size + DOMAIN_CACHE_LINE - 1) / DOMAIN_CACHE_LINE * DOMAIN_CACHE_LINE;
+}
+
+// Wait politely within a step: spin a little, then yield, then sleep
+//    Param: (int*) spins (Number of times the caller already waited)
+static void domainBackoff(int *spins)
+{
+    (*spins)++;
+    if (*spins < 64)
+    {
+        return;
+    }
+    if (*spins < 1024)
+    {
+        sched_yield();
+        return;
+    }
+    usleep(50);
+}
+
+// First row and number of rows of the stripe owned by a worker
+//    Param: (Domain*) domain (The domain)
+//           (int) index (Index of the worker)
+//           (int*) first (First row of the stripe)
+//           (int*) rows (Number of rows of the stripe)
+static void domainStripe(Domain *domain, int index, int *first, int *rows)
+{
+    int base = domain->HEIGHT / domain->processes;
+    int extra = domain->HEIGHT % domain->processes;
+
+    *rows = base + (index < extra ? 1 : 0);
+    *first = index * base + (index < extra ? index : extra);
+}
+
+/* ------------------------------ Halo Transport ----------------------------- */
+// Write all bytes to a socket, a closed socket is an error and not a signal
+//    Return: (int) 0 on success, -1 on failure
+static int domainWriteAll(int fd, unsigned char *bytes, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t written = send(fd, bytes, size, MSG_NOSIGNAL);
+        if (written <= 0)
+        {
+            return -1;
+        }
+        bytes += written;
+        size -= written;
+    }
+    return 0;
+}
+
+// Read all bytes from a socket
+//    Return: (int) 0 on success, -1 on failure
+static int domainReadAll(int fd, unsigned char *bytes, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t got = read(fd, bytes, size);
+        if (got <= 0)
+        {
+            return -1;
+        }
+        bytes += got;
+        size -= got;
+    }
+    return 0;
+}
+
+// Send one row of Cells to a neighbour
+//    Param: (HaloChannel*) channel (Outgoing side of the boundary)
+//           (int) WIDTH (WIDTH of Board)
+//           (int*) row (Row of Cells to send)
+//           (unsigned char*) wire (Scratch row of WIDTH bytes)
+static void haloSend(HaloChannel *channel, int WIDTH, int *row, unsigned char *wire)
+{
+    if (channel->ring == NULL)
+    {
+        for (int j = 0; j < WIDTH; j++)
+        {
+            wire[j] = (unsigned char)row[j];
+        }
+        if (domainWriteAll(channel->fd, wire, WIDTH) != 0)
+        {
+            _exit(1);
+        }
+        return;
+    }
+
+    HaloRing *ring = channel->ring;
+    long head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    int spins = 0;
+
+    // Wait for a free slot, the neighbour may still be behind
+    while (head - atomic_load_explicit(&ring->tail, memory_order_acquire) >= DOMAIN_RING_SLOTS)
+    {
+        domainBackoff(&spins);
+    }
+
+    unsigned char *slot = ring->slots + (size_t)(head % DOMAIN_RING_SLOTS) * WIDTH;
+    for (int j = 0; j < WIDTH; j++)
+    {
+        slot[j] = (unsigned char)row[j];
+    }
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+// Receive one row of Cells from a neighbour
+//    Param: (HaloChannel*) channel (Incoming side of the boundary)
+//           (int) WIDTH (WIDTH of Board)
+//           (int*) row (Halo row that receives the Cells)
+//           (unsigned char*) wire (Scratch row of WIDTH bytes)
+static void haloReceive(HaloChannel *channel, int WIDTH, int *row, unsigned char *wire)
+{
+    if (channel->ring == NULL)
+    {
+        if (domainReadAll(channel->fd, wire, WIDTH) != 0)
+        {
+            _exit(1);
+        }
+        for (int j = 0; j < WIDTH; j++)
+        {
+            row[j] = wire[j];
+        }
+        return;
+    }
+
+    HaloRing *ring = channel->ring;
+    long tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    int spins = 0;
+
+    while (atomic_load_explicit(&ring->head, memory_order_acquire) <= tail)
+    {
+        domainBackoff(&spins);
+    }
+
+    unsigned char *slot = ring->slots + (size_t)(tail % DOMAIN_RING_SLOTS) * WIDTH;
+    for (int j = 0; j < WIDTH; j++)
+    {
+        row[j] = slot[j];
+    }
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+}
+
+/* ------------------------------- Worker Side ------------------------------- */
+// Calculate the next generation of a stripe that carries one halo row above and below
+//    Param: (int) rows (Number of rows of the stripe, without halos)
+//           (int) WIDTH (WIDTH of Board)
+//           (int*) cells (Stripe with halos, (rows + 2) x WIDTH)
+//           (int*) next (Receives the next stripe, same shape)
+//           (int) first (Row of the board the stripe starts at)
+//           (GenerationStats*) stats (Receives the statistics of the stripe)
+static void domainStepStripe(int rows, int WIDTH, int *cells, int *next, int first, GenerationStats *stats)
+{
+    statsReset(stats, 0);
+
+    for (int i = 1; i <= rows; i++)
+    {
+        int firstLive = -1;
+        int lastLive = -1;
+
+        int *up = cells + (size_t)(i - 1) * WIDTH;
+        int *row = cells + (size_t)i * WIDTH;
+        int *down = cells + (size_t)(i + 1) * WIDTH;
+        int *out = next + (size_t)i * WIDTH;
+
+        for (int j = 0; j < WIDTH; j++)
+        {
+            int count = up[j] + down[j];
+            if (j > 0)
+            {
+                count += up[j - 1] + row[j - 1] + down[j - 1];
+            }
+            if (j < WIDTH - 1)
+            {
+                count += up[j + 1] + row[j + 1] + down[j + 1];
+            }
+
+            // Rules of the game
+            out[j] = (count == 3 || (row[j] == 1 && count == 2)) ? 1 : 0;
+
+            stats->population += out[j];
+            stats->births += out[j] & !row[j];
+            stats->deaths += row[j] & !out[j];
+            if (out[j])
+            {
+                firstLive = firstLive < 0 ? j : firstLive;
+                lastLive = j;
+            }
+        }
+
+        if (firstLive >= 0)
+        {
+            statsIncludeRun(stats, first + i - 1, firstLive, lastLive);
+        }
+    }
+}
+
+// Main loop of a worker process: wait for a command, carry it out, report back
+//    Param: (Domain*) domain (The domain, inherited from the coordinator)
+//           (int) index (Index of the worker)
+static void domainWorker(Domain *domain, int index)
+{
+    int WIDTH = domain->WIDTH;
+    int first, rows;
+    domainStripe(domain, index, &first, &rows);
+
+    // Pinned before allocating, so the stripe is first touched on the node the worker stays on
+    numaPin(index, domain->processes, domain->pinning);
+
+    // The stripe lives in memory private to (and first touched by) this worker
+    int *cells = (int *)calloc((size_t)(rows + 2) * WIDTH, sizeof(int));
+    int *next = (int *)calloc((size_t)(rows + 2) * WIDTH, sizeof(int));
+    unsigned char *wire = (unsigned char *)malloc(WIDTH);
+    if (cells == NULL || next == NULL || wire == NULL)
+    {
+        _exit(1);
+    }
+
+    HaloChannel upOut = {NULL, -1}, upIn = {NULL, -1}, downOut = {NULL, -1}, downIn = {NULL, -1};
+    int hasUp = index > 0;
+    int hasDown = index < domain->processes - 1;
+    if (domain->transport == SHARED_MEMORY)
+    {
+        if (hasUp)
+        {
+            upOut.ring = domain->upRings[index - 1];
+            upIn.ring = domain->downRings[index - 1];
+        }
+        if (hasDown)
+        {
+            downOut.ring = domain->downRings[index];
+            downIn.ring = domain->upRings[index];
+        }
+    }
+    else
+    {
+        if (hasUp)
+        {
+            upOut.fd = upIn.fd = domain->sockets[index - 1][1];
+        }
+        if (hasDown)
+        {
+            downOut.fd = downIn.fd = domain->sockets[index][0];
+        }
+
+        // Drop the inherited ends of other boundaries, so a dead neighbour is seen as end of file
+        for (int b = 0; b < domain->processes - 1; b++)
+        {
+            if (domain->sockets[b][0] != downOut.fd)
+            {
+                close(domain->sockets[b][0]);
+            }
+            if (domain->sockets[b][1] != upOut.fd)
+            {
+                close(domain->sockets[b][1]);
+            }
+        }
+    }
+
+    while (1)
+    {
+        // Between commands the game may be paused for minutes, the worker sleeps until it is told what to do
+        while (sem_wait(&domain->wake[index]) != 0)
+        {
+            if (errno != EINTR)
+            {
+                _exit(1);
+            }
+        }
+
+        DomainCommand command = (DomainCommand)atomic_load(&domain->control->command);
+        int argument = atomic_load(&domain->control->argument);
+
+        if (command == DOMAIN_QUIT)
+        {
+            break;
+        }
+
+        if (command == DOMAIN_SCATTER)
+        {
+            memcpy(cells + WIDTH, domain->frame + (size_t)first * WIDTH, (size_t)rows * WIDTH * sizeof(int));
+        }
+        else if (command == DOMAIN_GATHER)
+        {
+            memcpy(domain->frame + (size_t)first * WIDTH, cells + WIDTH, (size_t)rows * WIDTH * sizeof(int));
+        }
+        else if (command == DOMAIN_STEP)
+        {
+            int *top = cells + WIDTH;
+            for (int g = 0; g < argument; g++)
+            {
+                int *bottom = cells + (size_t)rows * WIDTH;
+                int *haloUp = cells;
+                int *haloDown = cells + (size_t)(rows + 1) * WIDTH;
+
+                // Even workers send first and odd workers receive first, so blocking sockets never deadlock
+                if (index % 2 == 0)
+                {
+                    if (hasUp)
+                    {
+                        haloSend(&upOut, WIDTH, top, wire);
+                        haloReceive(&upIn, WIDTH, haloUp, wire);
+                    }
+                    if (hasDown)
+                    {
+                        haloSend(&downOut, WIDTH, bottom, wire);
+                        haloReceive(&downIn, WIDTH, haloDown, wire);
+                    }
+                }
+                else
+                {
+                    if (hasUp)
+                    {
+                        haloReceive(&upIn, WIDTH, haloUp, wire);
+                        haloSend(&upOut, WIDTH, top, wire);
+                    }
+                    if (hasDown)
+                    {
+                        haloReceive(&downIn, WIDTH, haloDown, wire);
+                        haloSend(&downOut, WIDTH, bottom, wire);
+                    }
+                }
+
+                domainStepStripe(rows, WIDTH, cells, next, first, &domain->stats[(size_t)index * DOMAIN_STATS_SLOTS + g % DOMAIN_STATS_SLOTS]);
+
+                // Swap the stripes, the halos of the new one are refilled next generation
+                int *swap = cells;
+                cells = next;
+                next = swap;
+                top = cells + WIDTH;
+            }
+        }
+
+        atomic_fetch_add(&domain->control->done, 1);
+    }
+
+    free(cells);
+    free(next);
+    free(wire);
+}
+
+/* ----------------------------- Coordinator Side ---------------------------- */
+// Reap the workers that have exited, a worker only exits on its own when it failed
+//    Param: (Domain*) domain (The running domain)
+//    Return: (int) 1 if a worker has exited, 0 if all of them still run
+static int domainReap(Domain *domain)
+{
+    for (int k = 0; k < domain->processes; k++)
+    {
+        if (domain->workers[k] > 0 && waitpid(domain->workers[k], NULL, WNOHANG) == domain->workers[k])
+        {
+            domain->workers[k] = 0;
+            domain->failed = 1;
+        }
+    }
+    return domain->failed;
+}
+
+// Publish a command to every worker and wait until all of them are done with it
+//    Param: (Domain*) domain (The running domain)
+//           (DomainCommand) command (The command)
+//           (int) argument (Argument of the command)
+//    Return: (int) 0 on success, -1 if a worker has died (its stripe is lost)
+static int domainCommand(Domain *domain, DomainCommand command, int argument)
+{
+    if (domain->failed)
+    {
+        return -1;
+    }
+
+    atomic_store(&domain->control->done, 0);
+    atomic_store(&domain->control->command, command);
+    atomic_store(&domain->control->argument, argument);
+    for (int k = 0; k < domain->processes; k++)
+    {
+        sem_post(&domain->wake[k]);
+    }
+
+    if (command == DOMAIN_QUIT)
+    {
+        return 0;
+    }
+
+    // Workers waiting for a dead neighbour would wait forever, so the coordinator looks for dead workers while it waits
+    int spins = 0;
+    while (atomic_load(&domain->control->done) < domain->processes)
+    {
+        domainBackoff(&spins);
+        if (spins >= 1024 && spins % DOMAIN_REAP_WAITS == 0 && domainReap(domain))
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+Domain *domainStart(int HEIGHT, int WIDTH, int processes, DomainTransport transport, NumaPinning pinning, int **currentBoard)
+{
+    Domain *domain = (Domain *)calloc(1, sizeof(Domain));
+    if (domain == NULL)
+    {
+        return NULL;
+    }
+
+    domain->HEIGHT = HEIGHT;
+    domain->WIDTH = WIDTH;
+    domain->processes = processes < 1 ? 1 : (processes > HEIGHT ? HEIGHT : processes);
+    domain->transport = transport;
+    domain->pinning = pinning;
+
+    int boundaries = domain->processes - 1;
+    size_t controlSize = domainAlign(sizeof(DomainControl));
+    size_t frameSize = domainAlign((size_t)HEIGHT * WIDTH * sizeof(int));
+    size_t ringSize = domainAlign(sizeof(HaloRing) + (size_t)DOMAIN_RING_SLOTS * WIDTH);
+    size_t ringsSize = transport == SHARED_MEMORY ? ringSize * boundaries * 2 : 0;
+    size_t statsSize = domainAlign(sizeof(GenerationStats) * DOMAIN_STATS_SLOTS * domain->processes);
+    size_t wakeSize = domainAlign(sizeof(sem_t) * domain->processes);
+
+    domain->sharedSize = controlSize + frameSize + statsSize + wakeSize + ringsSize;
+    domain->shared = mmap(NULL, domain->sharedSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (domain->shared == MAP_FAILED)
+    {
+        free(domain);
+        return NULL;
+    }
+
+    // Anonymous shared mappings start zeroed, so every counter starts at 0
+    unsigned char *cursor = (unsigned char *)domain->shared;
+    domain->control = (DomainControl *)cursor;
+    cursor += controlSize;
+    domain->frame = (int *)cursor;
+    cursor += frameSize;
+    domain->stats = (GenerationStats *)cursor;
+    cursor += statsSize;
+    domain->wake = (sem_t *)cursor;
+    cursor += wakeSize;
+
+    domain->workers = (pid_t *)calloc(domain->processes, sizeof(pid_t));
+    domain->downRings = (HaloRing **)calloc(boundaries + 1, sizeof(HaloRing *));
+    domain->upRings = (HaloRing **)calloc(boundaries + 1, sizeof(HaloRing *));
+    domain->sockets = calloc(boundaries + 1, sizeof(int[2]));
+
+    int ready = domain->workers != NULL && domain->downRings != NULL && domain->upRings != NULL && domain->sockets != NULL;
+    while (ready && domain->wakeReady < domain->processes)
+    {
+        ready = sem_init(&domain->wake[domain->wakeReady], 1, 0) == 0;
+        domain->wakeReady += ready;
+    }
+    int paired = 0;
+    for (int b = 0; b < boundaries && ready; b++)
+    {
+        if (transport == SHARED_MEMORY)
+        {
+            domain->downRings[b] = (HaloRing *)cursor;
+            cursor += ringSize;
+            domain->upRings[b] = (HaloRing *)cursor;
+            cursor += ringSize;
+        }
+        else if (socketpair(AF_UNIX, SOCK_STREAM, 0, domain->sockets[b]) == 0)
+        {
+            paired++;
+        }
+        else
+        {
+            ready = 0;
+        }
+    }
+    if (!ready)
+    {
+        for (int b = 0; b < paired; b++)
+        {
+            close(domain->sockets[b][0]);
+            close(domain->sockets[b][1]);
+        }
+        domain->processes = 0;
+        domainStop(domain);
+        return NULL;
+    }
+
+    for (int k = 0; k < domain->processes; k++)
+    {
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+#ifdef __linux__
+            // Never outlive the coordinator
+            prctl(PR_SET_PDEATHSIG, SIGTERM);
+#endif
+            domainWorker(domain, k);
+            _exit(0);
+        }
+        domain->workers[k] = pid;
+
+        if (pid < 0)
+        {
+            break;
+        }
+    }
+
+    // Only the workers talk over the sockets
+    for (int b = 0; b < boundaries && transport == UNIX_SOCKET; b++)
+    {
+        close(domain->sockets[b][0]);
+        close(domain->sockets[b][1]);
+    }
+
+    int started = 0;
+    while (started < domain->processes && domain->workers[started] > 0)
+    {
+        started++;
+    }
+    if (started < domain->processes)
+    {
+        domain->processes = started;
+        domainStop(domain);
+        return NULL;
+    }
+
+    if (domainScatter(domain, currentBoard) != 0)
+    {
+        domainStop(domain);
+        return NULL;
+    }
+
+    return domain;
+}
+
+int domainStep(Domain *domain, int generations, StatsRecorder *recorder)
+{
+    // Without a recorder the workers overwrite their statistics slots freely
+    int chunk = recorder != NULL ? DOMAIN_STATS_SLOTS : generations;
+
+    while (generations > 0)
+    {
+        int count = generations < chunk ? generations : chunk;
+        if (domainCommand(domain, DOMAIN_STEP, count) != 0)
+        {
+            return -1;
+        }
+
+        for (int g = 0; g < count && recorder != NULL; g++)
+        {
+            GenerationStats stats;
+            statsReset(&stats, 0);
+            for (int k = 0; k < domain->processes; k++)
+            {
+                statsMerge(&stats, &domain->stats[(size_t)k * DOMAIN_STATS_SLOTS + g]);
+            }
+            statsRecord(recorder, &stats);
+        }
+
+        generations -= count;
+    }
+    return 0;
+}
+
+int domainGather(Domain *domain, int **currentBoard)
+{
+    if (domainCommand(domain, DOMAIN_GATHER, 0) != 0)
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < domain->HEIGHT; i++)
+    {
+        memcpy(currentBoard[i], domain->frame + (size_t)i * domain->WIDTH, domain->WIDTH * sizeof(int));
+    }
+    return 0;
+}
+
+int domainScatter(Domain *domain, int **currentBoard)
+{
+    for (int i = 0; i < domain->HEIGHT; i++)
+    {
+        for (int j = 0; j < domain->WIDTH; j++)
+        {
+            domain->frame[(size_t)i * domain->WIDTH + j] = currentBoard[i][j] == 1 ? 1 : 0;
+        }
+    }
+
+    return domainCommand(domain, DOMAIN_SCATTER, 0);
+}
+
+void domainStop(Domain *domain)
+{
+    if (domain == NULL)
+    {
+        return;
+    }
+
+    // The workers left after one died may be waiting for it, they are not told but killed
+    domainCommand(domain, DOMAIN_QUIT, 0);
+    for (int k = 0; k < domain->processes; k++)
+    {
+        if (domain->workers[k] > 0)
+        {
+            if (domain->failed)
+            {
+                kill(domain->workers[k], SIGKILL);
+            }
+            waitpid(domain->workers[k], NULL, 0);
+        }
+    }
+
+    for (int k = 0; k < domain->wakeReady; k++)
+    {
+        sem_destroy(&domain->wake[k]);
+    }
+    munmap(domain->shared, domain->sharedSize);
+    free(domain->workers);
+    free(domain->downRings);
+    free(domain->upRings);
+    free(domain->sockets);
+    free(domain);
+}
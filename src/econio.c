@@ -1,3 +1,7 @@
+#if !defined(_WIN32) && !defined(_WIN64)
+#define _GNU_SOURCE     /* fopencookie() */
+#endif
+
 #include "econio.h"
 
 
@@ -8,6 +12,7 @@
 #include <stdio.h>
 #include <conio.h>
 #include <assert.h>
+#include <stdarg.h>
 
 static WORD bgcolor = COL_BLACK;
 static WORD fgcolor = COL_LIGHTGRAY;
@@ -150,11 +155,49 @@ void econio_sleep(double sec) {
 }
 
 
+/* The console API has no escape sequences to buffer, frames are drawn directly. */
+void econio_frame_begin(bool clear) {
+    if (clear)
+        econio_clrscr();
+}
+
+
+void econio_frame_put(int x, int y, char const *glyph, int fg, int bg) {
+    econio_gotoxy(x, y);
+    econio_textcolor(fg);
+    econio_textbackground(bg);
+    fputs(glyph, stdout);
+}
+
+
+void econio_frame_gotoxy(int x, int y) {
+    econio_gotoxy(x, y);
+}
+
+
+void econio_frame_printf(char const *format, ...) {
+    va_list args;
+    econio_textcolor(COL_RESET);
+    econio_textbackground(COL_RESET);
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+
+void econio_frame_commit() {
+    fflush(stdout);
+}
+
+
 #else // defined _WIN32
 
 
 #include <assert.h>
+#include <errno.h>
+#include <stdarg.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <termios.h>
 #include <unistd.h>
 #include <stdbool.h>
@@ -165,19 +208,153 @@ void econio_sleep(double sec) {
 #include <time.h>
 
 
-void econio_textcolor(int color) {
-    static int colormap[] = { 30, 34, 32, 36, 31, 35, 33, 37, 90, 94, 92, 96, 91, 95, 93, 97, 39 };
+static int fgcolormap[] = { 30, 34, 32, 36, 31, 35, 33, 37, 90, 94, 92, 96, 91, 95, 93, 97, 39 };
+static int bgcolormap[] = { 40, 44, 42, 46, 41, 45, 43, 47, 100, 104, 102, 106, 101, 105, 103, 107, 49 };
+
+
+/* Frame statistics, see stats_init() */
+typedef struct {
+    char kind;              /* 'F' committed frame, 'K' output answering a key */
+    long long compose_ns;   /* composing the frame, or handling the key */
+    long long write_ns;     /* sending it to the terminal */
+    size_t bytes;
+    size_t writes;
+} frame_record;
 
+static struct {
+    bool enabled;
+    char const *path;
+    pid_t owner;
+    size_t bytes, writes;   /* sent since the last record */
+    long long begin_ns;     /* econio_frame_begin(), or the key read */
+    bool key_pending;
+    frame_record *records;
+    size_t count, capacity;
+} stats = { false, NULL, 0, 0, 0, 0, false, NULL, 0, 0 };
+
+
+static long long stats_now() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+
+/* Send bytes to the terminal, all of them, returns how many made it */
+static size_t write_all(char const *bytes, size_t length) {
+    size_t written = 0;
+    while (written < length) {
+        ssize_t count = write(STDOUT_FILENO, bytes + written, length - written);
+        stats.writes++;
+        if (count < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        written += count;
+    }
+    stats.bytes += written;
+    return written;
+}
+
+
+static ssize_t stats_stream_write(void *cookie, char const *bytes, size_t length) {
+    (void) cookie;
+    size_t written = write_all(bytes, length);
+    return written == 0 && length != 0 ? -1 : (ssize_t) written;
+}
+
+
+static void stats_record(char kind, long long compose_ns, long long write_ns) {
+    if (stats.count == stats.capacity) {
+        size_t capacity = stats.capacity != 0 ? stats.capacity * 2 : 4096;
+        frame_record *records = realloc(stats.records, capacity * sizeof(frame_record));
+        if (records == NULL)
+            return;
+        stats.records = records;
+        stats.capacity = capacity;
+    }
+    stats.records[stats.count++] = (frame_record) { kind, compose_ns, write_ns, stats.bytes, stats.writes };
+    stats.bytes = stats.writes = 0;
+}
+
+
+/* The program went back to reading keys, what it printed since the last key answered it */
+static void stats_key_answered() {
+    if (!stats.key_pending)
+        return;
+    stats.key_pending = false;
+    long long flushed_ns = stats_now();
+    fflush(stdout);
+    if (stats.bytes != 0)
+        stats_record('K', flushed_ns - stats.begin_ns, stats_now() - flushed_ns);
+}
+
+
+static void stats_key_read() {
+    if (!stats.enabled)
+        return;
+    stats.key_pending = true;
+    stats.begin_ns = stats_now();
+}
+
+
+static void stats_dump() {
+    /* Worker processes forked by the program share the records of their parent */
+    if (getpid() != stats.owner)
+        return;
+    fflush(stdout);
+    FILE *log = fopen(stats.path, "w");
+    if (log == NULL)
+        return;
+    fprintf(log, "kind,compose_ns,write_ns,bytes,writes\n");
+    for (size_t i = 0; i < stats.count; ++i)
+        fprintf(log, "%c,%lld,%lld,%zu,%zu\n", stats.records[i].kind, stats.records[i].compose_ns,
+                stats.records[i].write_ns, stats.records[i].bytes, stats.records[i].writes);
+    fclose(log);
+}
+
+
+/**
+ * Frame statistics, to measure the renderer (see renderbench.c, not on
+ * Windows). They are only kept when the environment variable
+ * ECONIO_FRAME_LOG names a file: stdout is then replaced by a stream
+ * counting the bytes and the write() calls reaching the terminal. A frame
+ * is either one sent by econio_frame_commit(), or the output answering a
+ * key read by econio_getch(), until the program polls for the next key;
+ * every frame is recorded with the time composing it took, the time
+ * writing it took, its bytes and write() calls. The records are written
+ * to the file as CSV when the program exits.
+ */
+__attribute__((constructor)) static void stats_init() {
+    char const *path = getenv("ECONIO_FRAME_LOG");
+    if (path == NULL || *path == '\0')
+        return;
+
+    cookie_io_functions_t functions = { NULL, stats_stream_write, NULL, NULL };
+    FILE *stream = fopencookie(NULL, "w", functions);
+    if (stream == NULL)
+        return;
+    /* Buffered like the stdout it replaces */
+    setvbuf(stream, NULL, isatty(STDOUT_FILENO) ? _IOLBF : _IOFBF, BUFSIZ);
+    stdout = stream;
+
+    stats.enabled = true;
+    stats.path = path;
+    stats.owner = getpid();
+    atexit(stats_dump);
+}
+
+
+void econio_textcolor(int color) {
     assert(color >= 0 && color <= 16);
-    printf("\033[%dm", colormap[color]);
+    printf("\033[%dm", fgcolormap[color]);
 }
 
 
 void econio_textbackground(int color) {
-    static int colormap[] = { 40, 44, 42, 46, 41, 45, 43, 47, 100, 104, 102, 106, 101, 105, 103, 107, 49 };
-
     assert(color >= 0 && color <= 16);
-    printf("\033[%dm", colormap[color]);
+    printf("\033[%dm", bgcolormap[color]);
 }
 
 
@@ -232,6 +409,7 @@ static bool inrawmode() {
 
 bool econio_kbhit() {
     assert(inrawmode());
+    stats_key_answered();
     econio_flush();
 
     fd_set rfds;
@@ -254,7 +432,7 @@ static int rawgetch() {
 }
 
 
-int econio_getch() {
+static int readkey() {
     static struct {
         char const *escape;
         EconioKey key;
@@ -293,9 +471,6 @@ int econio_getch() {
         {NULL, KEY_UNKNOWNKEY},
     };
 
-    assert(inrawmode());
-    econio_flush();
-
     enum { bufsize = 10 };
     char s[bufsize];
     int i = 0;
@@ -325,6 +500,17 @@ int econio_getch() {
 }
 
 
+int econio_getch() {
+    assert(inrawmode());
+    stats_key_answered();
+    econio_flush();
+
+    int key = readkey();
+    stats_key_read();
+    return key;
+}
+
+
 void econio_sleep(double sec) {
     struct timespec req, rem;
     req.tv_sec = (time_t) sec;
@@ -333,4 +519,149 @@ void econio_sleep(double sec) {
 }
 
 
+/* Frame being composed. The buffer is allocated once and only grows, so
+ * after the first frame composing never calls the allocator. The cursor and
+ * colors the terminal will have after the buffered bytes are tracked, to
+ * leave out escape sequences that would not change anything. */
+static struct {
+    char *bytes;
+    size_t length;
+    size_t capacity;
+    int x, y;
+    int fg, bg;
+} frame = { NULL, 0, 0, -1, -1, -1, -1 };
+
+
+/* Makes room for size more bytes in the frame. Out of memory, the bytes
+ * composed so far are sent as they are, and if the new ones still do not
+ * fit false is returned: the caller writes them straight to the terminal,
+ * the frame being drawn in pieces rather than lost. */
+static bool frame_reserve(size_t size) {
+    if (frame.length + size <= frame.capacity)
+        return true;
+    size_t capacity = frame.capacity != 0 ? frame.capacity : 64 * 1024;
+    while (frame.length + size > capacity)
+        capacity *= 2;
+    char *bytes = realloc(frame.bytes, capacity);
+    if (bytes == NULL) {
+        fflush(stdout);
+        write_all(frame.bytes, frame.length);
+        frame.length = 0;
+        return size <= frame.capacity;
+    }
+    frame.bytes = bytes;
+    frame.capacity = capacity;
+    return true;
+}
+
+
+static void frame_append(char const *bytes, size_t length) {
+    if (!frame_reserve(length)) {
+        write_all(bytes, length);
+        return;
+    }
+    memcpy(frame.bytes + frame.length, bytes, length);
+    frame.length += length;
+}
+
+
+static void frame_color(int fg, int bg) {
+    char sequence[16];
+    int length;
+
+    assert(fg >= 0 && fg <= 16 && bg >= 0 && bg <= 16);
+    if (fg == frame.fg && bg == frame.bg)
+        return;
+    if (fg != frame.fg && bg != frame.bg)
+        length = sprintf(sequence, "\033[%d;%dm", fgcolormap[fg], bgcolormap[bg]);
+    else if (fg != frame.fg)
+        length = sprintf(sequence, "\033[%dm", fgcolormap[fg]);
+    else
+        length = sprintf(sequence, "\033[%dm", bgcolormap[bg]);
+    frame_append(sequence, length);
+    frame.fg = fg;
+    frame.bg = bg;
+}
+
+
+void econio_frame_begin(bool clear) {
+    if (stats.enabled)
+        stats.begin_ns = stats_now();
+    frame.length = 0;
+    frame.x = frame.y = -1;
+    /* The colors left by earlier output are not known */
+    frame.fg = frame.bg = -1;
+    if (clear) {
+        frame_append("\033[2J\033[1;1H", 10);
+        frame.x = frame.y = 0;
+    }
+}
+
+
+void econio_frame_gotoxy(int x, int y) {
+    char sequence[32];
+
+    if (x == frame.x && y == frame.y)
+        return;
+    frame_append(sequence, sprintf(sequence, "\033[%d;%dH", y+1, x+1));
+    frame.x = x;
+    frame.y = y;
+}
+
+
+void econio_frame_put(int x, int y, char const *glyph, int fg, int bg) {
+    econio_frame_gotoxy(x, y);
+    frame_color(fg, bg);
+
+    size_t length = strlen(glyph);
+    frame_append(glyph, length);
+
+    /* Every UTF-8 character moves the cursor one column, continuation bytes do not */
+    for (size_t i = 0; i < length; ++i)
+        if ((glyph[i] & 0xC0) != 0x80)
+            frame.x++;
+}
+
+
+void econio_frame_printf(char const *format, ...) {
+    va_list args;
+
+    frame_color(COL_RESET, COL_RESET);
+
+    va_start(args, format);
+    int length = vsnprintf(NULL, 0, format, args);
+    va_end(args);
+    if (length < 0)
+        return;
+
+    va_start(args, format);
+    if (frame_reserve((size_t) length + 1)) {
+        vsnprintf(frame.bytes + frame.length, (size_t) length + 1, format, args);
+        frame.length += length;
+    } else {
+        vprintf(format, args);
+        fflush(stdout);
+    }
+    va_end(args);
+
+    /* Text may wrap or hold newlines, where the cursor ends up is not known */
+    frame.x = frame.y = -1;
+}
+
+
+void econio_frame_commit() {
+    long long commit_ns = stats.enabled ? stats_now() : 0;
+
+    fflush(stdout);
+    write_all(frame.bytes, frame.length);
+    frame.length = 0;
+
+    /* The frame answers the last key, if any */
+    if (stats.enabled) {
+        stats.key_pending = false;
+        stats_record('F', commit_ns - stats.begin_ns, stats_now() - commit_ns);
+    }
+}
+
+
 #endif // defined _WIN32
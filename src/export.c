@@ -0,0 +1,871 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <export.h>
+
+/* -------------------------------------------------------------------------- */
+/*        Export of generations to images, encoded on a pool of threads       */
+/* -------------------------------------------------------------------------- */
+
+// Frames in the ring for every encoder thread, so the simulation can run ahead of the encoders
+#define EXPORT_SLOTS_PER_THREAD 2
+
+// Longest match of the deflate format, and the farthest it may look back
+#define EXPORT_MAX_MATCH 258
+#define EXPORT_MAX_DISTANCE 32768
+
+// Codes of the LZW dictionary of a GIF
+#define EXPORT_LZW_CODES 4096
+
+// Colors of dead and live Cells, then two unused entries as a GIF palette needs 4 at least
+static const unsigned char exportPalette[4][3] = {{0, 0, 0}, {0, 205, 0}, {0, 0, 0}, {0, 0, 0}};
+
+/* ---------------------- Data Structures of the Exporter -------------------- */
+// Enum for the states of a frame of the ring.
+enum ExportState
+{
+    EXPORT_FREE = 0,
+    EXPORT_FILLED = 1,
+    EXPORT_ENCODING = 2,
+    EXPORT_ENCODED = 3
+};
+typedef enum ExportState ExportState;
+
+// Growing buffer of bytes, an encoded image or a part of it.
+struct ExportBuffer
+{
+    unsigned char *data;
+    size_t size;
+    size_t capacity;
+    int failed;
+};
+typedef struct ExportBuffer ExportBuffer;
+
+// Writer of codes into a buffer, least significant bit first (deflate and LZW both pack codes this way).
+struct ExportBits
+{
+    ExportBuffer *buffer;
+    unsigned long bits;
+    int count;
+};
+typedef struct ExportBits ExportBits;
+
+// A frame: a copy of the board, then its encoded GIF image until it is written in order.
+struct ExportFrame
+{
+    ExportState state;
+    long generation;
+    unsigned char *cells;
+    ExportBuffer encoded;
+};
+typedef struct ExportFrame ExportFrame;
+
+struct Exporter
+{
+    char *fileName;
+    int HEIGHT;
+    int WIDTH;
+    ExportOptions options;
+    int imageHeight;
+    int imageWidth;
+    FILE *gif;
+
+    // Frame k of the export lives in slot k % slots
+    ExportFrame *frames;
+    int slots;
+    long submitted;
+    long taken;
+    long written;
+
+    int finishing;
+    int failed;
+    pthread_mutex_t lock;
+    pthread_cond_t filled;
+    pthread_cond_t freed;
+    pthread_t *encoders;
+};
+
+/* --------------------------- Utilities of Buffers -------------------------- */
+// Make room in a buffer for more bytes, remembering if memory ran out
+//    Param: (ExportBuffer*) buffer (The buffer)
+//           (size_t) size (Number of bytes to make room for)
+//    Return: (int) 1 if there is room, 0 otherwise
+static int exportReserve(ExportBuffer *buffer, size_t size)
+{
+    if (buffer->size + size <= buffer->capacity)
+    {
+        return 1;
+    }
+
+    size_t capacity = buffer->capacity > 0 ? buffer->capacity : 4096;
+    while (capacity < buffer->size + size)
+    {
+        capacity *= 2;
+    }
+
+    unsigned char *data = (unsigned char *)realloc(buffer->data, capacity);
+    if (data == NULL)
+    {
+        buffer->failed = 1;
+        return 0;
+    }
+    buffer->data = data;
+    buffer->capacity = capacity;
+    return 1;
+}
+
+// Append bytes to a buffer
+//    Param: (ExportBuffer*) buffer (The buffer)
+//           (void*) bytes (The bytes, not in the buffer itself as it may move)
+//           (size_t) size (Number of bytes)
+static void exportPut(ExportBuffer *buffer, const void *bytes, size_t size)
+{
+    if (size == 0 || !exportReserve(buffer, size))
+    {
+        return;
+    }
+
+    memcpy(buffer->data + buffer->size, bytes, size);
+    buffer->size += size;
+}
+
+// Append a byte to a buffer
+//    Param: (ExportBuffer*) buffer (The buffer)
+//           (int) byte (The byte)
+static void exportPutByte(ExportBuffer *buffer, int byte)
+{
+    unsigned char value = (unsigned char)byte;
+    exportPut(buffer, &value, 1);
+}
+
+// Append a 32-bit number, most significant byte first (PNG)
+//    Param: (ExportBuffer*) buffer (The buffer)
+//           (unsigned long) value (The number)
+static void exportPutBig32(ExportBuffer *buffer, unsigned long value)
+{
+    unsigned char bytes[4] = {(unsigned char)(value >> 24), (unsigned char)(value >> 16), (unsigned char)(value >> 8), (unsigned char)value};
+    exportPut(buffer, bytes, 4);
+}
+
+// Append a 16-bit number, least significant byte first (GIF)
+//    Param: (ExportBuffer*) buffer (The buffer)
+//           (int) value (The number)
+static void exportPutLittle16(ExportBuffer *buffer, int value)
+{
+    unsigned char bytes[2] = {(unsigned char)value, (unsigned char)(value >> 8)};
+    exportPut(buffer, bytes, 2);
+}
+
+// Write a number of bits of a code
+//    Param: (ExportBits*) bits (The writer)
+//           (unsigned int) value (The code)
+//           (int) count (Number of bits of the code)
+static void exportBits(ExportBits *bits, unsigned int value, int count)
+{
+    bits->bits |= (unsigned long)value << bits->count;
+    bits->count += count;
+    while (bits->count >= 8)
+    {
+        exportPutByte(bits->buffer, (int)(bits->bits & 0xFF));
+        bits->bits >>= 8;
+        bits->count -= 8;
+    }
+}
+
+// Write the bits left over, padded to a whole byte
+//    Param: (ExportBits*) bits (The writer)
+static void exportBitsFlush(ExportBits *bits)
+{
+    if (bits->count > 0)
+    {
+        exportPutByte(bits->buffer, (int)(bits->bits & 0xFF));
+    }
+    bits->bits = 0;
+    bits->count = 0;
+}
+
+/* ------------------------------- PNG Encoder ------------------------------- */
+// Checksum of PNG chunks
+static unsigned long exportCrcTable[256];
+static pthread_once_t exportCrcOnce = PTHREAD_ONCE_INIT;
+
+// Fill the table of the checksum of PNG chunks
+static void exportCrcInit()
+{
+    for (unsigned long n = 0; n < 256; n++)
+    {
+        unsigned long c = n;
+        for (int k = 0; k < 8; k++)
+        {
+            c = c & 1 ? 0xEDB88320UL ^ (c >> 1) : c >> 1;
+        }
+        exportCrcTable[n] = c;
+    }
+}
+
+// Checksum of bytes, as PNG chunks end with
+//    Param: (unsigned char*) bytes (The bytes)
+//           (size_t) size (Number of bytes)
+//    Return: (unsigned long) The checksum
+static unsigned long exportCrc(const unsigned char *bytes, size_t size)
+{
+    unsigned long c = 0xFFFFFFFFUL;
+    for (size_t i = 0; i < size; i++)
+    {
+        c = exportCrcTable[(c ^ bytes[i]) & 0xFF] ^ (c >> 8);
+    }
+    return c ^ 0xFFFFFFFFUL;
+}
+
+// Append a PNG chunk
+//    Param: (ExportBuffer*) buffer (The PNG)
+//           (string) type (Type of the chunk, 4 letters)
+//           (unsigned char*) data (Data of the chunk)
+//           (size_t) size (Number of bytes of data)
+static void exportPngChunk(ExportBuffer *buffer, const char *type, const unsigned char *data, size_t size)
+{
+    exportPutBig32(buffer, size);
+    size_t start = buffer->size;
+    exportPut(buffer, type, 4);
+    exportPut(buffer, data, size);
+    exportPutBig32(buffer, buffer->failed ? 0 : exportCrc(buffer->data + start, size + 4));
+}
+
+// Write a deflate code of the fixed Huffman table
+//    Param: (ExportBits*) bits (The writer)
+//           (int) symbol (Literal byte, 256 for the end of the block or a length code from 257)
+static void exportDeflateSymbol(ExportBits *bits, int symbol)
+{
+    int code, length;
+    if (symbol < 144)
+    {
+        code = 0x30 + symbol, length = 8;
+    }
+    else if (symbol < 256)
+    {
+        code = 0x190 + symbol - 144, length = 9;
+    }
+    else if (symbol < 280)
+    {
+        code = symbol - 256, length = 7;
+    }
+    else
+    {
+        code = 0xC0 + symbol - 280, length = 8;
+    }
+
+    // Huffman codes go out most significant bit first
+    unsigned int reversed = 0;
+    for (int k = 0; k < length; k++)
+    {
+        reversed |= ((code >> k) & 1) << (length - 1 - k);
+    }
+    exportBits(bits, reversed, length);
+}
+
+// Write a match of the deflate format: its length, then how far back it starts
+//    Param: (ExportBits*) bits (The writer)
+//           (int) length (Length of the match, 3 to 258)
+//           (int) distance (Distance of the match, 1 to 32768)
+static void exportDeflateMatch(ExportBits *bits, int length, int distance)
+{
+    static const int lengthBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    static const int lengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+    static const int distanceBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+    static const int distanceExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+    int l = 28;
+    while (lengthBase[l] > length)
+    {
+        l--;
+    }
+    exportDeflateSymbol(bits, 257 + l);
+    exportBits(bits, length - lengthBase[l], lengthExtra[l]);
+
+    int d = 29;
+    while (distanceBase[d] > distance)
+    {
+        d--;
+    }
+    unsigned int reversed = 0;
+    for (int k = 0; k < 5; k++)
+    {
+        reversed |= ((d >> k) & 1) << (4 - k);
+    }
+    exportBits(bits, reversed, 5);
+    exportBits(bits, distance - distanceBase[d], distanceExtra[d]);
+}
+
+// Compress bytes into a zlib stream of one deflate block with the fixed Huffman table
+// Images of Cells repeat a lot: every pixel row repeats the row above it scale times, and runs
+// of dead or live Cells repeat a byte, so only those two distances are looked at for matches
+//    Param: (ExportBuffer*) buffer (Receives the stream)
+//           (unsigned char*) data (The bytes)
+//           (size_t) size (Number of bytes)
+//           (size_t) rowBytes (Distance to the same byte of the row above)
+static void exportDeflate(ExportBuffer *buffer, const unsigned char *data, size_t size, size_t rowBytes)
+{
+    ExportBits bits = {.buffer = buffer};
+
+    exportPutByte(buffer, 0x78);
+    exportPutByte(buffer, 0x01);
+    exportBits(&bits, 1, 1);
+    exportBits(&bits, 1, 2);
+
+    size_t position = 0;
+    while (position < size)
+    {
+        size_t limit = size - position < EXPORT_MAX_MATCH ? size - position : EXPORT_MAX_MATCH;
+        size_t best = 0, bestDistance = 0;
+        size_t distances[2] = {rowBytes, 1};
+
+        for (int k = 0; k < 2; k++)
+        {
+            size_t distance = distances[k];
+            if (distance > position || distance > EXPORT_MAX_DISTANCE)
+            {
+                continue;
+            }
+            size_t length = 0;
+            while (length < limit && data[position + length] == data[position + length - distance])
+            {
+                length++;
+            }
+            if (length > best)
+            {
+                best = length, bestDistance = distance;
+            }
+        }
+
+        if (best >= 3)
+        {
+            exportDeflateMatch(&bits, (int)best, (int)bestDistance);
+            position += best;
+        }
+        else
+        {
+            exportDeflateSymbol(&bits, data[position]);
+            position++;
+        }
+    }
+    exportDeflateSymbol(&bits, 256);
+    exportBitsFlush(&bits);
+
+    unsigned long a = 1, b = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        a = (a + data[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    exportPutBig32(buffer, (b << 16) | a);
+}
+
+// Encode a board as a PNG of one bit per pixel with a palette
+//    Param: (Exporter*) exporter (The exporter)
+//           (unsigned char*) cells (The board, one byte per Cell)
+//           (ExportBuffer*) raw (Scratch buffer for the rows of pixels)
+//           (ExportBuffer*) out (Receives the PNG)
+static void exportPng(Exporter *exporter, const unsigned char *cells, ExportBuffer *raw, ExportBuffer *out)
+{
+    int scale = exporter->options.scale;
+    size_t rowBytes = 1 + ((size_t)exporter->imageWidth + 7) / 8;
+    unsigned char *row = (unsigned char *)calloc(rowBytes, 1);
+    if (row == NULL)
+    {
+        out->failed = 1;
+        return;
+    }
+
+    // Every pixel row starts with filter type 0 (none)
+    raw->size = 0;
+    for (int i = 0; i < exporter->HEIGHT; i++)
+    {
+        memset(row, 0, rowBytes);
+        for (int x = 0; x < exporter->imageWidth; x++)
+        {
+            if (cells[(size_t)i * exporter->WIDTH + x / scale])
+            {
+                row[1 + x / 8] |= 0x80 >> (x % 8);
+            }
+        }
+        for (int k = 0; k < scale; k++)
+        {
+            exportPut(raw, row, rowBytes);
+        }
+    }
+    free(row);
+
+    unsigned char header[13];
+    unsigned long width = exporter->imageWidth, height = exporter->imageHeight;
+    for (int k = 0; k < 4; k++)
+    {
+        header[k] = (unsigned char)(width >> (24 - 8 * k));
+        header[4 + k] = (unsigned char)(height >> (24 - 8 * k));
+    }
+    header[8] = 1;
+    header[9] = 3;
+    header[10] = header[11] = header[12] = 0;
+
+    static const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    out->size = 0;
+    exportPut(out, signature, 8);
+    exportPngChunk(out, "IHDR", header, 13);
+    exportPngChunk(out, "PLTE", &exportPalette[0][0], 6);
+
+    // The chunk is written around the stream once it is compressed
+    size_t lengthAt = out->size;
+    exportPutBig32(out, 0);
+    exportPut(out, "IDAT", 4);
+    exportDeflate(out, raw->data, raw->failed ? 0 : raw->size, rowBytes);
+    if (!out->failed)
+    {
+        size_t length = out->size - lengthAt - 8;
+        for (int k = 0; k < 4; k++)
+        {
+            out->data[lengthAt + k] = (unsigned char)(length >> (24 - 8 * k));
+        }
+        exportPutBig32(out, exportCrc(out->data + lengthAt + 4, length + 4));
+    }
+    exportPngChunk(out, "IEND", NULL, 0);
+    out->failed |= raw->failed;
+}
+
+/* ------------------------------- PPM Encoder ------------------------------- */
+// Encode a board as a binary PPM
+//    Param: (Exporter*) exporter (The exporter)
+//           (unsigned char*) cells (The board, one byte per Cell)
+//           (ExportBuffer*) out (Receives the PPM)
+static void exportPpm(Exporter *exporter, const unsigned char *cells, ExportBuffer *out)
+{
+    int scale = exporter->options.scale;
+    char header[64];
+    int length = snprintf(header, sizeof(header), "P6\n%d %d\n255\n", exporter->imageWidth, exporter->imageHeight);
+
+    out->size = 0;
+    size_t rowSize = (size_t)exporter->imageWidth * 3;
+    if (!exportReserve(out, length + rowSize * exporter->imageHeight))
+    {
+        return;
+    }
+
+    exportPut(out, header, length);
+    for (int i = 0; i < exporter->HEIGHT; i++)
+    {
+        // The first pixel row of a row of Cells is drawn, the others repeat it (the buffer no longer moves)
+        unsigned char *row = out->data + out->size;
+        for (int x = 0; x < exporter->imageWidth; x++)
+        {
+            exportPut(out, exportPalette[cells[(size_t)i * exporter->WIDTH + x / scale]], 3);
+        }
+        for (int k = 1; k < scale; k++)
+        {
+            exportPut(out, row, rowSize);
+        }
+    }
+}
+
+/* ------------------------------- GIF Encoder ------------------------------- */
+// Encode a board as one image of an animated GIF: its control extension, its descriptor and its LZW data
+//    Param: (Exporter*) exporter (The exporter)
+//           (unsigned char*) cells (The board, one byte per Cell)
+//           (short*) dictionary (Scratch LZW dictionary, EXPORT_LZW_CODES * 4 entries)
+//           (ExportBuffer*) lzw (Scratch buffer for the LZW codes)
+//           (ExportBuffer*) out (Receives the image)
+static void exportGifFrame(Exporter *exporter, const unsigned char *cells, short *dictionary, ExportBuffer *lzw, ExportBuffer *out)
+{
+    int scale = exporter->options.scale;
+
+    out->size = 0;
+    static const unsigned char control[4] = {0x21, 0xF9, 0x04, 0x00};
+    exportPut(out, control, 4);
+    exportPutLittle16(out, exporter->options.delay);
+    exportPutByte(out, 0);
+    exportPutByte(out, 0);
+
+    exportPutByte(out, 0x2C);
+    exportPutLittle16(out, 0);
+    exportPutLittle16(out, 0);
+    exportPutLittle16(out, exporter->imageWidth);
+    exportPutLittle16(out, exporter->imageHeight);
+    exportPutByte(out, 0);
+
+    // LZW over a 4 colour alphabet: codes 0-3 are the colours, 4 clears the dictionary and 5 ends the image
+    const int clear = 4, end = 5;
+    ExportBits bits = {.buffer = lzw};
+    lzw->size = 0;
+
+    int codeSize = 3;
+    int next = end + 1;
+    int prefix = -1;
+    memset(dictionary, 0xFF, EXPORT_LZW_CODES * 4 * sizeof(short));
+    exportBits(&bits, clear, codeSize);
+
+    for (int y = 0; y < exporter->imageHeight; y++)
+    {
+        const unsigned char *row = cells + (size_t)(y / scale) * exporter->WIDTH;
+        for (int x = 0; x < exporter->imageWidth; x++)
+        {
+            int pixel = row[x / scale];
+            if (prefix < 0)
+            {
+                prefix = pixel;
+                continue;
+            }
+
+            int code = dictionary[prefix * 4 + pixel];
+            if (code >= 0)
+            {
+                prefix = code;
+                continue;
+            }
+
+            exportBits(&bits, prefix, codeSize);
+            if (next < EXPORT_LZW_CODES)
+            {
+                if (next == 1 << codeSize)
+                {
+                    codeSize++;
+                }
+                dictionary[prefix * 4 + pixel] = (short)next++;
+            }
+            else
+            {
+                // The dictionary is full: start a new one
+                exportBits(&bits, clear, codeSize);
+                memset(dictionary, 0xFF, EXPORT_LZW_CODES * 4 * sizeof(short));
+                codeSize = 3;
+                next = end + 1;
+            }
+            prefix = pixel;
+        }
+    }
+    exportBits(&bits, prefix, codeSize);
+    exportBits(&bits, end, codeSize);
+    exportBitsFlush(&bits);
+
+    // Minimum code size, then the codes in sub-blocks of up to 255 bytes
+    exportPutByte(out, 2);
+    for (size_t offset = 0; offset < lzw->size; offset += 255)
+    {
+        size_t length = lzw->size - offset < 255 ? lzw->size - offset : 255;
+        exportPutByte(out, (int)length);
+        exportPut(out, lzw->data + offset, length);
+    }
+    exportPutByte(out, 0);
+    out->failed |= lzw->failed;
+}
+
+// Write the header of an animated GIF: screen, palette and endless looping
+//    Param: (Exporter*) exporter (The exporter)
+//    Return: (int) 0 on success, -1 if the file could not be written
+static int exportGifHeader(Exporter *exporter)
+{
+    ExportBuffer header = {0};
+
+    exportPut(&header, "GIF89a", 6);
+    exportPutLittle16(&header, exporter->imageWidth);
+    exportPutLittle16(&header, exporter->imageHeight);
+    exportPutByte(&header, 0x91);
+    exportPutByte(&header, 0);
+    exportPutByte(&header, 0);
+    exportPut(&header, exportPalette, sizeof(exportPalette));
+
+    static const unsigned char loop[19] = {0x21, 0xFF, 0x0B, 'N', 'E', 'T', 'S', 'C', 'A', 'P', 'E', '2', '.', '0', 0x03, 0x01, 0x00, 0x00, 0x00};
+    exportPut(&header, loop, sizeof(loop));
+
+    int written = !header.failed && fwrite(header.data, 1, header.size, exporter->gif) == header.size;
+    free(header.data);
+    return written ? 0 : -1;
+}
+
+/* ------------------------------ Encoder Threads ---------------------------- */
+// Write an encoded PPM or PNG frame to its own file, numbered by generation
+//    Param: (Exporter*) exporter (The exporter)
+//           (long) generation (Generation of the frame)
+//           (ExportBuffer*) image (The encoded frame)
+//    Return: (int) 0 on success, -1 if the file could not be written
+static int exportWriteFrame(Exporter *exporter, long generation, ExportBuffer *image)
+{
+    // life.png gives life_000042.png
+    char *dot = strrchr(exporter->fileName, '.');
+    int base = (int)(dot != NULL ? dot - exporter->fileName : (long)strlen(exporter->fileName));
+    size_t size = strlen(exporter->fileName) + 32;
+    char *name = (char *)malloc(size);
+    if (name == NULL || image->failed)
+    {
+        free(name);
+        return -1;
+    }
+    snprintf(name, size, "%.*s_%06ld%s", base, exporter->fileName, generation, dot != NULL ? dot : "");
+
+    FILE *file = fopen(name, "wb");
+    free(name);
+    if (file == NULL)
+    {
+        return -1;
+    }
+    int written = fwrite(image->data, 1, image->size, file) == image->size;
+    return fclose(file) == 0 && written ? 0 : -1;
+}
+
+// Body of an encoder thread: take the oldest board not taken yet, encode it, write it
+//    Param: (void*) argument (The Exporter)
+static void *exportEncoderThread(void *argument)
+{
+    Exporter *exporter = (Exporter *)argument;
+    ExportBuffer image = {0}, scratch = {0};
+    short *dictionary = exporter->options.format == EXPORT_GIF ? (short *)malloc(EXPORT_LZW_CODES * 4 * sizeof(short)) : NULL;
+
+    pthread_mutex_lock(&exporter->lock);
+    while (1)
+    {
+        while (exporter->taken == exporter->submitted && !exporter->finishing)
+        {
+            pthread_cond_wait(&exporter->filled, &exporter->lock);
+        }
+        if (exporter->taken == exporter->submitted)
+        {
+            break;
+        }
+
+        ExportFrame *frame = &exporter->frames[exporter->taken % exporter->slots];
+        exporter->taken++;
+        frame->state = EXPORT_ENCODING;
+        pthread_mutex_unlock(&exporter->lock);
+
+        int failed = 0;
+        switch (exporter->options.format)
+        {
+        case EXPORT_GIF:
+            if (dictionary == NULL)
+            {
+                frame->encoded.failed = 1;
+                break;
+            }
+            exportGifFrame(exporter, frame->cells, dictionary, &scratch, &frame->encoded);
+            break;
+        case EXPORT_PNG:
+            exportPng(exporter, frame->cells, &scratch, &image);
+            failed = exportWriteFrame(exporter, frame->generation, &image) != 0;
+            break;
+        default:
+            exportPpm(exporter, frame->cells, &image);
+            failed = exportWriteFrame(exporter, frame->generation, &image) != 0;
+            break;
+        }
+
+        pthread_mutex_lock(&exporter->lock);
+        exporter->failed |= failed;
+        if (exporter->options.format == EXPORT_GIF)
+        {
+            // Images of a GIF go into the file in order, by whichever thread finishes the oldest one
+            frame->state = EXPORT_ENCODED;
+            while (exporter->written < exporter->taken && exporter->frames[exporter->written % exporter->slots].state == EXPORT_ENCODED)
+            {
+                ExportFrame *oldest = &exporter->frames[exporter->written % exporter->slots];
+                if (oldest->encoded.failed || fwrite(oldest->encoded.data, 1, oldest->encoded.size, exporter->gif) != oldest->encoded.size)
+                {
+                    exporter->failed = 1;
+                }
+                oldest->encoded.failed = 0;
+                oldest->state = EXPORT_FREE;
+                exporter->written++;
+            }
+        }
+        else
+        {
+            frame->state = EXPORT_FREE;
+            exporter->written++;
+        }
+        pthread_cond_broadcast(&exporter->freed);
+    }
+    pthread_mutex_unlock(&exporter->lock);
+
+    free(image.data);
+    free(scratch.data);
+    free(dictionary);
+    return NULL;
+}
+
+/* ------------------------------- Exporter API ------------------------------ */
+void exportDefaultOptions(ExportOptions *options)
+{
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+
+    options->format = EXPORT_GIF;
+    options->scale = EXPORT_DEFAULT_SCALE;
+    options->threads = cores > 0 ? (int)cores : 1;
+    options->delay = EXPORT_DEFAULT_DELAY;
+}
+
+ExportFormat exportFormatOf(char *fileName)
+{
+    char *dot = strrchr(fileName, '.');
+    if (dot == NULL)
+    {
+        return 0;
+    }
+    if (strcmp(dot, ".ppm") == 0)
+    {
+        return EXPORT_PPM;
+    }
+    if (strcmp(dot, ".png") == 0)
+    {
+        return EXPORT_PNG;
+    }
+    if (strcmp(dot, ".gif") == 0)
+    {
+        return EXPORT_GIF;
+    }
+    return 0;
+}
+
+Exporter *exporterCreate(char *fileName, int HEIGHT, int WIDTH, ExportOptions *options)
+{
+    // The image must fit the 16-bit sizes of a GIF and the ints of the encoders
+    if (options->scale < 1 || (long)HEIGHT * options->scale > 65535 || (long)WIDTH * options->scale > 65535)
+    {
+        return NULL;
+    }
+
+    Exporter *exporter = (Exporter *)calloc(1, sizeof(Exporter));
+    if (exporter == NULL)
+    {
+        return NULL;
+    }
+
+    pthread_once(&exportCrcOnce, exportCrcInit);
+
+    exporter->HEIGHT = HEIGHT;
+    exporter->WIDTH = WIDTH;
+    exporter->options = *options;
+    exporter->options.threads = options->threads > 0 ? options->threads : 1;
+    exporter->imageHeight = HEIGHT * options->scale;
+    exporter->imageWidth = WIDTH * options->scale;
+    exporter->slots = exporter->options.threads * EXPORT_SLOTS_PER_THREAD;
+
+    exporter->fileName = (char *)malloc(strlen(fileName) + 1);
+    exporter->frames = (ExportFrame *)calloc(exporter->slots, sizeof(ExportFrame));
+    exporter->encoders = (pthread_t *)calloc(exporter->options.threads, sizeof(pthread_t));
+    int ready = exporter->fileName != NULL && exporter->frames != NULL && exporter->encoders != NULL;
+    for (int k = 0; ready && k < exporter->slots; k++)
+    {
+        exporter->frames[k].cells = (unsigned char *)malloc((size_t)HEIGHT * WIDTH);
+        ready = exporter->frames[k].cells != NULL;
+    }
+    if (ready)
+    {
+        strcpy(exporter->fileName, fileName);
+    }
+    if (ready && options->format == EXPORT_GIF)
+    {
+        exporter->gif = fopen(fileName, "wb");
+        ready = exporter->gif != NULL && exportGifHeader(exporter) == 0;
+    }
+
+    if (ready)
+    {
+        pthread_mutex_init(&exporter->lock, NULL);
+        pthread_cond_init(&exporter->filled, NULL);
+        pthread_cond_init(&exporter->freed, NULL);
+
+        // Fewer encoders than asked for only make the export slower, without any the frames are never written
+        int created = 0;
+        while (created < exporter->options.threads && pthread_create(&exporter->encoders[created], NULL, exportEncoderThread, exporter) == 0)
+        {
+            created++;
+        }
+        exporter->options.threads = created;
+        if (created == 0)
+        {
+            pthread_mutex_destroy(&exporter->lock);
+            pthread_cond_destroy(&exporter->filled);
+            pthread_cond_destroy(&exporter->freed);
+            ready = 0;
+        }
+    }
+
+    if (!ready)
+    {
+        if (exporter->gif != NULL)
+        {
+            fclose(exporter->gif);
+        }
+        for (int k = 0; exporter->frames != NULL && k < exporter->slots; k++)
+        {
+            free(exporter->frames[k].cells);
+        }
+        free(exporter->frames);
+        free(exporter->encoders);
+        free(exporter->fileName);
+        free(exporter);
+        return NULL;
+    }
+
+    return exporter;
+}
+
+void exporterSubmit(Exporter *exporter, int **currentBoard, long generation)
+{
+    pthread_mutex_lock(&exporter->lock);
+    ExportFrame *frame = &exporter->frames[exporter->submitted % exporter->slots];
+    while (frame->state != EXPORT_FREE)
+    {
+        pthread_cond_wait(&exporter->freed, &exporter->lock);
+    }
+    pthread_mutex_unlock(&exporter->lock);
+
+    // No encoder looks at a free frame, it is filled without the lock
+    for (int i = 0; i < exporter->HEIGHT; i++)
+    {
+        for (int j = 0; j < exporter->WIDTH; j++)
+        {
+            frame->cells[(size_t)i * exporter->WIDTH + j] = currentBoard[i][j] == 1;
+        }
+    }
+    frame->generation = generation;
+
+    pthread_mutex_lock(&exporter->lock);
+    frame->state = EXPORT_FILLED;
+    exporter->submitted++;
+    pthread_cond_signal(&exporter->filled);
+    pthread_mutex_unlock(&exporter->lock);
+}
+
+long exporterFinish(Exporter *exporter)
+{
+    pthread_mutex_lock(&exporter->lock);
+    exporter->finishing = 1;
+    pthread_cond_broadcast(&exporter->filled);
+    pthread_mutex_unlock(&exporter->lock);
+
+    for (int t = 0; t < exporter->options.threads; t++)
+    {
+        pthread_join(exporter->encoders[t], NULL);
+    }
+
+    int failed = exporter->failed;
+    if (exporter->gif != NULL)
+    {
+        failed |= fputc(0x3B, exporter->gif) == EOF;
+        failed |= fclose(exporter->gif) != 0;
+    }
+    long written = exporter->written;
+
+    pthread_mutex_destroy(&exporter->lock);
+    pthread_cond_destroy(&exporter->filled);
+    pthread_cond_destroy(&exporter->freed);
+    for (int k = 0; k < exporter->slots; k++)
+    {
+        free(exporter->frames[k].cells);
+        free(exporter->frames[k].encoded.data);
+    }
+    free(exporter->frames);
+    free(exporter->encoders);
+    free(exporter->fileName);
+    free(exporter);
+
+    return failed ? -1 : written;
+}
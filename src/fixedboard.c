@@ -0,0 +1,142 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <fixedboard.h>
+
+/* -------------------------------------------------------------------------- */
+/*       Engines specialised for small boards of a size fixed at compile time   */
+/* -------------------------------------------------------------------------- */
+
+/* ------------------------- Utilities of the Kernels ------------------------ */
+// Account a row of bit Cells before and after a generation
+//    Param: (GenerationStats*) stats (The statistics)
+//           (uint64_t) before (Cells of the row before the generation, bit j is column j)
+//           (uint64_t) after (Cells of the row after the generation)
+//           (int) row (Row on the board)
+static void fixedBoardAccount(GenerationStats *stats, uint64_t before, uint64_t after, int row)
+{
+    stats->population += __builtin_popcountll(after);
+    stats->births += __builtin_popcountll(after & ~before);
+    stats->deaths += __builtin_popcountll(before & ~after);
+
+    if (after != 0)
+    {
+        statsIncludeRun(stats, row, __builtin_ctzll(after), 63 - __builtin_clzll(after));
+    }
+}
+
+// Next state of a row from its Cells and the Cells above and below, for every bit at once
+// The eight neighbours are added with bitwise adders: ones, twos and "four or more"
+// Cells shifted past the ends of the word fall off, matching the dead edge of the board
+//    Param: (WORD) up (Row above, 0 on the first row)
+//           (WORD) row (The row)
+//           (WORD) down (Row below, 0 on the last row)
+//    Return: (WORD) The row after one generation
+#define FIXEDBOARD_NEXT_ROW(WORD, up, row, down)                                         \
+    ({                                                                                   \
+        WORD upLeft = (up) << 1, upRight = (up) >> 1;                                    \
+        WORD left = (row) << 1, right = (row) >> 1;                                      \
+        WORD downLeft = (down) << 1, downRight = (down) >> 1;                            \
+                                                                                         \
+        /* Sum of each row of three (two for the middle row), as a ones and a twos bit */ \
+        WORD upOnes = upLeft ^ (up) ^ upRight;                                           \
+        WORD upTwos = (upLeft & (up)) | (upRight & (upLeft ^ (up)));                     \
+        WORD midOnes = left ^ right;                                                     \
+        WORD midTwos = left & right;                                                     \
+        WORD downOnes = downLeft ^ (down) ^ downRight;                                   \
+        WORD downTwos = (downLeft & (down)) | (downRight & (downLeft ^ (down)));         \
+                                                                                         \
+        /* Add the three rows: ones, then twos with the carry of the ones */             \
+        WORD ones = upOnes ^ midOnes ^ downOnes;                                         \
+        WORD carry = (upOnes & midOnes) | (downOnes & (upOnes ^ midOnes));               \
+        WORD twosSum = upTwos ^ midTwos ^ downTwos;                                      \
+        WORD twosCarry = (upTwos & midTwos) | (downTwos & (upTwos ^ midTwos));           \
+        WORD twos = twosSum ^ carry;                                                     \
+        WORD fours = twosCarry | (twosSum & carry);                                      \
+                                                                                         \
+        /* Alive with exactly 3 neighbours, or with 2 if it was alive */                 \
+        (WORD)(twos & ~fours & (ones | (row)));                                          \
+    })
+
+// Define the kernel of one board size: fixedBoardStep<SIDE>
+// The row loop has constant bounds and is fully unrolled, the board never leaves the stack
+//    Param: (int) SIDE (HEIGHT and WIDTH of the board, at most the bits in a WORD)
+//           (type) WORD (Unsigned integer holding one row)
+#define FIXEDBOARD_DEFINE(SIDE, WORD)                                                       \
+    static void fixedBoardStep##SIDE(int generations, int **currentBoard, int **nextBoard, StatsRecorder *recorder) \
+    {                                                                                       \
+        WORD cells[SIDE];                                                                   \
+        WORD next[SIDE];                                                                    \
+                                                                                            \
+        for (int i = 0; i < SIDE; i++)                                                      \
+        {                                                                                   \
+            WORD row = 0;                                                                   \
+            for (int j = 0; j < SIDE; j++)                                                  \
+            {                                                                               \
+                row |= (WORD)(currentBoard[i][j] == 1) << j;                                \
+            }                                                                               \
+            cells[i] = row;                                                                 \
+        }                                                                                   \
+                                                                                            \
+        for (int g = 0; g < generations; g++)                                               \
+        {                                                                                   \
+            _Pragma("GCC unroll 64") for (int i = 0; i < SIDE; i++)                         \
+            {                                                                               \
+                WORD up = i > 0 ? cells[i - 1] : 0;                                         \
+                WORD down = i < SIDE - 1 ? cells[i + 1] : 0;                                \
+                next[i] = FIXEDBOARD_NEXT_ROW(WORD, up, cells[i], down);                    \
+            }                                                                               \
+                                                                                            \
+            if (recorder != NULL)                                                           \
+            {                                                                               \
+                GenerationStats stats;                                                      \
+                statsReset(&stats, 0);                                                      \
+                for (int i = 0; i < SIDE; i++)                                              \
+                {                                                                           \
+                    fixedBoardAccount(&stats, cells[i], next[i], i);                        \
+                }                                                                           \
+                statsRecord(recorder, &stats);                                              \
+            }                                                                               \
+                                                                                            \
+            _Pragma("GCC unroll 64") for (int i = 0; i < SIDE; i++)                         \
+            {                                                                               \
+                cells[i] = next[i];                                                         \
+            }                                                                               \
+        }                                                                                   \
+                                                                                            \
+        /* Both boards end up equal, like after calculateNextBoard */                       \
+        for (int i = 0; i < SIDE; i++)                                                      \
+        {                                                                                   \
+            for (int j = 0; j < SIDE; j++)                                                  \
+            {                                                                               \
+                currentBoard[i][j] = nextBoard[i][j] = (cells[i] >> j) & 1;                 \
+            }                                                                               \
+        }                                                                                   \
+    }
+
+/* --------------------------------- Kernels --------------------------------- */
+FIXEDBOARD_DEFINE(32, uint32_t)
+FIXEDBOARD_DEFINE(64, uint64_t)
+
+/* ------------------------------ Fixed Board API ---------------------------- */
+int fixedBoardSupports(int HEIGHT, int WIDTH)
+{
+    return HEIGHT == WIDTH && (HEIGHT == FIXEDBOARD_SMALL || HEIGHT == FIXEDBOARD_LARGE);
+}
+
+int fixedBoardStep(int HEIGHT, int WIDTH, int generations, int **currentBoard, int **nextBoard, StatsRecorder *recorder)
+{
+    if (!fixedBoardSupports(HEIGHT, WIDTH))
+    {
+        return 0;
+    }
+
+    if (HEIGHT == FIXEDBOARD_SMALL)
+    {
+        fixedBoardStep32(generations, currentBoard, nextBoard, recorder);
+    }
+    else
+    {
+        fixedBoardStep64(generations, currentBoard, nextBoard, recorder);
+    }
+    return 1;
+}
@@ -0,0 +1,729 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <growboard.h>
+
+/* -------------------------------------------------------------------------- */
+/*       Board growing past its edges as live Cells come near them            */
+/* -------------------------------------------------------------------------- */
+
+// Dead Cells kept in memory past every edge of the extent, so the Cells around it are read without bounds checks
+#define GROW_PAD 2
+
+// Dead rows or columns kept past the live Cells when the extent moves back in, and twice that before it does
+#define GROW_SLACK 32
+
+// Memory is given back once it is this many times what the extent needs along a side
+#define GROW_SHRINK 4
+
+// Fewest bytes of the spare memory zeroed in a generation, a page
+#define GROW_PREPARE_BYTES 4096
+
+/* -------------------- Data Structures of the Growing Board ------------------ */
+// Memory behind the extent: two boards of byte Cells carved from one arena, the current
+// generation and the next, covering height rows and width columns of the plane from (top, left).
+struct GrowMemory
+{
+    Arena *arena;
+    unsigned char *cells[2];
+    size_t stride;
+    int top;
+    int left;
+    int height;
+    int width;
+};
+typedef struct GrowMemory GrowMemory;
+
+struct GrowBoard
+{
+    // The window, at rows 0 to HEIGHT - 1 and columns 0 to WIDTH - 1 of the plane
+    int HEIGHT;
+    int WIDTH;
+    int limitHeight;
+    int limitWidth;
+    ArenaPages pages;
+
+    GrowMemory memory;
+    int current;
+
+    // Spare memory for the next move, zeroed up to spareReady bytes, and the memory the last move gave up
+    Arena *spare;
+    size_t spareReady;
+    Arena *retired;
+
+    // Extent on the plane, inclusive: it holds the window and every live Cell, and both boards are dead outside of it
+    int top;
+    int left;
+    int bottom;
+    int right;
+
+    // Live Cells of the plane and their bounding box
+    long population;
+    int boxTop;
+    int boxLeft;
+    int boxBottom;
+    int boxRight;
+
+    // For the report
+    long generations;
+    double cells;
+    double seconds;
+    long moves;
+    long spareMoves;
+    double moveSeconds;
+    int largestHeight;
+    int largestWidth;
+};
+
+/* ----------------------- Utilities of the Growing Board --------------------- */
+// Current time, for the cost of the generations
+//    Return: (double) Seconds since an arbitrary point in the past
+static double growClock()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// Row of a board in memory, indexed by the columns of the plane
+//    Param: (GrowMemory*) memory (The memory)
+//           (int) buffer (Which of the two boards)
+//           (int) row (Row of the plane, within the memory)
+//    Return: (unsigned char*) The row, Cell c of the plane being row[c]
+static inline unsigned char *growRow(GrowMemory *memory, int buffer, int row)
+{
+    return memory->cells[buffer] + (size_t)(row - memory->top) * memory->stride - memory->left;
+}
+
+// Bytes of one board of memory covering a number of columns, rows padded to whole cache lines
+//    Param: (int) width (Columns covered)
+//    Return: (size_t) Bytes per row
+static size_t growStride(int width)
+{
+    return ((size_t)width + ARENA_CACHE_LINE - 1) / ARENA_CACHE_LINE * ARENA_CACHE_LINE;
+}
+
+// Bytes of an arena holding two boards covering part of the plane
+//    Param: (int) height (Rows covered)
+//           (int) width (Columns covered)
+//    Return: (size_t) Size in bytes
+static size_t growMemorySize(int height, int width)
+{
+    return 2 * growStride(width) * (size_t)height + ARENA_CACHE_LINE;
+}
+
+// Carve two boards covering part of the plane from an arena
+//    Param: (GrowMemory*) memory (Receives the memory)
+//           (Arena*) arena (The arena, with nothing handed out yet)
+//           (int) top (First row of the plane covered)
+//           (int) left (First column of the plane covered)
+//           (int) height (Rows covered)
+//           (int) width (Columns covered)
+//    Return: (int) 0 on success, -1 if the arena is too small
+static int growCarve(GrowMemory *memory, Arena *arena, int top, int left, int height, int width)
+{
+    size_t stride = growStride(width);
+    size_t size = stride * (size_t)height;
+    unsigned char *current = (unsigned char *)arenaAllocate(arena, size, ARENA_CACHE_LINE);
+    unsigned char *next = (unsigned char *)arenaAllocate(arena, size, ARENA_CACHE_LINE);
+    if (current == NULL || next == NULL)
+    {
+        return -1;
+    }
+
+    memory->arena = arena;
+    memory->cells[0] = current;
+    memory->cells[1] = next;
+    memory->stride = stride;
+    memory->top = top;
+    memory->left = left;
+    memory->height = height;
+    memory->width = width;
+    return 0;
+}
+
+// Map dead memory for two boards covering part of the plane
+//    Param: (GrowMemory*) memory (Receives the memory)
+//           (int) top (First row of the plane covered)
+//           (int) left (First column of the plane covered)
+//           (int) height (Rows covered)
+//           (int) width (Columns covered)
+//           (ArenaPages) pages (Pages wanted)
+//    Return: (int) 0 on success, -1 if no memory could be mapped
+static int growMap(GrowMemory *memory, int top, int left, int height, int width, ArenaPages pages)
+{
+    // Fresh mappings are dead already, and their pages cost nothing until a Cell is written there
+    Arena *arena = arenaCreate(growMemorySize(height, width), pages);
+    if (arena == NULL)
+    {
+        return -1;
+    }
+
+    growCarve(memory, arena, top, left, height, width);
+    return 0;
+}
+
+// Place the memory along one side of the plane, so that it covers a span with room to grow
+// Growing doubles the memory, with the new room on the side the span grows to; memory far
+// larger than the span shrinks to twice the span, around it
+//    Param: (int) start (First row or column the memory covers)
+//           (int) size (Rows or columns it covers)
+//           (int) first (First row or column of the span)
+//           (int) last (Last row or column of the span)
+//           (int) limit (Most rows or columns the memory may cover)
+//           (int*) newStart (Receives the first row or column to cover)
+//           (int*) newSize (Receives the rows or columns to cover)
+//    Return: (int) 1 if the memory has to move, 0 if it covers the span as it is
+static int growPlace(int start, int size, int first, int last, int limit, int *newStart, int *newSize)
+{
+    int need = last - first + 1;
+    int before = first < start;
+    int after = last > start + size - 1;
+
+    *newStart = start;
+    *newSize = size;
+    if (!before && !after && size <= GROW_SHRINK * need)
+    {
+        return 0;
+    }
+
+    int wanted = before || after ? 2 * (size > need ? size : need) : 2 * need;
+    wanted = wanted < limit ? wanted : limit;
+    wanted = wanted > need ? wanted : need;
+
+    // Memory held back by the limit starts right at the span, leaving all its room on the growing side
+    int capped = wanted < 2 * size;
+    int placed;
+    if (before && !after)
+    {
+        placed = capped ? last - wanted + 1 : start + size - wanted;
+    }
+    else if (after && !before)
+    {
+        placed = capped ? first : start;
+    }
+    else
+    {
+        placed = first - (wanted - need) / 2;
+    }
+    placed = placed > first ? first : placed;
+    placed = placed + wanted - 1 < last ? last - wanted + 1 : placed;
+
+    *newStart = placed;
+    *newSize = wanted;
+    return 1;
+}
+
+// Place the memory of a board holding only the window: twice what the window needs, around it
+//    Param: (GrowBoard*) board (The engine)
+//           (int*) top (Receives the first row to cover)
+//           (int*) left (Receives the first column to cover)
+//           (int*) height (Receives the rows to cover)
+//           (int*) width (Receives the columns to cover)
+static void growPlaceWindow(GrowBoard *board, int *top, int *left, int *height, int *width)
+{
+    growPlace(0, 0, -GROW_PAD, board->HEIGHT - 1 + GROW_PAD, board->limitHeight + 2 * GROW_PAD, top, height);
+    growPlace(0, 0, -GROW_PAD, board->WIDTH - 1 + GROW_PAD, board->limitWidth + 2 * GROW_PAD, left, width);
+}
+
+// Zeroed bytes at the start of an arena, which is handed out whole for it and taken back
+//    Param: (Arena*) arena (The arena, with nothing handed out)
+//           (size_t) from (Bytes zeroed already)
+//           (size_t) to (Bytes to be zeroed)
+static void growZero(Arena *arena, size_t from, size_t to)
+{
+    unsigned char *bytes = (unsigned char *)arenaAllocate(arena, to, ARENA_CACHE_LINE);
+    arenaReset(arena);
+    if (bytes != NULL && to > from)
+    {
+        memset(bytes + from, 0, to - from);
+    }
+}
+
+// Take new memory for a move: the spare memory when it is large enough, zeroing what its slices did not reach yet, or a new mapping
+//    Param: (GrowBoard*) board (The engine)
+//           (GrowMemory*) moved (Receives the memory)
+//           (int) top (First row of the plane covered)
+//           (int) left (First column of the plane covered)
+//           (int) height (Rows covered)
+//           (int) width (Columns covered)
+//    Return: (int) 0 on success, -1 if no memory could be mapped
+static int growMove(GrowBoard *board, GrowMemory *moved, int top, int left, int height, int width)
+{
+    size_t size = growMemorySize(height, width);
+    if (board->spare == NULL || arenaCapacity(board->spare) < size)
+    {
+        return growMap(moved, top, left, height, width, board->pages);
+    }
+
+    if (board->spareReady < size)
+    {
+        growZero(board->spare, board->spareReady, size);
+    }
+    growCarve(moved, board->spare, top, left, height, width);
+    board->spare = NULL;
+    board->spareReady = 0;
+    board->spareMoves++;
+    return 0;
+}
+
+// Prepare the spare memory by a slice: map it for memory twice the size along both sides, within the limit, and zero
+// enough of it that it is ready before the extent, growing a row or a column a generation, can reach the edge of the memory
+// The memory the last generation gave up is unmapped first
+//    Param: (GrowBoard*) board (The engine, before a generation)
+static void growPrepare(GrowBoard *board)
+{
+    GrowMemory *memory = &board->memory;
+    arenaFree(board->retired);
+    board->retired = NULL;
+
+    int height = 2 * (memory->height + 1) < board->limitHeight + 2 * GROW_PAD ? 2 * (memory->height + 1) : board->limitHeight + 2 * GROW_PAD;
+    int width = 2 * (memory->width + 1) < board->limitWidth + 2 * GROW_PAD ? 2 * (memory->width + 1) : board->limitWidth + 2 * GROW_PAD;
+    size_t size = growMemorySize(height, width);
+    if (board->spare != NULL && arenaCapacity(board->spare) < size)
+    {
+        arenaFree(board->spare);
+        board->spare = NULL;
+    }
+    if (board->spare == NULL)
+    {
+        board->spare = arenaCreate(size, board->pages);
+        board->spareReady = 0;
+    }
+    if (board->spare == NULL || board->spareReady >= size)
+    {
+        return;
+    }
+
+    // Generations before the extent can reach the edge of the memory on any side
+    int room = board->top - (memory->top + GROW_PAD);
+    int below = memory->top + memory->height - 1 - GROW_PAD - board->bottom;
+    int before = board->left - (memory->left + GROW_PAD);
+    int after = memory->left + memory->width - 1 - GROW_PAD - board->right;
+    room = below < room ? below : room;
+    room = before < room ? before : room;
+    room = after < room ? after : room;
+    room = room > 1 ? room : 1;
+
+    size_t slice = (size - board->spareReady + room - 1) / room;
+    slice = slice > GROW_PREPARE_BYTES ? slice : GROW_PREPARE_BYTES;
+    size_t ready = board->spareReady + slice < size ? board->spareReady + slice : size;
+    growZero(board->spare, board->spareReady, ready);
+    board->spareReady = ready;
+}
+
+// Count the live Cells of the extent and find their bounding box
+//    Param: (GrowBoard*) board (The engine)
+static void growScanBox(GrowBoard *board)
+{
+    board->population = 0;
+    for (int i = board->top; i <= board->bottom; i++)
+    {
+        unsigned char *row = growRow(&board->memory, board->current, i);
+        for (int j = board->left; j <= board->right; j++)
+        {
+            if (row[j])
+            {
+                board->boxTop = board->population == 0 ? i : board->boxTop;
+                board->boxLeft = board->population == 0 || j < board->boxLeft ? j : board->boxLeft;
+                board->boxRight = board->population == 0 || j > board->boxRight ? j : board->boxRight;
+                board->boxBottom = i;
+                board->population++;
+            }
+        }
+    }
+}
+
+// Kill the Cells of a rectangle of the plane in one of the boards
+//    Param: (GrowBoard*) board (The engine)
+//           (int) buffer (Which of the two boards)
+//           (int) top (First row of the rectangle)
+//           (int) left (First column of the rectangle)
+//           (int) bottom (Last row of the rectangle)
+//           (int) right (Last column of the rectangle)
+static void growClearRectangle(GrowBoard *board, int buffer, int top, int left, int bottom, int right)
+{
+    for (int i = top; i <= bottom && left <= right; i++)
+    {
+        memset(growRow(&board->memory, buffer, i) + left, 0, right - left + 1);
+    }
+}
+
+// Calculate the next generation of the extent from one board into another, in the same memory or in new memory
+// Cells outside the extent are dead and stay so, as the extent reaches one past every live Cell
+//    Param: (GrowBoard*) board (The engine)
+//           (GrowMemory*) from (Memory of the current generation, read one Cell past the extent)
+//           (int) source (Board of the current generation)
+//           (GrowMemory*) to (Memory of the next generation)
+//           (int) target (Board of the next generation)
+//           (GenerationStats*) stats (Receives the statistics of the window)
+static void growGeneration(GrowBoard *board, GrowMemory *from, int source, GrowMemory *to, int target, GenerationStats *stats)
+{
+    long population = 0;
+    int found = 0;
+    int boxTop = 0, boxLeft = 0, boxBottom = 0, boxRight = 0;
+
+    for (int i = board->top; i <= board->bottom; i++)
+    {
+        unsigned char *up = growRow(from, source, i - 1);
+        unsigned char *middle = growRow(from, source, i);
+        unsigned char *down = growRow(from, source, i + 1);
+        unsigned char *out = growRow(to, target, i);
+        int first = board->right + 1;
+        int last = board->left - 1;
+
+        // Live Cells of the columns left of, at and right of the Cell, slid along the row
+        int j = board->left;
+        int west = up[j - 1] + middle[j - 1] + down[j - 1];
+        int centre = up[j] + middle[j] + down[j];
+        for (; j <= board->right; j++)
+        {
+            int east = up[j + 1] + middle[j + 1] + down[j + 1];
+            int neighbours = west + centre + east - middle[j];
+            unsigned char cell = neighbours == 3 || (middle[j] && neighbours == 2);
+            out[j] = cell;
+            if (cell)
+            {
+                first = j < first ? j : first;
+                last = j;
+                population++;
+            }
+            west = centre;
+            centre = east;
+        }
+
+        if (last >= first)
+        {
+            boxTop = found ? boxTop : i;
+            boxLeft = found && boxLeft < first ? boxLeft : first;
+            boxRight = found && boxRight > last ? boxRight : last;
+            boxBottom = i;
+            found = 1;
+        }
+
+        // The statistics only see the window, where the board of the caller is
+        if (i >= 0 && i < board->HEIGHT)
+        {
+            statsAccountBytes(stats, middle, out, board->WIDTH, i, 0);
+        }
+    }
+
+    board->population = population;
+    board->boxTop = boxTop;
+    board->boxLeft = boxLeft;
+    board->boxBottom = boxBottom;
+    board->boxRight = boxRight;
+}
+
+// Move the extent back in where the live Cells have left its edges, killing what the other board still holds there
+// The window always stays in the extent
+//    Param: (GrowBoard*) board (The engine, just past a generation)
+//           (int) moved (1 if the other board is fresh memory, dead already)
+static void growShrink(GrowBoard *board, int moved)
+{
+    int top = 0, left = 0, bottom = board->HEIGHT - 1, right = board->WIDTH - 1;
+    if (board->population > 0)
+    {
+        top = board->boxTop - board->top > 2 * GROW_SLACK ? board->boxTop - GROW_SLACK : board->top;
+        left = board->boxLeft - board->left > 2 * GROW_SLACK ? board->boxLeft - GROW_SLACK : board->left;
+        bottom = board->bottom - board->boxBottom > 2 * GROW_SLACK ? board->boxBottom + GROW_SLACK : board->bottom;
+        right = board->right - board->boxRight > 2 * GROW_SLACK ? board->boxRight + GROW_SLACK : board->right;
+        top = top < 0 ? top : 0;
+        left = left < 0 ? left : 0;
+        bottom = bottom > board->HEIGHT - 1 ? bottom : board->HEIGHT - 1;
+        right = right > board->WIDTH - 1 ? right : board->WIDTH - 1;
+    }
+    if (top == board->top && left == board->left && bottom == board->bottom && right == board->right)
+    {
+        return;
+    }
+
+    // The current board is dead past the live Cells, the other one still holds the generation before
+    if (!moved)
+    {
+        int other = 1 - board->current;
+        growClearRectangle(board, other, board->top, board->left, top - 1, board->right);
+        growClearRectangle(board, other, bottom + 1, board->left, board->bottom, board->right);
+        growClearRectangle(board, other, top, board->left, bottom, left - 1);
+        growClearRectangle(board, other, top, right + 1, bottom, board->right);
+    }
+
+    board->top = top;
+    board->left = left;
+    board->bottom = bottom;
+    board->right = right;
+}
+
+// Calculate one generation, moving the extent out where live Cells reach its edges and the memory where the extent reaches it
+//    Param: (GrowBoard*) board (The engine)
+//           (GenerationStats*) stats (Receives the statistics of the window)
+static void growStep(GrowBoard *board, GenerationStats *stats)
+{
+    double start = growClock();
+    growPrepare(board);
+
+    // Births can only happen one Cell past the live ones, as far as the limit lets the extent go
+    if (board->population > 0)
+    {
+        if (board->boxTop == board->top && board->bottom - board->top + 1 < board->limitHeight)
+        {
+            board->top--;
+        }
+        if (board->boxBottom == board->bottom && board->bottom - board->top + 1 < board->limitHeight)
+        {
+            board->bottom++;
+        }
+        if (board->boxLeft == board->left && board->right - board->left + 1 < board->limitWidth)
+        {
+            board->left--;
+        }
+        if (board->boxRight == board->right && board->right - board->left + 1 < board->limitWidth)
+        {
+            board->right++;
+        }
+    }
+
+    // The next generation goes straight into new memory when the extent no longer fits the memory it has
+    GrowMemory *memory = &board->memory;
+    GrowMemory moved;
+    int top, left, height, width;
+    int moveRows = growPlace(memory->top, memory->height, board->top - GROW_PAD, board->bottom + GROW_PAD, board->limitHeight + 2 * GROW_PAD, &top, &height);
+    int moveColumns = growPlace(memory->left, memory->width, board->left - GROW_PAD, board->right + GROW_PAD, board->limitWidth + 2 * GROW_PAD, &left, &width);
+    int move = (moveRows || moveColumns) && growMove(board, &moved, top, left, height, width) == 0;
+    if ((moveRows || moveColumns) && !move)
+    {
+        // Without new memory, the edge of the memory is the edge of the board
+        board->top = board->top < memory->top + GROW_PAD ? memory->top + GROW_PAD : board->top;
+        board->left = board->left < memory->left + GROW_PAD ? memory->left + GROW_PAD : board->left;
+        board->bottom = board->bottom > memory->top + memory->height - 1 - GROW_PAD ? memory->top + memory->height - 1 - GROW_PAD : board->bottom;
+        board->right = board->right > memory->left + memory->width - 1 - GROW_PAD ? memory->left + memory->width - 1 - GROW_PAD : board->right;
+    }
+
+    if (move)
+    {
+        growGeneration(board, memory, board->current, &moved, 0, stats);
+        board->retired = memory->arena;
+        board->memory = moved;
+        board->current = 0;
+    }
+    else
+    {
+        growGeneration(board, memory, board->current, memory, 1 - board->current, stats);
+        board->current = 1 - board->current;
+    }
+    growShrink(board, move);
+
+    int extentHeight = board->bottom - board->top + 1;
+    int extentWidth = board->right - board->left + 1;
+    double seconds = growClock() - start;
+    board->generations++;
+    board->cells += (double)extentHeight * extentWidth;
+    board->seconds += seconds;
+    board->largestHeight = extentHeight > board->largestHeight ? extentHeight : board->largestHeight;
+    board->largestWidth = extentWidth > board->largestWidth ? extentWidth : board->largestWidth;
+    if (move)
+    {
+        board->moves++;
+        board->moveSeconds += seconds;
+    }
+}
+
+/* ---------------------------- Growing Board API ---------------------------- */
+GrowBoard *growBoardCreate(int HEIGHT, int WIDTH, int limit, ArenaPages pages)
+{
+    GrowBoard *board = (GrowBoard *)calloc(1, sizeof(GrowBoard));
+    if (board == NULL)
+    {
+        return NULL;
+    }
+
+    board->HEIGHT = HEIGHT;
+    board->WIDTH = WIDTH;
+    board->limitHeight = limit > HEIGHT ? limit : HEIGHT;
+    board->limitWidth = limit > WIDTH ? limit : WIDTH;
+    board->pages = pages;
+    board->top = 0;
+    board->left = 0;
+    board->bottom = HEIGHT - 1;
+    board->right = WIDTH - 1;
+
+    int top, left, height, width;
+    growPlaceWindow(board, &top, &left, &height, &width);
+    if (growMap(&board->memory, top, left, height, width, pages) != 0)
+    {
+        free(board);
+        return NULL;
+    }
+
+    return board;
+}
+
+void growBoardLoad(GrowBoard *board, int **currentBoard)
+{
+    for (int i = 0; i < board->HEIGHT; i++)
+    {
+        unsigned char *row = growRow(&board->memory, board->current, i);
+        for (int j = 0; j < board->WIDTH; j++)
+        {
+            row[j] = currentBoard[i][j] == 1;
+        }
+    }
+    growScanBox(board);
+}
+
+int growBoardLoadPlane(GrowBoard *board, int *cells, long count)
+{
+    // The extent holds the window and every Cell given
+    int top = 0, left = 0, bottom = board->HEIGHT - 1, right = board->WIDTH - 1;
+    for (long k = 0; k < count; k++)
+    {
+        top = cells[2 * k] < top ? cells[2 * k] : top;
+        bottom = cells[2 * k] > bottom ? cells[2 * k] : bottom;
+        left = cells[2 * k + 1] < left ? cells[2 * k + 1] : left;
+        right = cells[2 * k + 1] > right ? cells[2 * k + 1] : right;
+    }
+    if ((long)bottom - top + 1 > board->limitHeight || (long)right - left + 1 > board->limitWidth)
+    {
+        return -1;
+    }
+
+    // The memory starts over around the extent, in the arena it already has unless that is too small
+    GrowMemory *memory = &board->memory;
+    GrowMemory placed;
+    int memoryTop, memoryLeft, height, width;
+    growPlace(0, 0, top - GROW_PAD, bottom + GROW_PAD, board->limitHeight + 2 * GROW_PAD, &memoryTop, &height);
+    growPlace(0, 0, left - GROW_PAD, right + GROW_PAD, board->limitWidth + 2 * GROW_PAD, &memoryLeft, &width);
+    arenaReset(memory->arena);
+    if (growCarve(&placed, memory->arena, memoryTop, memoryLeft, height, width) == 0)
+    {
+        memset(placed.cells[0], 0, placed.stride * (size_t)height);
+        memset(placed.cells[1], 0, placed.stride * (size_t)height);
+    }
+    else if (growMap(&placed, memoryTop, memoryLeft, height, width, board->pages) == 0)
+    {
+        arenaFree(memory->arena);
+    }
+    else
+    {
+        // The old memory was only handed back, its boards are as they were
+        return -1;
+    }
+
+    board->memory = placed;
+    board->current = 0;
+    board->top = top;
+    board->left = left;
+    board->bottom = bottom;
+    board->right = right;
+    for (long k = 0; k < count; k++)
+    {
+        growRow(&board->memory, 0, cells[2 * k])[cells[2 * k + 1]] = 1;
+    }
+    growScanBox(board);
+    return 0;
+}
+
+long growBoardPopulation(GrowBoard *board)
+{
+    return board->population;
+}
+
+long growBoardOutside(GrowBoard *board, int *cells)
+{
+    long count = 0;
+    for (int i = board->top; i <= board->bottom; i++)
+    {
+        unsigned char *row = growRow(&board->memory, board->current, i);
+        int inside = i >= 0 && i < board->HEIGHT;
+        for (int j = board->left; j <= board->right; j++)
+        {
+            if (inside && j == 0)
+            {
+                // Skip the window
+                j = board->WIDTH - 1;
+                continue;
+            }
+            if (row[j])
+            {
+                cells[2 * count] = i;
+                cells[2 * count + 1] = j;
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+void growBoardStore(GrowBoard *board, int **currentBoard)
+{
+    for (int i = 0; i < board->HEIGHT; i++)
+    {
+        unsigned char *row = growRow(&board->memory, board->current, i);
+        for (int j = 0; j < board->WIDTH; j++)
+        {
+            currentBoard[i][j] = row[j];
+        }
+    }
+}
+
+void growBoardStep(GrowBoard *board, int generations, StatsRecorder *recorder)
+{
+    for (int g = 0; g < generations; g++)
+    {
+        GenerationStats stats;
+        statsReset(&stats, 0);
+        growStep(board, &stats);
+
+        if (recorder != NULL)
+        {
+            statsRecord(recorder, &stats);
+        }
+    }
+}
+
+void growBoardExtent(GrowBoard *board, int *top, int *left, int *HEIGHT, int *WIDTH)
+{
+    *top = board->top;
+    *left = board->left;
+    *HEIGHT = board->bottom - board->top + 1;
+    *WIDTH = board->right - board->left + 1;
+}
+
+void growBoardCopy(GrowBoard *board, int top, int left, int HEIGHT, int WIDTH, int **cells)
+{
+    for (int i = 0; i < HEIGHT; i++)
+    {
+        int r = top + i;
+        unsigned char *row = r >= board->top && r <= board->bottom ? growRow(&board->memory, board->current, r) : NULL;
+        for (int j = 0; j < WIDTH; j++)
+        {
+            int c = left + j;
+            cells[i][j] = row != NULL && c >= board->left && c <= board->right ? row[c] : 0;
+        }
+    }
+}
+
+void growBoardReport(GrowBoard *board, FILE *stream)
+{
+    long others = board->generations - board->moves;
+    fprintf(stream, "Growing board: %ld live Cells in an extent of %dx%d from row %d, column %d (at most %dx%d so far, %.0f Cells per generation on average).\n",
+            board->population, board->bottom - board->top + 1, board->right - board->left + 1, board->top, board->left, board->largestHeight, board->largestWidth,
+            board->generations > 0 ? board->cells / board->generations : 0.0);
+    fprintf(stream, "Memory for %dx%d Cells, moved %ld times (%ld into spare memory zeroed ahead): %.3f ms per generation moving it, %.3f ms per other generation.\n",
+            board->memory.height, board->memory.width, board->moves, board->spareMoves, board->moves > 0 ? board->moveSeconds * 1e3 / board->moves : 0.0,
+            others > 0 ? (board->seconds - board->moveSeconds) * 1e3 / others : 0.0);
+}
+
+void growBoardFree(GrowBoard *board)
+{
+    if (board == NULL)
+    {
+        return;
+    }
+
+    arenaFree(board->memory.arena);
+    arenaFree(board->spare);
+    arenaFree(board->retired);
+    free(board);
+}
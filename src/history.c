@@ -0,0 +1,333 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <history.h>
+
+/* -------------------------------------------------------------------------- */
+/*        History of recent generations: keyframes and deltas in memory        */
+/* -------------------------------------------------------------------------- */
+
+// A recorded board: all Cells packed in bits, or the indices of the Cells that changed,
+// and the live Cells outside of it
+struct HistoryEntry
+{
+    GenerationStats stats;
+    int keyframe;
+    size_t count;
+    void *data;
+    long outsideCount;
+    int *outside;
+};
+typedef struct HistoryEntry HistoryEntry;
+
+struct History
+{
+    int HEIGHT;
+    int WIDTH;
+    int interval;
+    size_t capacity;
+    size_t size;
+
+    // The latest recorded board in bits, and a second buffer to pack the next one in
+    size_t words;
+    uint64_t *head;
+    uint64_t *scratch;
+
+    // Ring of entries, oldest first, the oldest one always being a keyframe
+    HistoryEntry *entries;
+    int slots;
+    int first;
+    int count;
+
+    // Deltas recorded since the latest keyframe
+    int sinceKeyframe;
+};
+
+/* -------------------------- Utilities of a History ------------------------- */
+// Entry at a position of the ring, counted from the oldest one
+//    Param: (History*) history (The history)
+//           (int) index (Position, 0 being the oldest entry)
+//    Return: (HistoryEntry*) The entry
+static HistoryEntry *historyEntry(History *history, int index)
+{
+    return &history->entries[(history->first + index) % history->slots];
+}
+
+// Bytes an entry takes
+//    Param: (HistoryEntry*) entry (The entry)
+//    Return: (size_t) Size in bytes
+static size_t historyEntrySize(HistoryEntry *entry)
+{
+    return sizeof(HistoryEntry) + entry->count * (entry->keyframe ? sizeof(uint64_t) : sizeof(uint32_t)) + entry->outsideCount * 2 * sizeof(int);
+}
+
+// Drop the oldest entry
+//    Param: (History*) history (The history)
+static void historyDropOldest(History *history)
+{
+    HistoryEntry *entry = historyEntry(history, 0);
+    history->size -= historyEntrySize(entry);
+    free(entry->data);
+    free(entry->outside);
+    history->first = (history->first + 1) % history->slots;
+    history->count--;
+}
+
+// Drop the newest entry
+//    Param: (History*) history (The history)
+static void historyDropNewest(History *history)
+{
+    HistoryEntry *entry = historyEntry(history, history->count - 1);
+    history->size -= historyEntrySize(entry);
+    free(entry->data);
+    free(entry->outside);
+    history->count--;
+}
+
+// Make room for one more entry, doubling the ring when it is full
+//    Param: (History*) history (The history)
+//    Return: (int) 1 on success, 0 if the ring could not grow
+static int historyReserve(History *history)
+{
+    if (history->count < history->slots)
+    {
+        return 1;
+    }
+
+    int slots = history->slots * 2;
+    HistoryEntry *entries = (HistoryEntry *)malloc(slots * sizeof(HistoryEntry));
+    if (entries == NULL)
+    {
+        return 0;
+    }
+
+    for (int i = 0; i < history->count; i++)
+    {
+        entries[i] = *historyEntry(history, i);
+    }
+    free(history->entries);
+    history->entries = entries;
+    history->slots = slots;
+    history->first = 0;
+    return 1;
+}
+
+// Evict whole keyframe groups, oldest first, until the history fits its cap
+//    Param: (History*) history (The history)
+static void historyEvict(History *history)
+{
+    while (history->size > history->capacity)
+    {
+        // The oldest keyframe can only go together with its deltas, and only if a newer keyframe remains
+        int next = 1;
+        while (next < history->count && !historyEntry(history, next)->keyframe)
+        {
+            next++;
+        }
+        if (next >= history->count)
+        {
+            return;
+        }
+
+        for (int i = 0; i < next; i++)
+        {
+            historyDropOldest(history);
+        }
+    }
+}
+
+/* -------------------------------- History API ------------------------------ */
+History *historyCreate(int HEIGHT, int WIDTH, int interval, size_t capacity)
+{
+    History *history = (History *)calloc(1, sizeof(History));
+    if (history == NULL)
+    {
+        return NULL;
+    }
+
+    history->HEIGHT = HEIGHT;
+    history->WIDTH = WIDTH;
+    history->interval = interval > 0 ? interval : HISTORY_DEFAULT_INTERVAL;
+    history->capacity = capacity;
+    history->words = ((size_t)HEIGHT * WIDTH + 63) / 64;
+    history->head = (uint64_t *)calloc(history->words, sizeof(uint64_t));
+    history->scratch = (uint64_t *)calloc(history->words, sizeof(uint64_t));
+    history->slots = 64;
+    history->entries = (HistoryEntry *)malloc(history->slots * sizeof(HistoryEntry));
+
+    if (history->head == NULL || history->scratch == NULL || history->entries == NULL)
+    {
+        historyFree(history);
+        return NULL;
+    }
+
+    return history;
+}
+
+void historyPush(History *history, int **currentBoard, GenerationStats *stats, int *outside, long count)
+{
+    if (!historyReserve(history))
+    {
+        return;
+    }
+
+    int *outsideCopy = NULL;
+    if (count > 0)
+    {
+        outsideCopy = (int *)malloc(count * 2 * sizeof(int));
+        if (outsideCopy == NULL)
+        {
+            return;
+        }
+        memcpy(outsideCopy, outside, count * 2 * sizeof(int));
+    }
+
+    // Cells are packed row by row, Cell (i, j) being bit i * WIDTH + j
+    memset(history->scratch, 0, history->words * sizeof(uint64_t));
+    size_t bit = 0;
+    for (int i = 0; i < history->HEIGHT; i++)
+    {
+        for (int j = 0; j < history->WIDTH; j++, bit++)
+        {
+            history->scratch[bit / 64] |= (uint64_t)(currentBoard[i][j] == 1) << (bit % 64);
+        }
+    }
+
+    // A delta only pays off while it is smaller than a keyframe
+    size_t changed = 0;
+    int keyframe = history->count == 0 || history->sinceKeyframe + 1 >= history->interval;
+    for (size_t w = 0; w < history->words && !keyframe; w++)
+    {
+        changed += __builtin_popcountll(history->head[w] ^ history->scratch[w]);
+        keyframe = changed * sizeof(uint32_t) >= history->words * sizeof(uint64_t);
+    }
+
+    HistoryEntry entry = {*stats, keyframe, keyframe ? history->words : changed, NULL, count > 0 ? count : 0, outsideCopy};
+    if (keyframe)
+    {
+        entry.data = malloc(history->words * sizeof(uint64_t));
+        if (entry.data == NULL)
+        {
+            free(outsideCopy);
+            return;
+        }
+        memcpy(entry.data, history->scratch, history->words * sizeof(uint64_t));
+        history->sinceKeyframe = 0;
+    }
+    else
+    {
+        uint32_t *flips = (uint32_t *)malloc((changed > 0 ? changed : 1) * sizeof(uint32_t));
+        if (flips == NULL)
+        {
+            free(outsideCopy);
+            return;
+        }
+
+        size_t n = 0;
+        for (size_t w = 0; w < history->words; w++)
+        {
+            uint64_t diff = history->head[w] ^ history->scratch[w];
+            while (diff != 0)
+            {
+                flips[n++] = (uint32_t)(w * 64 + __builtin_ctzll(diff));
+                diff &= diff - 1;
+            }
+        }
+        entry.data = flips;
+        history->sinceKeyframe++;
+    }
+
+    *historyEntry(history, history->count) = entry;
+    history->count++;
+    history->size += historyEntrySize(&entry);
+
+    uint64_t *swap = history->head;
+    history->head = history->scratch;
+    history->scratch = swap;
+
+    historyEvict(history);
+}
+
+int historyBack(History *history, int steps, int **currentBoard, GenerationStats *stats)
+{
+    if (steps > history->count - 1)
+    {
+        steps = history->count - 1;
+    }
+    if (steps <= 0)
+    {
+        return 0;
+    }
+
+    for (int s = 0; s < steps; s++)
+    {
+        historyDropNewest(history);
+    }
+
+    // Start from the latest keyframe and replay the deltas after it
+    int target = history->count - 1;
+    int keyframe = target;
+    while (!historyEntry(history, keyframe)->keyframe)
+    {
+        keyframe--;
+    }
+
+    memcpy(history->head, historyEntry(history, keyframe)->data, history->words * sizeof(uint64_t));
+    for (int k = keyframe + 1; k <= target; k++)
+    {
+        HistoryEntry *entry = historyEntry(history, k);
+        uint32_t *flips = (uint32_t *)entry->data;
+        for (size_t f = 0; f < entry->count; f++)
+        {
+            history->head[flips[f] / 64] ^= (uint64_t)1 << (flips[f] % 64);
+        }
+    }
+    history->sinceKeyframe = target - keyframe;
+
+    size_t bit = 0;
+    for (int i = 0; i < history->HEIGHT; i++)
+    {
+        for (int j = 0; j < history->WIDTH; j++, bit++)
+        {
+            currentBoard[i][j] = (history->head[bit / 64] >> (bit % 64)) & 1;
+        }
+    }
+
+    *stats = historyEntry(history, target)->stats;
+    return steps;
+}
+
+int *historyOutside(History *history, long *count)
+{
+    HistoryEntry *entry = history->count > 0 ? historyEntry(history, history->count - 1) : NULL;
+    *count = entry != NULL ? entry->outsideCount : 0;
+    return entry != NULL ? entry->outside : NULL;
+}
+
+int historyDepth(History *history)
+{
+    return history->count > 0 ? history->count - 1 : 0;
+}
+
+size_t historySize(History *history)
+{
+    return history->size;
+}
+
+void historyFree(History *history)
+{
+    if (history == NULL)
+    {
+        return;
+    }
+
+    while (history->entries != NULL && history->count > 0)
+    {
+        historyDropNewest(history);
+    }
+    free(history->entries);
+    free(history->head);
+    free(history->scratch);
+    free(history);
+}
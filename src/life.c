@@ -0,0 +1,1178 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <life.h>
+#include <lifeoptions.h>
+#include <stats.h>
+#include <perfcount.h>
+#include <tilesched.h>
+#include <temporal.h>
+#include <zboard.h>
+#include <changelist.h>
+#include <ltl.h>
+#include <growboard.h>
+#include <fixedboard.h>
+#include <history.h>
+#include <publish.h>
+
+/* -------------------------------------------------------------------------- */
+/*     liblife: Conway's Game of Life engine, with no terminal input/output    */
+/* -------------------------------------------------------------------------- */
+
+struct Life
+{
+    int HEIGHT;
+    int WIDTH;
+    LifeOptions options;
+    LifeEngine engine;
+    int started;
+
+    // Both boards are carved from one arena, the in-place engine has a window of two rows instead of the next board
+    Arena *arena;
+    int **currentBoard;
+    int **nextBoard;
+    int *window[2];
+
+    // State of the engine, the scheduler or stepper may be borrowed by the single process engine
+    Domain *domain;
+    TileScheduler *scheduler;
+    TemporalStepper *stepper;
+    ZBoard *zboard;
+    ChangeList *changeList;
+    LtlStepper *ltl;
+    GrowBoard *growBoard;
+
+    // Live Cells of the plane outside of the board for the growing board, in row and column pairs: those of a board file
+    // until the engine starts, then gathered from it for the history and the saves
+    int *outside;
+    long outsideCount;
+    long outsideCapacity;
+
+    // The borrowed scheduler has to forget its stable tiles when the board moved on without it
+    int borrowedStale;
+
+    // The engine holds a later board than the Life, which is only stored when it is read
+    int boardStale;
+
+    StatsRecorder recorder;
+    History *history;
+
+    // Every publishEvery-th generation is published for viewers in other processes
+    Publisher *publisher;
+    int publishEvery;
+
+    // Hardware counters around every call of the engine
+    PerfCounters *counters;
+};
+
+/* ------ Core functions for the calculations of Conway's game of life ------ */
+
+// Assign a board with another board (newBoard = originalBoard)
+//    Param: (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//           (int**) originalBoard (Pointer to A 2D Dynamic Interger Array that serves as the orginal board)
+//           (int**) newBoard (Pointer to A 2D Dynamic Interger Array that serves as the new board)
+static void assignBoard(int HEIGHT, int WIDTH, int **newBoard, int **originalBoard)
+{
+    for (int i = 0; i < HEIGHT; i++)
+    {
+        for (int j = 0; j < WIDTH; j++)
+        {
+            newBoard[i][j] = originalBoard[i][j];
+        }
+    }
+}
+
+// Count Live Neighbour Cell for Conway's Game of life
+//    Param: (int) r (X coordinate of Cell)
+//           (int) c (Y coordinate of Cell)
+//           (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Arra that serves as the Game Board)
+//    Return: (int) Number of Live Cells
+static int countLiveNeighbourCell(int r, int c, int HEIGHT, int WIDTH, int **currentBoard)
+{
+    // Live Surrounging Cell Counter
+    int count = 0;
+
+    // Loop over the surrounding cells
+    for (int i = r - 1; i <= r + 1; i++)
+    {
+        for (int j = c - 1; j <= c + 1; j++)
+        {
+
+            // Skip in case the cell is out of bound or the cell itself
+            if ((i == r && j == c) || (i < 0 || j < 0) || (i >= HEIGHT || j >= WIDTH))
+            {
+                continue;
+            }
+
+            // If live then counter goes up by one
+            if (currentBoard[i][j] == 1)
+            {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+// Calculate next game board
+//    Param: (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
+//           (int**) nextBoard (Pointer to A 2D Dynamic Interger Array that serves as the next Game Board after calculations)
+//           (StatsRecorder*) recorder (Receives population, births, deaths and bounding box of the new board, or NULL)
+static void calculateNextBoard(int HEIGHT, int WIDTH, int **currentBoard, int **nextBoard, StatsRecorder *recorder)
+{
+    // Stores the value of live neighbours of a cell
+    int cell;
+
+    // Statistics are gathered in the same pass, the board is never read again for them
+    GenerationStats stats;
+    statsReset(&stats, 0);
+
+    for (int i = 0; i < HEIGHT; i++)
+    {
+        int first = -1;
+        int last = -1;
+
+        for (int j = 0; j < WIDTH; j++)
+        {
+
+            // Update live neighbours count
+            cell = countLiveNeighbourCell(i, j, HEIGHT, WIDTH, currentBoard);
+
+            // Rules of the game
+            if (currentBoard[i][j] == 1 && (cell == 2 || cell == 3))
+            {
+                nextBoard[i][j] = 1;
+            }
+
+            else if (currentBoard[i][j] == 0 && cell == 3)
+            {
+                nextBoard[i][j] = 1;
+            }
+
+            else
+            {
+                nextBoard[i][j] = 0;
+            }
+
+            if (nextBoard[i][j] == 1)
+            {
+                stats.population++;
+                stats.births += currentBoard[i][j] != 1;
+                first = first < 0 ? j : first;
+                last = j;
+            }
+            else
+            {
+                stats.deaths += currentBoard[i][j] == 1;
+            }
+        }
+
+        if (first >= 0)
+        {
+            statsIncludeRun(&stats, i, first, last);
+        }
+    }
+
+    // Copy Next Board to Current Board
+    assignBoard(HEIGHT, WIDTH, currentBoard, nextBoard);
+
+    if (recorder != NULL)
+    {
+        statsRecord(recorder, &stats);
+    }
+}
+
+// Calculate next game board in place, without a second board
+// Row i is written over while rows i - 1 and i + 1 are still needed as they were: the row below
+// is not written yet, and the rows above and being written are saved in a window of two rows
+//    Param: (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board, overwritten with the next one)
+//           (int**) window (Two rows of WIDTH ints, swapped while going down the board)
+//           (StatsRecorder*) recorder (Receives population, births, deaths and bounding box of the new board, or NULL)
+static void calculateNextBoardInPlace(int HEIGHT, int WIDTH, int **currentBoard, int **window, StatsRecorder *recorder)
+{
+    int *above = window[0];
+    int *original = window[1];
+
+    GenerationStats stats;
+    statsReset(&stats, 0);
+
+    for (int i = 0; i < HEIGHT; i++)
+    {
+        int first = -1;
+        int last = -1;
+
+        memcpy(original, currentBoard[i], WIDTH * sizeof(int));
+        int *up = i > 0 ? above : NULL;
+        int *down = i < HEIGHT - 1 ? currentBoard[i + 1] : NULL;
+        int *out = currentBoard[i];
+
+        for (int j = 0; j < WIDTH; j++)
+        {
+            // Live neighbours, from the rows as they were before this generation
+            int count = 0;
+            for (int k = j - 1; k <= j + 1; k++)
+            {
+                if (k < 0 || k >= WIDTH)
+                {
+                    continue;
+                }
+                count += (up != NULL && up[k] == 1) + (down != NULL && down[k] == 1) + (k != j && original[k] == 1);
+            }
+
+            // Rules of the game
+            int alive = original[j] == 1;
+            int cell = (count == 3 || (alive && count == 2)) ? 1 : 0;
+            out[j] = cell;
+
+            stats.population += cell;
+            stats.births += cell & !alive;
+            stats.deaths += alive & !cell;
+            if (cell)
+            {
+                first = first < 0 ? j : first;
+                last = j;
+            }
+        }
+
+        if (first >= 0)
+        {
+            statsIncludeRun(&stats, i, first, last);
+        }
+
+        // The row just written was, as it was, the row above the next one
+        int *swap = above;
+        above = original;
+        original = swap;
+    }
+
+    if (recorder != NULL)
+    {
+        statsRecord(recorder, &stats);
+    }
+}
+
+/* --------------------------- Utilities of a Life --------------------------- */
+// Store the board of the engine in the board of the Life, if it is behind
+//    Param: (Life*) life (The Life)
+static void lifeStoreBoard(Life *life)
+{
+    if (!life->boardStale)
+    {
+        return;
+    }
+
+    if (life->engine == ZORDER_ENGINE)
+    {
+        zboardStore(life->zboard, life->currentBoard);
+    }
+    life->boardStale = 0;
+}
+
+// Gather the live Cells outside of the board from the growing board, before its start they are those read from a file
+//    Param: (Life*) life (The Life)
+//    Return: (int) 0 on success, -1 if out of memory (none are gathered)
+static int lifeGatherOutside(Life *life)
+{
+    if (life->growBoard == NULL)
+    {
+        return 0;
+    }
+
+    long population = growBoardPopulation(life->growBoard);
+    if (population > life->outsideCapacity)
+    {
+        int *outside = (int *)realloc(life->outside, population * 2 * sizeof(int));
+        if (outside == NULL)
+        {
+            life->outsideCount = 0;
+            return -1;
+        }
+        life->outside = outside;
+        life->outsideCapacity = population;
+    }
+    life->outsideCount = growBoardOutside(life->growBoard, life->outside);
+    return 0;
+}
+
+// Record the board in the history, with the Cells of the growing board outside of it
+//    Param: (Life*) life (The Life, with a history)
+static void lifeRecord(Life *life)
+{
+    lifeStoreBoard(life);
+    if (life->engine == GROWING_ENGINE && lifeGatherOutside(life) == 0)
+    {
+        historyPush(life->history, life->currentBoard, &life->recorder.last, life->outside, life->outsideCount);
+        return;
+    }
+    historyPush(life->history, life->currentBoard, &life->recorder.last, NULL, 0);
+}
+
+// Stop the worker processes after one of them died, the single process engine goes on from the board of the Life
+//    Param: (Life*) life (The Life)
+static void lifeDomainFailed(Life *life)
+{
+    domainStop(life->domain);
+    life->domain = NULL;
+    life->engine = GENERIC_ENGINE;
+}
+
+// Advance the board by a number of generations with an engine
+//    Param: (Life*) life (The Life)
+//           (LifeEngine) engine (The engine, whose state must exist)
+//           (int) generations (Number of generations to calculate)
+static void lifeAdvanceEngine(Life *life, LifeEngine engine, int generations)
+{
+    switch (engine)
+    {
+    case DOMAIN_ENGINE:
+    {
+        // The workers keep the board, it is only gathered once all generations are done
+        long generation = life->recorder.generation;
+        GenerationStats last = life->recorder.last;
+        if (domainStep(life->domain, generations, &life->recorder) == 0 && domainGather(life->domain, life->currentBoard) == 0)
+        {
+            break;
+        }
+
+        // The stripe of a dead worker is lost: the generations are calculated again from the board gathered last
+        life->recorder.generation = generation;
+        life->recorder.last = last;
+        if (life->recorder.series != NULL)
+        {
+            statsSeriesTruncate(life->recorder.series, generation);
+        }
+        lifeDomainFailed(life);
+        lifeAdvanceEngine(life, GENERIC_ENGINE, generations);
+        break;
+    }
+    case TILE_ENGINE:
+        tileSchedulerStep(life->scheduler, generations, life->currentBoard, life->nextBoard, &life->recorder);
+        break;
+    case TEMPORAL_ENGINE:
+        temporalStepperStep(life->stepper, generations, life->currentBoard, life->nextBoard, &life->recorder);
+        break;
+    case ZORDER_ENGINE:
+        // The tiled board is the real one, the row-major board is only refreshed when the caller reads it
+        zboardStep(life->zboard, generations, &life->recorder);
+        life->boardStale = 1;
+        break;
+    case CHANGELIST_ENGINE:
+        // The flipped Cells are written straight into the board
+        changeListStep(life->changeList, generations, life->currentBoard, &life->recorder);
+        break;
+    case LARGER_ENGINE:
+        // The summed-area table holds all the rule needs, the board is written in place
+        ltlStepperStep(life->ltl, generations, life->currentBoard, &life->recorder);
+        break;
+    case GROWING_ENGINE:
+        // The plane is the real board, the board of the Life is the window onto it
+        growBoardStep(life->growBoard, generations, &life->recorder);
+        growBoardStore(life->growBoard, life->currentBoard);
+        break;
+    case INPLACE_ENGINE:
+        for (int g = 0; g < generations; g++)
+        {
+            calculateNextBoardInPlace(life->HEIGHT, life->WIDTH, life->currentBoard, life->window, &life->recorder);
+        }
+        break;
+    default:
+        // Boards of a size with a fixed-size engine skip the generic one
+        if (fixedBoardStep(life->HEIGHT, life->WIDTH, generations, life->currentBoard, life->nextBoard, &life->recorder))
+        {
+            break;
+        }
+        for (int g = 0; g < generations; g++)
+        {
+            calculateNextBoard(life->HEIGHT, life->WIDTH, life->currentBoard, life->nextBoard, &life->recorder);
+        }
+        break;
+    }
+}
+
+// Advance the board by a number of generations with an engine, and record the result in the history
+// While publishing, the engine stops on every published generation so that viewers see all of them
+//    Param: (Life*) life (The Life)
+//           (LifeEngine) engine (The engine, whose state must exist)
+//           (int) generations (Number of generations to calculate)
+static void lifeAdvance(Life *life, LifeEngine engine, int generations)
+{
+    while (generations > 0)
+    {
+        int chunk = generations;
+        if (life->publisher != NULL)
+        {
+            long untilPublished = life->publishEvery - life->recorder.generation % life->publishEvery;
+            if (untilPublished < chunk)
+            {
+                chunk = (int)untilPublished;
+            }
+        }
+
+        if (life->counters != NULL)
+        {
+            long first = life->recorder.generation + 1;
+            perfCountersStart(life->counters);
+            lifeAdvanceEngine(life, engine, chunk);
+            perfCountersStop(life->counters, first, chunk, (double)life->HEIGHT * life->WIDTH);
+        }
+        else
+        {
+            lifeAdvanceEngine(life, engine, chunk);
+        }
+        generations -= chunk;
+
+        if (life->publisher != NULL && life->recorder.generation % life->publishEvery == 0)
+        {
+            lifeStoreBoard(life);
+            publisherPublish(life->publisher, life->currentBoard, &life->recorder.last);
+        }
+    }
+
+    if (life->history != NULL)
+    {
+        lifeRecord(life);
+    }
+}
+
+// Hand the row-major board to the engine keeping its own copy of it
+//    Param: (Life*) life (The Life)
+static void lifeReload(Life *life)
+{
+    life->boardStale = 0;
+    switch (life->engine)
+    {
+    case DOMAIN_ENGINE:
+        if (domainScatter(life->domain, life->currentBoard) != 0)
+        {
+            lifeDomainFailed(life);
+        }
+        break;
+    case TILE_ENGINE:
+        tileSchedulerReset(life->scheduler);
+        break;
+    case ZORDER_ENGINE:
+        zboardLoad(life->zboard, life->currentBoard);
+        break;
+    case CHANGELIST_ENGINE:
+        changeListLoad(life->changeList, life->currentBoard);
+        break;
+    case GROWING_ENGINE:
+        growBoardLoad(life->growBoard, life->currentBoard);
+        break;
+    default:
+        break;
+    }
+    life->borrowedStale = 1;
+}
+
+/* --------------------------------- Life API -------------------------------- */
+void lifeDefaultOptions(LifeOptions *options)
+{
+    options->engine = GENERIC_ENGINE;
+    options->processes = 1;
+    options->transport = SHARED_MEMORY;
+    options->threads = 1;
+    options->tileSize = 0;
+    options->depth = 0;
+    options->pages = ARENA_NORMAL_PAGES;
+    options->interval = HISTORY_DEFAULT_INTERVAL;
+    options->historyMegabytes = 0;
+    options->keepSeries = 0;
+    options->pinning = NUMA_PIN_NONE;
+    options->counters = 0;
+    ltlParseRule(LTL_CONWAY, &options->rule);
+    options->growLimit = GROW_DEFAULT_LIMIT;
+}
+
+LifeOptions *lifeOptionsCreate(void)
+{
+    LifeOptions *options = (LifeOptions *)malloc(sizeof(LifeOptions));
+    if (options != NULL)
+    {
+        lifeDefaultOptions(options);
+    }
+    return options;
+}
+
+LifeOptions *lifeOptionsCopy(LifeOptions *options)
+{
+    LifeOptions *copy = (LifeOptions *)malloc(sizeof(LifeOptions));
+    if (copy != NULL)
+    {
+        *copy = *options;
+    }
+    return copy;
+}
+
+void lifeOptionsFree(LifeOptions *options)
+{
+    free(options);
+}
+
+void lifeOptionsSetEngine(LifeOptions *options, LifeEngine engine)
+{
+    options->engine = engine;
+}
+
+LifeEngine lifeOptionsEngine(LifeOptions *options)
+{
+    return options->engine;
+}
+
+void lifeOptionsSetProcesses(LifeOptions *options, int processes)
+{
+    options->processes = processes;
+}
+
+void lifeOptionsSetTransport(LifeOptions *options, int transport)
+{
+    options->transport = (DomainTransport)transport;
+}
+
+void lifeOptionsSetThreads(LifeOptions *options, int threads)
+{
+    options->threads = threads;
+}
+
+void lifeOptionsSetTileSize(LifeOptions *options, int tileSize)
+{
+    options->tileSize = tileSize;
+}
+
+void lifeOptionsSetDepth(LifeOptions *options, int depth)
+{
+    options->depth = depth;
+}
+
+void lifeOptionsSetPages(LifeOptions *options, int pages)
+{
+    options->pages = (ArenaPages)pages;
+}
+
+void lifeOptionsSetHistory(LifeOptions *options, int megabytes)
+{
+    options->historyMegabytes = megabytes;
+}
+
+void lifeOptionsSetInterval(LifeOptions *options, int interval)
+{
+    options->interval = interval;
+}
+
+int lifeOptionsInterval(LifeOptions *options)
+{
+    return options->interval;
+}
+
+void lifeOptionsSetSeries(LifeOptions *options, int keep)
+{
+    options->keepSeries = keep;
+}
+
+void lifeOptionsSetPinning(LifeOptions *options, int pinning)
+{
+    options->pinning = (NumaPinning)pinning;
+}
+
+void lifeOptionsSetCounters(LifeOptions *options, int counters)
+{
+    options->counters = counters;
+}
+
+int lifeOptionsSetRule(LifeOptions *options, const char *rule)
+{
+    LtlRule parsed;
+    if (ltlParseRule(rule, &parsed) != 0)
+    {
+        return -1;
+    }
+    options->rule = parsed;
+    return 0;
+}
+
+void lifeOptionsSetGrowLimit(LifeOptions *options, int limit)
+{
+    options->growLimit = limit;
+}
+
+Life *lifeCreate(int HEIGHT, int WIDTH, LifeOptions *options)
+{
+    if (HEIGHT < 1 || WIDTH < 1)
+    {
+        return NULL;
+    }
+
+    Life *life = (Life *)calloc(1, sizeof(Life));
+    if (life == NULL)
+    {
+        return NULL;
+    }
+
+    life->HEIGHT = HEIGHT;
+    life->WIDTH = WIDTH;
+    life->options = *options;
+    life->engine = options->engine;
+
+    // Opened before any worker thread or process starts, so that all of them inherit the counters
+    if (options->counters)
+    {
+        life->counters = perfCountersOpen();
+    }
+
+    // A fresh arena hands out dead boards, the in-place engine only needs one board and a window of two rows
+    size_t windowSize = 2 * (((size_t)WIDTH * sizeof(int) + ARENA_CACHE_LINE - 1) / ARENA_CACHE_LINE + 1) * ARENA_CACHE_LINE;
+    size_t capacity = life->engine == INPLACE_ENGINE ? arenaBoardSize(HEIGHT, WIDTH) + windowSize : 2 * arenaBoardSize(HEIGHT, WIDTH);
+    life->arena = arenaCreate(capacity, options->pages);
+    if (life->arena == NULL)
+    {
+        perfCountersClose(life->counters);
+        free(life);
+        return NULL;
+    }
+    life->currentBoard = arenaBoardAllocate(life->arena, HEIGHT, WIDTH);
+    if (life->engine == INPLACE_ENGINE)
+    {
+        life->window[0] = (int *)arenaAllocate(life->arena, (size_t)WIDTH * sizeof(int), ARENA_CACHE_LINE);
+        life->window[1] = (int *)arenaAllocate(life->arena, (size_t)WIDTH * sizeof(int), ARENA_CACHE_LINE);
+    }
+    else
+    {
+        life->nextBoard = arenaBoardAllocate(life->arena, HEIGHT, WIDTH);
+    }
+
+    // The Cells are not touched yet: the threads of the tile scheduler touch the tiles they will
+    // calculate before the board is written, so each tile is placed on the NUMA node calculating it
+    if (life->engine == TILE_ENGINE)
+    {
+        life->scheduler = tileSchedulerCreate(HEIGHT, WIDTH, options->threads, options->tileSize, options->pinning);
+        if (life->scheduler != NULL)
+        {
+            tileSchedulerFirstTouch(life->scheduler, life->currentBoard, life->nextBoard);
+        }
+    }
+
+    if (options->keepSeries)
+    {
+        life->recorder.series = statsSeriesCreate();
+    }
+    statsReset(&life->recorder.last, 0);
+
+    return life;
+}
+
+int lifeReadSize(char *fileName, int *HEIGHT, int *WIDTH)
+{
+    FILE *board = fopen(fileName, "rb");
+    if (board == NULL)
+    {
+        return -1;
+    }
+
+    int read = fread(HEIGHT, sizeof(int), 1, board) == 1 && fread(WIDTH, sizeof(int), 1, board) == 1;
+    fclose(board);
+
+    return read && *HEIGHT > 0 && *WIDTH > 0 ? 0 : -1;
+}
+
+int lifeLoad(Life *life, char *fileName)
+{
+    FILE *board = fopen(fileName, "rb");
+    if (board == NULL)
+    {
+        return -1;
+    }
+
+    // The whole file is read before the board is touched, so a file of another size or cut short leaves it as it was
+    int HEIGHT, WIDTH;
+    size_t cells = (size_t)life->HEIGHT * life->WIDTH;
+    int *loaded = (int *)malloc(cells * sizeof(int));
+    int read = loaded != NULL && fread(&HEIGHT, sizeof(int), 1, board) == 1 && fread(&WIDTH, sizeof(int), 1, board) == 1 &&
+               HEIGHT == life->HEIGHT && WIDTH == life->WIDTH && fread(loaded, sizeof(int), cells, board) == cells;
+
+    // The growing board also reads the live Cells outside of the board that may follow, the other engines only the board
+    int count = 0;
+    int *outside = NULL;
+    if (read && life->engine == GROWING_ENGINE && fread(&count, sizeof(int), 1, board) == 1)
+    {
+        outside = count > 0 ? (int *)malloc((size_t)count * 2 * sizeof(int)) : NULL;
+        read = count == 0 || (count > 0 && outside != NULL && fread(outside, sizeof(int), (size_t)count * 2, board) == (size_t)count * 2);
+    }
+    fclose(board);
+
+    // Once started, the plane takes them now, unless they do not fit its limit
+    if (read && life->growBoard != NULL && life->engine == GROWING_ENGINE)
+    {
+        read = growBoardLoadPlane(life->growBoard, outside, count) == 0;
+    }
+
+    if (!read)
+    {
+        free(outside);
+        free(loaded);
+        return -1;
+    }
+
+    if (life->engine == GROWING_ENGINE)
+    {
+        free(life->outside);
+        life->outside = outside;
+        life->outsideCount = count;
+        life->outsideCapacity = count;
+    }
+
+    life->boardStale = 0;
+    for (int i = 0; i < life->HEIGHT; i++)
+    {
+        memcpy(life->currentBoard[i], loaded + (size_t)i * life->WIDTH, life->WIDTH * sizeof(int));
+    }
+    free(loaded);
+
+    lifeBoardChanged(life);
+    return 0;
+}
+
+int lifeSave(Life *life, char *fileName)
+{
+    FILE *board = fopen(fileName, "wb");
+    if (board == NULL)
+    {
+        return -1;
+    }
+
+    lifeStoreBoard(life);
+    fwrite(&life->HEIGHT, sizeof(int), 1, board);
+    fwrite(&life->WIDTH, sizeof(int), 1, board);
+
+    for (int i = 0; i < life->HEIGHT; i++)
+    {
+        fwrite(life->currentBoard[i], sizeof(int), life->WIDTH, board);
+    }
+
+    // The growing board follows it with the live Cells outside of it
+    if (life->engine == GROWING_ENGINE)
+    {
+        if (lifeGatherOutside(life) != 0)
+        {
+            fclose(board);
+            return -1;
+        }
+        int count = (int)life->outsideCount;
+        fwrite(&count, sizeof(int), 1, board);
+        if (count > 0)
+        {
+            fwrite(life->outside, sizeof(int), (size_t)count * 2, board);
+        }
+    }
+
+    // A write that failed before the last flush is only seen in the error indicator of the stream
+    int failed = ferror(board);
+    return fclose(board) == 0 && !failed ? 0 : -1;
+}
+
+void lifeRandomize(Life *life)
+{
+    // The board is replaced as a whole, whatever the engine holds is forgotten
+    life->boardStale = 0;
+    for (int i = 0; i < life->HEIGHT; i++)
+    {
+        for (int j = 0; j < life->WIDTH; j++)
+        {
+            life->currentBoard[i][j] = rand() % 2;
+        }
+    }
+
+    lifeBoardChanged(life);
+}
+
+int lifeStart(Life *life)
+{
+    int started = 1;
+
+    if (life->started)
+    {
+        return life->engine == life->options.engine;
+    }
+
+    switch (life->engine)
+    {
+    case DOMAIN_ENGINE:
+        // Hand the board to the worker processes
+        life->domain = domainStart(life->HEIGHT, life->WIDTH, life->options.processes, life->options.transport, life->options.pinning, life->currentBoard);
+        started = life->domain != NULL;
+        break;
+    case TILE_ENGINE:
+        // Usually created with the boards already, see lifeCreate
+        if (life->scheduler == NULL)
+        {
+            life->scheduler = tileSchedulerCreate(life->HEIGHT, life->WIDTH, life->options.threads, life->options.tileSize, life->options.pinning);
+        }
+        started = life->scheduler != NULL;
+        break;
+    case TEMPORAL_ENGINE:
+        life->stepper = temporalStepperCreate(life->HEIGHT, life->WIDTH, life->options.depth);
+        started = life->stepper != NULL;
+        break;
+    case ZORDER_ENGINE:
+        life->zboard = zboardCreate(life->HEIGHT, life->WIDTH);
+        if (life->zboard != NULL)
+        {
+            zboardLoad(life->zboard, life->currentBoard);
+        }
+        started = life->zboard != NULL;
+        break;
+    case CHANGELIST_ENGINE:
+        life->changeList = changeListCreate(life->HEIGHT, life->WIDTH);
+        if (life->changeList != NULL)
+        {
+            changeListLoad(life->changeList, life->currentBoard);
+        }
+        started = life->changeList != NULL;
+        break;
+    case LARGER_ENGINE:
+        life->ltl = ltlStepperCreate(life->HEIGHT, life->WIDTH, &life->options.rule, life->options.threads);
+        started = life->ltl != NULL;
+        break;
+    case GROWING_ENGINE:
+        life->growBoard = growBoardCreate(life->HEIGHT, life->WIDTH, life->options.growLimit, life->options.pages);
+        if (life->growBoard != NULL)
+        {
+            // Cells of a board file past the limit can not live on the plane, the window is loaded all the same
+            growBoardLoadPlane(life->growBoard, life->outside, life->outsideCount);
+            growBoardLoad(life->growBoard, life->currentBoard);
+        }
+        started = life->growBoard != NULL;
+        break;
+    default:
+        break;
+    }
+
+    if (!started)
+    {
+        life->engine = GENERIC_ENGINE;
+    }
+    life->started = 1;
+    life->borrowedStale = 1;
+
+    // The starting board is the oldest one the history can go back to
+    if (life->options.historyMegabytes > 0)
+    {
+        life->history = historyCreate(life->HEIGHT, life->WIDTH, life->options.interval, (size_t)life->options.historyMegabytes * 1024 * 1024);
+        if (life->history != NULL)
+        {
+            lifeRecord(life);
+        }
+    }
+
+    return started;
+}
+
+void lifeStep(Life *life, int generations)
+{
+    if (!life->started)
+    {
+        lifeStart(life);
+    }
+
+    lifeAdvance(life, life->engine, generations);
+    life->borrowedStale = 1;
+}
+
+void lifeStepFastest(Life *life, int generations)
+{
+    if (!life->started)
+    {
+        lifeStart(life);
+    }
+
+    // Fixed-size boards and the other engines already have their fastest kernel
+    if (life->engine != GENERIC_ENGINE || fixedBoardSupports(life->HEIGHT, life->WIDTH))
+    {
+        lifeAdvance(life, life->engine, generations);
+        return;
+    }
+
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores > 1 && life->scheduler == NULL)
+    {
+        life->scheduler = tileSchedulerCreate(life->HEIGHT, life->WIDTH, (int)cores, 0, life->options.pinning);
+    }
+    else if (cores <= 1 && life->stepper == NULL)
+    {
+        life->stepper = temporalStepperCreate(life->HEIGHT, life->WIDTH, 0);
+    }
+
+    if (life->scheduler != NULL)
+    {
+        if (life->borrowedStale)
+        {
+            tileSchedulerReset(life->scheduler);
+            life->borrowedStale = 0;
+        }
+        lifeAdvance(life, TILE_ENGINE, generations);
+    }
+    else
+    {
+        lifeAdvance(life, life->stepper != NULL ? TEMPORAL_ENGINE : GENERIC_ENGINE, generations);
+    }
+}
+
+int lifeRewind(Life *life, int steps)
+{
+    GenerationStats stats;
+
+    if (life->history == NULL)
+    {
+        return 0;
+    }
+
+    steps = historyBack(life->history, steps, life->currentBoard, &stats);
+    if (steps == 0)
+    {
+        return 0;
+    }
+
+    // The Cells that had left the board come back with it, without memory for them those of now stay
+    if (life->engine == GROWING_ENGINE)
+    {
+        long count;
+        int *outside = historyOutside(life->history, &count);
+        growBoardLoadPlane(life->growBoard, outside, count);
+    }
+
+    // The generations after the board are calculated again from here on
+    life->recorder.generation = stats.generation;
+    life->recorder.last = stats;
+    if (life->recorder.series != NULL)
+    {
+        statsSeriesTruncate(life->recorder.series, stats.generation);
+    }
+
+    lifeReload(life);
+    if (life->publisher != NULL)
+    {
+        publisherPublish(life->publisher, life->currentBoard, &life->recorder.last);
+    }
+    return steps;
+}
+
+int lifePublish(Life *life, char *name, int every)
+{
+    publisherFree(life->publisher);
+    life->publisher = publisherCreate(name, life->HEIGHT, life->WIDTH);
+    life->publishEvery = every > 0 ? every : 1;
+    if (life->publisher == NULL)
+    {
+        return errno == EEXIST ? -2 : -1;
+    }
+
+    // Viewers attaching before the first step see the board as it is now
+    lifeStoreBoard(life);
+    publisherPublish(life->publisher, life->currentBoard, &life->recorder.last);
+    return 0;
+}
+
+int **lifeBoard(Life *life)
+{
+    lifeStoreBoard(life);
+    return life->currentBoard;
+}
+
+void lifeBoardChanged(Life *life)
+{
+    // Before the start the engine has no copy yet, and the history starts with the board it is started on
+    if (!life->started)
+    {
+        return;
+    }
+
+    // Cells set while the board of the Life was behind went straight to the engine
+    if (!life->boardStale)
+    {
+        lifeReload(life);
+    }
+    lifeStoreBoard(life);
+    if (life->history != NULL)
+    {
+        lifeRecord(life);
+    }
+    if (life->publisher != NULL)
+    {
+        publisherPublish(life->publisher, life->currentBoard, &life->recorder.last);
+    }
+}
+
+int lifeGetCell(Life *life, int r, int c)
+{
+    // A single Cell is read from the engine rather than storing the whole board
+    if (life->boardStale && life->engine == ZORDER_ENGINE)
+    {
+        return zboardGet(life->zboard, r, c);
+    }
+    return life->currentBoard[r][c] == 1;
+}
+
+void lifeSetCell(Life *life, int r, int c, int value)
+{
+    if (life->boardStale && life->engine == ZORDER_ENGINE)
+    {
+        zboardSet(life->zboard, r, c, value == 1);
+        return;
+    }
+    life->currentBoard[r][c] = value == 1;
+}
+
+void lifeExtent(Life *life, int *top, int *left, int *HEIGHT, int *WIDTH)
+{
+    if (life->engine == GROWING_ENGINE && life->growBoard != NULL)
+    {
+        growBoardExtent(life->growBoard, top, left, HEIGHT, WIDTH);
+        return;
+    }
+
+    *top = 0;
+    *left = 0;
+    *HEIGHT = life->HEIGHT;
+    *WIDTH = life->WIDTH;
+}
+
+void lifeCopyPlane(Life *life, int top, int left, int HEIGHT, int WIDTH, int **cells)
+{
+    if (life->engine == GROWING_ENGINE && life->growBoard != NULL)
+    {
+        growBoardCopy(life->growBoard, top, left, HEIGHT, WIDTH, cells);
+        return;
+    }
+
+    lifeStoreBoard(life);
+    for (int i = 0; i < HEIGHT; i++)
+    {
+        int r = top + i;
+        for (int j = 0; j < WIDTH; j++)
+        {
+            int c = left + j;
+            cells[i][j] = r >= 0 && r < life->HEIGHT && c >= 0 && c < life->WIDTH && life->currentBoard[r][c] == 1;
+        }
+    }
+}
+
+int lifeHeight(Life *life)
+{
+    return life->HEIGHT;
+}
+
+int lifeWidth(Life *life)
+{
+    return life->WIDTH;
+}
+
+long lifeGeneration(Life *life)
+{
+    return life->recorder.generation;
+}
+
+GenerationStats *lifeStats(Life *life)
+{
+    return &life->recorder.last;
+}
+
+StatsSeries *lifeSeries(Life *life)
+{
+    return life->recorder.series;
+}
+
+PerfCounters *lifeCounters(Life *life)
+{
+    return life->counters;
+}
+
+LifeEngine lifeEngine(Life *life)
+{
+    return life->engine;
+}
+
+const char *lifeEngineName(LifeEngine engine)
+{
+    switch (engine)
+    {
+    case DOMAIN_ENGINE:
+        return "worker processes";
+    case TILE_ENGINE:
+        return "tile scheduler";
+    case TEMPORAL_ENGINE:
+        return "temporal blocking";
+    case ZORDER_ENGINE:
+        return "Z-order tiles";
+    case INPLACE_ENGINE:
+        return "in place";
+    case CHANGELIST_ENGINE:
+        return "change list";
+    case LARGER_ENGINE:
+        return "Larger than Life";
+    case GROWING_ENGINE:
+        return "growing board";
+    default:
+        return "single process";
+    }
+}
+
+void lifeReport(Life *life, FILE *stream)
+{
+    // Load balance of the tile scheduler, to check how well the threads shared the work
+    if (life->engine == TILE_ENGINE && life->scheduler != NULL)
+    {
+        tileSchedulerReport(life->scheduler, stream);
+        tileSchedulerPlacement(life->scheduler, stream);
+    }
+
+    if (life->engine == CHANGELIST_ENGINE)
+    {
+        changeListReport(life->changeList, stream);
+    }
+
+    if (life->engine == LARGER_ENGINE)
+    {
+        ltlStepperReport(life->ltl, stream);
+    }
+
+    if (life->engine == GROWING_ENGINE)
+    {
+        growBoardReport(life->growBoard, stream);
+    }
+
+    if (life->counters != NULL)
+    {
+        perfCountersReport(life->counters, stream);
+    }
+}
+
+void lifeFree(Life *life)
+{
+    if (life == NULL)
+    {
+        return;
+    }
+
+    domainStop(life->domain);
+    tileSchedulerFree(life->scheduler);
+    temporalStepperFree(life->stepper);
+    zboardFree(life->zboard);
+    changeListFree(life->changeList);
+    ltlStepperFree(life->ltl);
+    growBoardFree(life->growBoard);
+    free(life->outside);
+    historyFree(life->history);
+    publisherFree(life->publisher);
+    perfCountersClose(life->counters);
+    statsSeriesFree(life->recorder.series);
+    arenaFree(life->arena);
+    free(life);
+}
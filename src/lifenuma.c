@@ -0,0 +1,207 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <lifenuma.h>
+
+/* -------------------------------------------------------------------------- */
+/*          NUMA topology, thread pinning and placement of the board          */
+/* -------------------------------------------------------------------------- */
+
+// Nodes looked for in /sys, more than any machine the game runs on
+#define NUMA_MAX_NODES 64
+
+/* ---------------------------- Topology of the Machine ---------------------- */
+// CPUs the process may run on, grouped by node.
+struct NumaTopology
+{
+    int nodes;
+    int nodeIds[NUMA_MAX_NODES];
+    int nodeFirst[NUMA_MAX_NODES + 1];
+    int *cpus;
+    int cpuCount;
+};
+typedef struct NumaTopology NumaTopology;
+
+static NumaTopology topology;
+static pthread_once_t topologyOnce = PTHREAD_ONCE_INIT;
+
+// Read the CPUs of a node from /sys, keeping those the process may run on
+//    Param: (int) node (Id of the node)
+//           (cpu_set_t*) allowed (CPUs the process may run on, those taken are removed)
+//    Return: (int) Number of CPUs added to the topology
+static int numaReadNode(int node, cpu_set_t *allowed)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+    {
+        return 0;
+    }
+
+    // A list of ranges: "0-7,16-23"
+    int added = 0, from, to;
+    while (fscanf(file, "%d", &from) == 1)
+    {
+        to = from;
+        int separator = fgetc(file);
+        if (separator == '-')
+        {
+            if (fscanf(file, "%d", &to) != 1)
+            {
+                break;
+            }
+            separator = fgetc(file);
+        }
+
+        for (int cpu = from; cpu <= to && cpu < CPU_SETSIZE; cpu++)
+        {
+            if (CPU_ISSET(cpu, allowed))
+            {
+                CPU_CLR(cpu, allowed);
+                topology.cpus[topology.cpuCount++] = cpu;
+                added++;
+            }
+        }
+
+        if (separator != ',')
+        {
+            break;
+        }
+    }
+
+    fclose(file);
+    return added;
+}
+
+// Read the topology, once per process
+static void numaReadTopology()
+{
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+    {
+        CPU_ZERO(&allowed);
+        CPU_SET(0, &allowed);
+    }
+
+    topology.cpus = (int *)malloc(CPU_SETSIZE * sizeof(int));
+    if (topology.cpus == NULL)
+    {
+        return;
+    }
+
+    for (int node = 0; node < NUMA_MAX_NODES; node++)
+    {
+        topology.nodeFirst[topology.nodes] = topology.cpuCount;
+        if (numaReadNode(node, &allowed) > 0)
+        {
+            topology.nodeIds[topology.nodes++] = node;
+        }
+    }
+
+    // Without /sys (or for CPUs it does not list), everything left is one more node
+    topology.nodeFirst[topology.nodes] = topology.cpuCount;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+    {
+        if (CPU_ISSET(cpu, &allowed))
+        {
+            topology.cpus[topology.cpuCount++] = cpu;
+        }
+    }
+    if (topology.cpuCount > topology.nodeFirst[topology.nodes])
+    {
+        topology.nodeIds[topology.nodes] = topology.nodes == 0 ? 0 : -1;
+        topology.nodes++;
+    }
+    topology.nodeFirst[topology.nodes] = topology.cpuCount;
+}
+
+/* --------------------------------- NUMA API -------------------------------- */
+int numaNodes()
+{
+    pthread_once(&topologyOnce, numaReadTopology);
+    return topology.nodes > 0 ? topology.nodes : 1;
+}
+
+int numaPin(int index, int count, NumaPinning pinning)
+{
+    pthread_once(&topologyOnce, numaReadTopology);
+    if (pinning == NUMA_PIN_NONE || topology.nodes == 0 || count < 1)
+    {
+        return -1;
+    }
+
+    // Contiguous blocks of workers per node, then the workers of a node take its CPUs in turn
+    int node = (int)((long)index * topology.nodes / count);
+    int firstOfNode = (int)(((long)node * count + topology.nodes - 1) / topology.nodes);
+    int cpusOfNode = topology.nodeFirst[node + 1] - topology.nodeFirst[node];
+    int cpu = topology.cpus[topology.nodeFirst[node] + (index - firstOfNode) % cpusOfNode];
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (pinning == NUMA_PIN_CORES)
+    {
+        CPU_SET(cpu, &set);
+    }
+    else
+    {
+        for (int k = topology.nodeFirst[node]; k < topology.nodeFirst[node + 1]; k++)
+        {
+            CPU_SET(topology.cpus[k], &set);
+        }
+    }
+
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+    {
+        return -1;
+    }
+    return pinning == NUMA_PIN_CORES ? cpu : topology.nodeIds[node];
+}
+
+int numaCurrentNode()
+{
+#ifdef SYS_getcpu
+    unsigned int cpu, node;
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0)
+    {
+        return (int)node;
+    }
+#endif
+    return -1;
+}
+
+int numaNodeOfAddress(void *address)
+{
+#ifdef SYS_move_pages
+    // Without target nodes, move_pages only reports where the pages are
+    long pageSize = sysconf(_SC_PAGESIZE);
+    void *page = (void *)((unsigned long)address & ~(unsigned long)(pageSize - 1));
+    int status = -1;
+    if (syscall(SYS_move_pages, 0, 1UL, &page, NULL, &status, 0) == 0 && status >= 0)
+    {
+        return status;
+    }
+#else
+    (void)address;
+#endif
+    return -1;
+}
+
+const char *numaPinningName(NumaPinning pinning)
+{
+    switch (pinning)
+    {
+    case NUMA_PIN_CORES:
+        return "cores";
+    case NUMA_PIN_NODES:
+        return "nodes";
+    default:
+        return "none";
+    }
+}
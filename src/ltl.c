@@ -0,0 +1,636 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+#include <pthread.h>
+#include <time.h>
+#include <ltl.h>
+
+/* -------------------------------------------------------------------------- */
+/*     Larger than Life: radius-R rules counted from a summed-area table      */
+/* -------------------------------------------------------------------------- */
+
+// Size of a cache line, rows of the table and per-thread data start on their own lines
+#define LTL_CACHE_LINE 64
+
+// Entries of the table in a cache line, the columns shared between threads are multiples of it
+#define LTL_LINE_ENTRIES (LTL_CACHE_LINE / (int)sizeof(uint32_t))
+
+// Entries of the table added or subtracted at once
+#define LTL_LANES 4
+
+// Four entries of the table, loaded from any entry (GCC vector extension, SSE2 or NEON underneath)
+typedef uint32_t LtlVector __attribute__((vector_size(LTL_LANES * sizeof(uint32_t)), aligned(sizeof(uint32_t))));
+
+/* -------------------- Data Structures of the LtL Stepper ------------------- */
+// Enum for the phases of a generation: the sums along the rows of the board, the sums down the
+// columns of the table, then the rule applied to the rows of the board.
+enum LtlPhase
+{
+    LTL_ROWS = 1,
+    LTL_COLUMNS = 2,
+    LTL_RULE = 3,
+    LTL_QUIT = 4
+};
+typedef enum LtlPhase LtlPhase;
+
+struct LtlWorker
+{
+    _Alignas(LTL_CACHE_LINE) LtlStepper *stepper;
+    int index;
+    pthread_t thread;
+
+    // Rows of the board summed and calculated, columns of the table summed down
+    int firstRow;
+    int lastRow;
+    int firstColumn;
+    int lastColumn;
+
+    // Counts of the squares around the Cells of the row being calculated
+    uint32_t *counts;
+    GenerationStats stats;
+};
+typedef struct LtlWorker LtlWorker;
+
+struct LtlStepper
+{
+    int HEIGHT;
+    int WIDTH;
+    LtlRule rule;
+    int threads;
+
+    // (HEIGHT + 1) rows of (WIDTH + 1) entries, row 0 and column 0 are always 0
+    uint32_t *table;
+    size_t stride;
+
+    int **currentBoard;
+    LtlPhase phase;
+    pthread_barrier_t start;
+    pthread_barrier_t finish;
+    LtlWorker *workers;
+
+    // Held while the threads are created, so that none waits at start before all of them exist
+    pthread_mutex_t launch;
+    int launched;
+
+    long generations;
+    double tableSeconds;
+    double ruleSeconds;
+};
+
+// A rule known by name, and how Golly writes it.
+struct LtlNamedRule
+{
+    const char *name;
+    const char *rule;
+};
+typedef struct LtlNamedRule LtlNamedRule;
+
+static LtlNamedRule namedRules[] = {
+    {"conway", LTL_CONWAY},
+    {"bosco", "R5,C0,M1,S34..58,B34..45,NM"},
+    {"majority", "R4,C0,M1,S41..81,B41..81,NM"},
+    {NULL, NULL}};
+
+/* ------------------------- Utilities of the LtL Stepper -------------------- */
+// Read a monotonic clock
+//    Return: (double) Time in seconds
+static double ltlClock()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+// Row of the summed-area table
+//    Param: (LtlStepper*) stepper (The stepper)
+//           (int) i (Row of the table, 0 to HEIGHT)
+//    Return: (uint32_t*) The row, entry j holding the live Cells of the rows above i and columns left of j
+static uint32_t *ltlTableRow(LtlStepper *stepper, int i)
+{
+    return stepper->table + (size_t)i * stepper->stride;
+}
+
+// Read a range of counts, as "a..b" or a single "a"
+//    Param: (string) text (The range)
+//           (int*) min (Receives the start of the range)
+//           (int*) max (Receives the end of the range)
+//    Return: (int) 0 on success, -1 if the text is not a range
+static int ltlParseRange(const char *text, int *min, int *max)
+{
+    int used = 0;
+
+    if (sscanf(text, "%d..%d%n", min, max, &used) == 2 && text[used] == '\0')
+    {
+        return 0;
+    }
+    if (sscanf(text, "%d%n", min, &used) == 1 && text[used] == '\0')
+    {
+        *max = *min;
+        return 0;
+    }
+    return -1;
+}
+
+// Sum the Cells of a row of the board from the left into its row of the table
+//    Param: (LtlStepper*) stepper (The stepper)
+//           (int) i (Row of the board)
+static void ltlSumRow(LtlStepper *stepper, int i)
+{
+    int *cells = stepper->currentBoard[i];
+    uint32_t *out = ltlTableRow(stepper, i + 1) + 1;
+    uint32_t sum = 0;
+
+    for (int j = 0; j < stepper->WIDTH; j++)
+    {
+        sum += cells[j] == 1;
+        out[j] = sum;
+    }
+}
+
+// Add the row above to a row of the table, over a range of columns
+// Columns are independent of each other, so whole vectors of them are added at once
+//    Param: (uint32_t*) row (Row of the table, summed along the row)
+//           (uint32_t*) above (Row above, already summed down)
+//           (int) first (First column)
+//           (int) last (Column after the last one)
+static void ltlSumDown(uint32_t *row, const uint32_t *above, int first, int last)
+{
+    int j = first;
+
+    for (; j + LTL_LANES <= last; j += LTL_LANES)
+    {
+        *(LtlVector *)(row + j) += *(const LtlVector *)(above + j);
+    }
+    for (; j < last; j++)
+    {
+        row[j] += above[j];
+    }
+}
+
+// Count the live Cells in the square around a Cell near the left or right edge, clipped to the board
+//    Param: (uint32_t*) top (Row of the table above the square)
+//           (uint32_t*) bottom (Row of the table below the square)
+//           (int) j (Column of the Cell)
+//           (int) R (Radius of the square)
+//           (int) WIDTH (WIDTH of Board)
+//    Return: (uint32_t) The live Cells in the square
+static uint32_t ltlClippedCount(const uint32_t *top, const uint32_t *bottom, int j, int R, int WIDTH)
+{
+    int left = j - R > 0 ? j - R : 0;
+    int right = j + R + 1 < WIDTH ? j + R + 1 : WIDTH;
+    return bottom[right] - top[right] - bottom[left] + top[left];
+}
+
+// Count the live Cells in the square around every Cell of a row, from the table
+// Four entries give a square; away from the left and right edges the squares do not need clipping,
+// and their counts are calculated a vector at a time
+//    Param: (LtlStepper*) stepper (The stepper)
+//           (int) i (Row of the board)
+//           (uint32_t*) counts (Receives the count of every Cell of the row)
+static void ltlCountRow(LtlStepper *stepper, int i, uint32_t *counts)
+{
+    int R = stepper->rule.radius;
+    int WIDTH = stepper->WIDTH;
+    const uint32_t *top = ltlTableRow(stepper, i - R > 0 ? i - R : 0);
+    const uint32_t *bottom = ltlTableRow(stepper, i + R + 1 < stepper->HEIGHT ? i + R + 1 : stepper->HEIGHT);
+
+    // Columns whose square lies within the board: j - R >= 0 and j + R + 1 <= WIDTH
+    int inner = R;
+    int outer = WIDTH - R;
+    if (outer < inner)
+    {
+        inner = outer = WIDTH;
+    }
+
+    for (int j = 0; j < inner; j++)
+    {
+        counts[j] = ltlClippedCount(top, bottom, j, R, WIDTH);
+    }
+    for (int j = outer; j < WIDTH; j++)
+    {
+        counts[j] = ltlClippedCount(top, bottom, j, R, WIDTH);
+    }
+
+    // Entries may have wrapped around on huge boards, the differences are still right modulo 2^32
+    int j = inner;
+    for (; j + LTL_LANES <= outer; j += LTL_LANES)
+    {
+        LtlVector sum = *(const LtlVector *)(bottom + j + R + 1) - *(const LtlVector *)(top + j + R + 1) - *(const LtlVector *)(bottom + j - R) + *(const LtlVector *)(top + j - R);
+        *(LtlVector *)(counts + j) = sum;
+    }
+    for (; j < outer; j++)
+    {
+        counts[j] = bottom[j + R + 1] - top[j + R + 1] - bottom[j - R] + top[j - R];
+    }
+}
+
+// Apply the rule to a row of the board, in place: the table holds everything the rule needs
+//    Param: (LtlWorker*) worker (The worker calculating the row)
+//           (int) i (Row of the board)
+static void ltlRuleRow(LtlWorker *worker, int i)
+{
+    LtlStepper *stepper = worker->stepper;
+    LtlRule *rule = &stepper->rule;
+    uint32_t *counts = worker->counts;
+    int *cells = stepper->currentBoard[i];
+    int first = -1;
+    int last = -1;
+
+    ltlCountRow(stepper, i, counts);
+
+    // Ranges are checked with one unsigned comparison each
+    uint32_t survivalSpan = (uint32_t)(rule->survivalMax - rule->survivalMin);
+    uint32_t birthSpan = (uint32_t)(rule->birthMax - rule->birthMin);
+
+    for (int j = 0; j < stepper->WIDTH; j++)
+    {
+        int alive = cells[j] == 1;
+        uint32_t count = counts[j] - (uint32_t)(alive & !rule->middle);
+        int cell = alive ? count - (uint32_t)rule->survivalMin <= survivalSpan : count - (uint32_t)rule->birthMin <= birthSpan;
+        cells[j] = cell;
+
+        worker->stats.population += cell;
+        worker->stats.births += cell & !alive;
+        worker->stats.deaths += alive & !cell;
+        if (cell)
+        {
+            first = first < 0 ? j : first;
+            last = j;
+        }
+    }
+
+    if (first >= 0)
+    {
+        statsIncludeRun(&worker->stats, i, first, last);
+    }
+}
+
+// Run one phase of a generation on the share of a worker
+//    Param: (LtlWorker*) worker (The worker)
+static void ltlRunPhase(LtlWorker *worker)
+{
+    LtlStepper *stepper = worker->stepper;
+
+    switch (stepper->phase)
+    {
+    case LTL_ROWS:
+        for (int i = worker->firstRow; i < worker->lastRow; i++)
+        {
+            ltlSumRow(stepper, i);
+        }
+        break;
+    case LTL_COLUMNS:
+        for (int i = 1; i <= stepper->HEIGHT; i++)
+        {
+            ltlSumDown(ltlTableRow(stepper, i), ltlTableRow(stepper, i - 1), worker->firstColumn, worker->lastColumn);
+        }
+        break;
+    case LTL_RULE:
+        statsReset(&worker->stats, 0);
+        for (int i = worker->firstRow; i < worker->lastRow; i++)
+        {
+            ltlRuleRow(worker, i);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+// Body of a helper thread: wait for a phase, run it, report back
+//    Param: (void*) argument (The LtlWorker of the thread)
+static void *ltlWorkerThread(void *argument)
+{
+    LtlWorker *worker = (LtlWorker *)argument;
+    LtlStepper *stepper = worker->stepper;
+
+    // A thread that could not be created leaves the others to quit before the first phase
+    pthread_mutex_lock(&stepper->launch);
+    pthread_mutex_unlock(&stepper->launch);
+    if (!stepper->launched)
+    {
+        return NULL;
+    }
+
+    while (1)
+    {
+        pthread_barrier_wait(&stepper->start);
+        if (stepper->phase == LTL_QUIT)
+        {
+            break;
+        }
+        ltlRunPhase(worker);
+        pthread_barrier_wait(&stepper->finish);
+    }
+
+    return NULL;
+}
+
+// Run one phase on every thread, the calling thread being worker 0
+//    Param: (LtlStepper*) stepper (The stepper)
+//           (LtlPhase) phase (The phase to run)
+static void ltlDispatch(LtlStepper *stepper, LtlPhase phase)
+{
+    stepper->phase = phase;
+    pthread_barrier_wait(&stepper->start);
+    ltlRunPhase(&stepper->workers[0]);
+    pthread_barrier_wait(&stepper->finish);
+}
+
+// Build the summed-area table of the board
+//    Param: (LtlStepper*) stepper (The stepper)
+static void ltlBuildTable(LtlStepper *stepper)
+{
+    if (stepper->threads > 1)
+    {
+        ltlDispatch(stepper, LTL_ROWS);
+        ltlDispatch(stepper, LTL_COLUMNS);
+        return;
+    }
+
+    // On one thread, every row is summed down while it is still in the cache
+    for (int i = 0; i < stepper->HEIGHT; i++)
+    {
+        ltlSumRow(stepper, i);
+        ltlSumDown(ltlTableRow(stepper, i + 1), ltlTableRow(stepper, i), 1, stepper->WIDTH + 1);
+    }
+}
+
+/* ------------------------------ LtL Stepper API ---------------------------- */
+int ltlParseRule(const char *text, LtlRule *rule)
+{
+    for (int n = 0; namedRules[n].name != NULL; n++)
+    {
+        if (strcasecmp(text, namedRules[n].name) == 0)
+        {
+            text = namedRules[n].rule;
+            break;
+        }
+    }
+
+    char copy[128];
+    if (strlen(text) >= sizeof(copy))
+    {
+        return -1;
+    }
+    strcpy(copy, text);
+
+    LtlRule parsed = {0, 0, -1, -1, -1, -1};
+    int states = 0;
+    int used;
+
+    for (char *field = strtok(copy, ","); field != NULL; field = strtok(NULL, ","))
+    {
+        switch (field[0])
+        {
+        case 'R':
+            if (sscanf(field + 1, "%d%n", &parsed.radius, &used) != 1 || field[1 + used] != '\0')
+            {
+                return -1;
+            }
+            break;
+        case 'C':
+            if (sscanf(field + 1, "%d%n", &states, &used) != 1 || field[1 + used] != '\0')
+            {
+                return -1;
+            }
+            break;
+        case 'M':
+            if (strcmp(field + 1, "0") != 0 && strcmp(field + 1, "1") != 0)
+            {
+                return -1;
+            }
+            parsed.middle = field[1] == '1';
+            break;
+        case 'S':
+            if (ltlParseRange(field + 1, &parsed.survivalMin, &parsed.survivalMax) != 0)
+            {
+                return -1;
+            }
+            break;
+        case 'B':
+            if (ltlParseRange(field + 1, &parsed.birthMin, &parsed.birthMax) != 0)
+            {
+                return -1;
+            }
+            break;
+        case 'N':
+            // Only the square (Moore) neighbourhood is a rectangle of the table
+            if (strcmp(field + 1, "M") != 0)
+            {
+                return -1;
+            }
+            break;
+        default:
+            return -1;
+        }
+    }
+
+    // Rules with more than two states (Generations) are not supported
+    int cells = (2 * parsed.radius + 1) * (2 * parsed.radius + 1);
+    if (parsed.radius < 1 || parsed.radius > LTL_MAX_RADIUS || (states != 0 && states != 2) ||
+        parsed.survivalMin < 0 || parsed.survivalMin > parsed.survivalMax || parsed.survivalMax > cells ||
+        parsed.birthMin < 0 || parsed.birthMin > parsed.birthMax || parsed.birthMax > cells)
+    {
+        return -1;
+    }
+
+    *rule = parsed;
+    return 0;
+}
+
+void ltlFormatRule(LtlRule *rule, char *text, size_t size)
+{
+    snprintf(text, size, "R%d,C0,M%d,S%d..%d,B%d..%d,NM", rule->radius, rule->middle, rule->survivalMin, rule->survivalMax, rule->birthMin, rule->birthMax);
+}
+
+// Give a thread its band of rows, and its band of columns starting on a cache line
+//    Param: (LtlStepper*) stepper (The stepper)
+//           (LtlWorker*) worker (The worker of the thread)
+static void ltlPartition(LtlStepper *stepper, LtlWorker *worker)
+{
+    int lines = (stepper->WIDTH + LTL_LINE_ENTRIES) / LTL_LINE_ENTRIES;
+    int w = worker->index;
+
+    worker->firstRow = (int)((long)stepper->HEIGHT * w / stepper->threads);
+    worker->lastRow = (int)((long)stepper->HEIGHT * (w + 1) / stepper->threads);
+    worker->firstColumn = (int)((long)lines * w / stepper->threads) * LTL_LINE_ENTRIES;
+    worker->lastColumn = (int)((long)lines * (w + 1) / stepper->threads) * LTL_LINE_ENTRIES;
+    worker->firstColumn = worker->firstColumn < 1 ? 1 : worker->firstColumn;
+    worker->lastColumn = worker->lastColumn > stepper->WIDTH + 1 ? stepper->WIDTH + 1 : worker->lastColumn;
+}
+
+LtlStepper *ltlStepperCreate(int HEIGHT, int WIDTH, LtlRule *rule, int threads)
+{
+    LtlStepper *stepper = (LtlStepper *)calloc(1, sizeof(LtlStepper));
+    if (stepper == NULL)
+    {
+        return NULL;
+    }
+
+    stepper->HEIGHT = HEIGHT;
+    stepper->WIDTH = WIDTH;
+    stepper->rule = *rule;
+    stepper->threads = threads < 1 ? 1 : threads;
+
+    // Rows start on a cache line, row 0 and column 0 stay 0 forever
+    stepper->stride = (((size_t)WIDTH + 1 + LTL_LINE_ENTRIES - 1) / LTL_LINE_ENTRIES) * LTL_LINE_ENTRIES;
+    size_t tableSize = stepper->stride * (HEIGHT + 1) * sizeof(uint32_t);
+    stepper->table = (uint32_t *)aligned_alloc(LTL_CACHE_LINE, tableSize);
+    stepper->workers = (LtlWorker *)aligned_alloc(LTL_CACHE_LINE, ((sizeof(LtlWorker) * stepper->threads + LTL_CACHE_LINE - 1) / LTL_CACHE_LINE) * LTL_CACHE_LINE);
+    if (stepper->table == NULL || stepper->workers == NULL)
+    {
+        free(stepper->table);
+        free(stepper->workers);
+        free(stepper);
+        return NULL;
+    }
+    memset(stepper->table, 0, tableSize);
+    memset(stepper->workers, 0, sizeof(LtlWorker) * stepper->threads);
+
+    // Every thread sums and calculates a band of rows, and sums down a band of columns
+    int failed = 0;
+    for (int w = 0; w < stepper->threads; w++)
+    {
+        LtlWorker *worker = &stepper->workers[w];
+        worker->stepper = stepper;
+        worker->index = w;
+        ltlPartition(stepper, worker);
+        worker->counts = (uint32_t *)malloc((size_t)WIDTH * sizeof(uint32_t));
+        failed |= worker->counts == NULL;
+    }
+    if (failed)
+    {
+        for (int w = 0; w < stepper->threads; w++)
+        {
+            free(stepper->workers[w].counts);
+        }
+        free(stepper->table);
+        free(stepper->workers);
+        free(stepper);
+        return NULL;
+    }
+
+    if (stepper->threads > 1)
+    {
+        pthread_barrier_init(&stepper->start, NULL, stepper->threads);
+        pthread_barrier_init(&stepper->finish, NULL, stepper->threads);
+        pthread_mutex_init(&stepper->launch, NULL);
+
+        // The calling thread is worker 0, the others get threads of their own
+        pthread_mutex_lock(&stepper->launch);
+        int created = 1;
+        while (created < stepper->threads && pthread_create(&stepper->workers[created].thread, NULL, ltlWorkerThread, &stepper->workers[created]) == 0)
+        {
+            created++;
+        }
+        stepper->launched = created == stepper->threads;
+        pthread_mutex_unlock(&stepper->launch);
+
+        // Without all of its threads, the calling thread calculates the whole board alone
+        if (!stepper->launched)
+        {
+            for (int w = 1; w < created; w++)
+            {
+                pthread_join(stepper->workers[w].thread, NULL);
+            }
+            for (int w = 1; w < stepper->threads; w++)
+            {
+                free(stepper->workers[w].counts);
+            }
+            pthread_barrier_destroy(&stepper->start);
+            pthread_barrier_destroy(&stepper->finish);
+            pthread_mutex_destroy(&stepper->launch);
+            stepper->threads = 1;
+            ltlPartition(stepper, &stepper->workers[0]);
+        }
+    }
+
+    return stepper;
+}
+
+void ltlStepperStep(LtlStepper *stepper, int generations, int **currentBoard, StatsRecorder *recorder)
+{
+    stepper->currentBoard = currentBoard;
+
+    for (int g = 0; g < generations; g++)
+    {
+        double begin = ltlClock();
+        ltlBuildTable(stepper);
+        double built = ltlClock();
+
+        if (stepper->threads > 1)
+        {
+            ltlDispatch(stepper, LTL_RULE);
+        }
+        else
+        {
+            stepper->phase = LTL_RULE;
+            ltlRunPhase(&stepper->workers[0]);
+        }
+
+        stepper->tableSeconds += built - begin;
+        stepper->ruleSeconds += ltlClock() - built;
+        stepper->generations++;
+
+        GenerationStats stats;
+        statsReset(&stats, 0);
+        for (int w = 0; w < stepper->threads; w++)
+        {
+            statsMerge(&stats, &stepper->workers[w].stats);
+        }
+        if (recorder != NULL)
+        {
+            statsRecord(recorder, &stats);
+        }
+    }
+}
+
+void ltlStepperReport(LtlStepper *stepper, FILE *stream)
+{
+    char rule[64];
+
+    ltlFormatRule(&stepper->rule, rule, sizeof(rule));
+    fprintf(stream, "Larger than Life %s on %d thread%s", rule, stepper->threads, stepper->threads > 1 ? "s" : "");
+    if (stepper->generations == 0)
+    {
+        fprintf(stream, ", no generation calculated\n");
+        return;
+    }
+
+    double total = stepper->tableSeconds + stepper->ruleSeconds;
+    fprintf(stream, ": %ld generations, %.3f ms per generation (summed-area table %.0f%%, counts and rule %.0f%%)\n",
+            stepper->generations, total / stepper->generations * 1e3,
+            total > 0 ? 100 * stepper->tableSeconds / total : 0, total > 0 ? 100 * stepper->ruleSeconds / total : 0);
+}
+
+void ltlStepperFree(LtlStepper *stepper)
+{
+    if (stepper == NULL)
+    {
+        return;
+    }
+
+    if (stepper->threads > 1)
+    {
+        stepper->phase = LTL_QUIT;
+        pthread_barrier_wait(&stepper->start);
+        for (int w = 1; w < stepper->threads; w++)
+        {
+            pthread_join(stepper->workers[w].thread, NULL);
+        }
+        pthread_barrier_destroy(&stepper->start);
+        pthread_barrier_destroy(&stepper->finish);
+        pthread_mutex_destroy(&stepper->launch);
+    }
+
+    for (int w = 0; w < stepper->threads; w++)
+    {
+        free(stepper->workers[w].counts);
+    }
+    free(stepper->table);
+    free(stepper->workers);
+    free(stepper);
+}
@@ -1,7 +1,25 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
 #include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <econio.h>
+#include <render.h>
+#include <life.h>
+#include <arena.h>
+#include <domain.h>
+#include <lifenuma.h>
+#include <stats.h>
+#include <perfcount.h>
+#include <export.h>
+#include <daemon.h>
+#include <tune.h>
+#include <history.h>
+#include <patsearch.h>
 
 /* -------------------------------------------------------------------------- */
 /*     Completed Version of Conway's Game of Life by Pham Tuan Binh    */
@@ -25,6 +43,70 @@ enum PlayMode
 };
 typedef enum PlayMode PlayMode;
 
+/* ---------------------- Data Structures for The Program --------------------- */
+// Options given on the command line: those of the engine and the profile tuning it, where to write the statistics and the hardware counters, where to publish the board
+// and, for exporting images without the terminal, the board, the images and the generations to export,
+// the patterns to search the board for, how often and where to write what was found,
+// or, for serving clients instead of playing, the socket and the workers serving them.
+struct GameOptions
+{
+    LifeOptions *life;
+    char *profileName;
+    char *statsFileName;
+    char *countersFileName;
+    char *publishName;
+    int publishEvery;
+
+    char *exportName;
+    ExportOptions export;
+    char *boardFileName;
+    int boardHeight;
+    int boardWidth;
+    long generations;
+    int stride;
+
+    char *patterns;
+    int searchEvery;
+    char *matchesFileName;
+
+    char *socketPath;
+    int workers;
+};
+typedef struct GameOptions GameOptions;
+
+// State of the board editor: the cursor, the rectangle mark and the copied pattern.
+struct EditorState
+{
+    int x;
+    int y;
+    int markX;
+    int markY;
+    int **clipboard;
+    int clipHeight;
+    int clipWidth;
+};
+typedef struct EditorState EditorState;
+
+// A jump to a later generation, calculated on a background thread while the main thread shows the progress.
+struct FastForward
+{
+    Life *life;
+    long target;
+    atomic_long reached;
+    atomic_int cancel;
+    atomic_int finished;
+};
+typedef struct FastForward FastForward;
+
+// Most generations a fast-forward calculates between two checks for ESC
+#define FAST_FORWARD_MAX_CHUNK (1 << 20)
+
+// Generations exported when none are given
+#define EXPORT_DEFAULT_GENERATIONS 100L
+
+// Most Cells of the plane shown past every edge of the board with the growing board, the terminal holding no more
+#define VIEW_MARGIN 32
+
 /* -------------- Additional Utility Functions for the program -------------- */
 // Creating deliberate delay in programm for loading screens
 //    Param: miliseconds (The miliseconds for delay)
@@ -33,6 +115,15 @@ void delay(int miliseconds)
     usleep(miliseconds * 1000);
 }
 
+// Current time, for measuring how fast the board is calculated
+//    Return: (double) Seconds since an arbitrary point in the past
+double secondsNow()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
 // Find the minimum interger between 2 intergers
 //    Param: (int) a (First Interger)
 //           (int) b (Second Interger)
@@ -81,73 +172,35 @@ char *dynamicStringInput()
 }
 
 // Allocate a Dynamic Array (Board Abstraction)
+// Row pointers and rows share one allocation, every row starting on a cache line
 //    Param: (int) HEIGHT (HEIGHT of Board)
 //           (int) WIDTH (WIDTH of Board)
 int **dynamicArrayAllocate(int HEIGHT, int WIDTH)
 {
-    int **array = (int **)malloc(HEIGHT * sizeof(int *));
+    size_t pointers = ((size_t)HEIGHT * sizeof(int *) + ARENA_CACHE_LINE - 1) / ARENA_CACHE_LINE * ARENA_CACHE_LINE;
+    size_t stride = ((size_t)WIDTH * sizeof(int) + ARENA_CACHE_LINE - 1) / ARENA_CACHE_LINE * ARENA_CACHE_LINE;
+
+    unsigned char *block = (unsigned char *)aligned_alloc(ARENA_CACHE_LINE, pointers + HEIGHT * stride);
+    int **array = (int **)block;
     for (int i = 0; i < HEIGHT; i++)
     {
-        array[i] = (int *)malloc(WIDTH * sizeof(int));
+        array[i] = (int *)(block + pointers + i * stride);
     }
     return array;
 }
 
-// Allocate a Dynamic Array (Board Abstraction)
+// Free a Dynamic Array (Board Abstraction)
 //    Param: (int) HEIGHT (HEIGHT of Board)
-//           (int) WIDTH (WIDTH of Board)
+//           (int**) board (Pointer to A 2D Dynamic Interger Array)
 void dynamicArrayFree(int HEIGHT, int **board)
 {
-    for (int i = 0; i < HEIGHT; i++)
-    {
-        free(board[i]);
-    }
-
+    // The rows live in the same allocation as the row pointers
+    (void)HEIGHT;
     free(board);
     return;
 }
 
 /* -- Functions for rendering the game: loading screens, board, board cell,... - */
-// Print a Cell for Life's board
-//    Param: (int) color (The color of the cell)
-void printCell(int color)
-{
-    switch (color)
-    {
-    case 1:
-        econio_textcolor(COL_GREEN);
-        printf("██");
-        econio_textcolor(COL_RESET);
-        break;
-    case 0:
-        econio_textcolor(COL_BLACK);
-        printf("██");
-        econio_textcolor(COL_RESET);
-        break;
-    case 3:
-        econio_textcolor(COL_YELLOW);
-        printf("██");
-        econio_textcolor(COL_RESET);
-        break;
-    default:
-        econio_textcolor(COL_WHITE);
-        printf("██");
-        econio_textcolor(COL_RESET);
-        break;
-    }
-}
-
-// Print a row line (A row full of white Cell, acting as a border) for Life's board
-//    Param: (int) WIDTH (The width of the board)
-void printRowLine(int WIDTH)
-{
-    for (int i = 0; i < WIDTH + 2; i++)
-    {
-        printCell(4);
-    }
-    printf("\n");
-}
-
 // Print a Welcome Banner at the start of the game
 void printBanner()
 {
@@ -174,33 +227,18 @@ void printLoadingScr()
 }
 
 // Print the next game's board of Cells or any game's board of Cells
+// The whole screen is composed as one frame and sent to the terminal at once
 //    Param: (int) delayTime (The time the board will be on screen in milisecconds)
 //           (int) HEIGHT (HEIGHT of Board)
 //           (int) WIDTH (WIDTH of Board)
 //           (int**) nextBoard (Pointer to A 2D Dynamic Interger Array that serves as the next Game Board after calculations, or any board in this case)
-void printBoard(int delayTime, int HEIGHT, int WIDTH, int **nextBoard)
+//           (GenerationStats*) stats (Statistics of the board shown, or NULL)
+void printBoard(int delayTime, int HEIGHT, int WIDTH, int **nextBoard, GenerationStats *stats)
 {
-    econio_clrscr();
-    printRowLine(WIDTH);
-    for (int i = 0; i < HEIGHT; i++)
-    {
-        printCell(4);
-        for (int j = 0; j < WIDTH; j++)
-        {
-            if (nextBoard[i][j] == 1)
-            {
-                printCell(1);
-            }
-            else
-            {
-                printCell(0);
-            }
-        }
-        printCell(4);
-        printf("\n");
-    }
-    printRowLine(WIDTH);
-    printf("\nPress [ESC] to Escape and Save file | Press [ARROW DOWN] to continuosly calculate the board | Press [ARROW RIGHT] to calculate the board step-by-step\n");
+    frameBoard(HEIGHT, WIDTH, nextBoard, stats);
+    econio_frame_printf("\nPress [ESC] to Escape and Save file | Press [ARROW DOWN] to continuosly calculate the board | Press [ARROW RIGHT] to calculate the board step-by-step\n");
+    econio_frame_printf("Press [ARROW LEFT] to go back one generation | Press [PAGE UP] to jump back several generations | Press [F] to fast-forward to a generation\n");
+    econio_frame_commit();
 
     if (delayTime != 0)
     {
@@ -209,7 +247,33 @@ void printBoard(int delayTime, int HEIGHT, int WIDTH, int **nextBoard)
     }
 }
 
+// Print the board of the game, or with the growing board the part of the plane holding its live Cells, up to VIEW_MARGIN Cells past every edge of the board
+//    Param: (int) delayTime (The time the board will be on screen in milisecconds)
+//           (Life*) life (The game, holding the board and the engine)
+//           (GenerationStats*) stats (Statistics of the board shown, or NULL)
+void printGame(int delayTime, Life *life, GenerationStats *stats)
+{
+    int top, left, HEIGHT, WIDTH;
+    lifeExtent(life, &top, &left, &HEIGHT, &WIDTH);
+    if (lifeEngine(life) != GROWING_ENGINE)
+    {
+        printBoard(delayTime, HEIGHT, WIDTH, lifeBoard(life), stats);
+        return;
+    }
+
+    int bottom = top + HEIGHT - 1 < lifeHeight(life) - 1 + VIEW_MARGIN ? top + HEIGHT - 1 : lifeHeight(life) - 1 + VIEW_MARGIN;
+    int right = left + WIDTH - 1 < lifeWidth(life) - 1 + VIEW_MARGIN ? left + WIDTH - 1 : lifeWidth(life) - 1 + VIEW_MARGIN;
+    top = top > -VIEW_MARGIN ? top : -VIEW_MARGIN;
+    left = left > -VIEW_MARGIN ? left : -VIEW_MARGIN;
+
+    int **view = dynamicArrayAllocate(bottom - top + 1, right - left + 1);
+    lifeCopyPlane(life, top, left, bottom - top + 1, right - left + 1, view);
+    printBoard(delayTime, bottom - top + 1, right - left + 1, view, stats);
+    dynamicArrayFree(bottom - top + 1, view);
+}
+
 // Print the next game's board of Cells or any game's board of Cells with a yellow Cell serves as the cursor (For the drawing of User-defined Board)
+// The board is composed as one frame from the upper left corner of the screen
 //    Param: (int) delayTime (The time the board will be on screen in milisecconds)
 //           (int) HEIGHT (HEIGHT of Board)
 //           (int) WIDTH (WIDTH of Board)
@@ -218,32 +282,29 @@ void printBoard(int delayTime, int HEIGHT, int WIDTH, int **nextBoard)
 //           (int**) nextBoard (Pointer to A 2D Dynamic Interger Array that serves as the next Game Board after calculations, or any board in this case)
 void printBoardWithCursor(int delayTime, int HEIGHT, int WIDTH, int x, int y, int **nextBoard)
 {
-    printRowLine(WIDTH);
+    econio_frame_begin(false);
+    frameRowLine(0, WIDTH);
     for (int i = 0; i < HEIGHT; i++)
     {
-        printCell(4);
+        frameCell(0, i + 1, 4);
         for (int j = 0; j < WIDTH; j++)
         {
             if (i == y && j == x)
             {
-                printCell(3);
+                frameCell(j + 1, i + 1, 3);
                 continue;
             }
 
-            if (nextBoard[i][j] == 1)
-            {
-                printCell(1);
-            }
-            else
-            {
-                printCell(0);
-            }
+            frameCell(j + 1, i + 1, nextBoard[i][j] == 1 ? 1 : 0);
         }
-        printCell(4);
-        printf("\n");
+        frameCell(WIDTH + 1, i + 1, 4);
     }
-    printRowLine(WIDTH);
-    printf("\nPress [ENTER] to toggle the cursor | Press [ARROW UP-DOWN-LEFT_RIGHT] to move the cursor | Press [ESCAPE] to proceed\n");
+    frameRowLine(HEIGHT + 1, WIDTH);
+
+    econio_frame_gotoxy(0, HEIGHT + 2);
+    econio_frame_printf("\nPress [ENTER] to toggle the cursor | Press [ARROW UP-DOWN-LEFT_RIGHT] to move the cursor | Press [ESCAPE] to proceed\n");
+    econio_frame_printf("Press [M] to set/unset the mark | Press [F]/[C] to fill/clear the marked rectangle | Press [Y] to copy it | Press [P] to paste the copy at the cursor\n");
+    econio_frame_commit();
 
     if (delayTime != 0)
     {
@@ -252,117 +313,155 @@ void printBoardWithCursor(int delayTime, int HEIGHT, int WIDTH, int x, int y, in
     }
 }
 
-/* ------ Core functions for the calculations of Conway's game of life ------ */
-
-// Assign a board with another board (newBoard = originalBoard)
-//    Param: (int) HEIGHT (HEIGHT of Board)
-//           (int) WIDTH (WIDTH of Board)
-//           (int**) originalBoard (Pointer to A 2D Dynamic Interger Array that serves as the orginal board)
-//           (int**) newBoard (Pointer to A 2D Dynamic Interger Array that serves as the new board)
-void assignBoard(int HEIGHT, int WIDTH, int **newBoard, int **originalBoard)
+// Redraw a single Cell of the board in place, without repainting the rest of the board (For the drawing of User-defined Board)
+//    Param: (int) x (X coordinate of Cell)
+//           (int) y (Y coordinate of Cell)
+//           (EditorState*) editor (Pointer to the state of the board editor)
+//           (int**) board (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
+void redrawEditorCell(int x, int y, EditorState *editor, int **board)
 {
-    for (int i = 0; i < HEIGHT; i++)
+    // Cell (x, y) sits after the left border, every cell being 2 characters wide
+    econio_gotoxy((x + 1) * 2, y + 1);
+
+    if (x == editor->x && y == editor->y)
     {
-        for (int j = 0; j < WIDTH; j++)
-        {
-            newBoard[i][j] = originalBoard[i][j];
-        }
+        printCell(3);
+    }
+    else if (x == editor->markX && y == editor->markY)
+    {
+        printCell(5);
+    }
+    else if (board[y][x] == 1)
+    {
+        printCell(1);
+    }
+    else
+    {
+        printCell(0);
     }
 }
 
-// Count Live Neighbour Cell for Conway's Game of life
-//    Param: (int) r (X coordinate of Cell)
-//           (int) c (Y coordinate of Cell)
+// Redraw a rectangle of Cells in place, only touching the affected region (For the drawing of User-defined Board)
+//    Param: (int) top, left, bottom, right (Corners of the region, inclusive, clipped to the board)
 //           (int) HEIGHT (HEIGHT of Board)
 //           (int) WIDTH (WIDTH of Board)
-//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Arra that serves as the Game Board)
-//    Return: (int) Number of Live Cells
-int countLiveNeighbourCell(int r, int c, int HEIGHT, int WIDTH, int **currentBoard)
+//           (EditorState*) editor (Pointer to the state of the board editor)
+//           (int**) board (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
+void redrawEditorRegion(int top, int left, int bottom, int right, int HEIGHT, int WIDTH, EditorState *editor, int **board)
 {
-    // Live Surrounging Cell Counter
-    int count = 0;
+    top = max(top, 0);
+    left = max(left, 0);
+    bottom = min(bottom, HEIGHT - 1);
+    right = min(right, WIDTH - 1);
 
-    // Loop over the surrounding cells
-    for (int i = r - 1; i <= r + 1; i++)
+    for (int i = top; i <= bottom; i++)
     {
-        for (int j = c - 1; j <= c + 1; j++)
+        // One cursor jump per row, the cells of a row are printed back to back
+        econio_gotoxy((left + 1) * 2, i + 1);
+        for (int j = left; j <= right; j++)
         {
-
-            // Skip in case the cell is out of bound or the cell itself
-            if ((i == r && j == c) || (i < 0 || j < 0) || (i >= HEIGHT || j >= WIDTH))
+            if (j == editor->x && i == editor->y)
             {
-                continue;
+                printCell(3);
             }
-
-            // If live then counter goes up by one
-            if (currentBoard[i][j] == 1)
+            else if (j == editor->markX && i == editor->markY)
+            {
+                printCell(5);
+            }
+            else if (board[i][j] == 1)
+            {
+                printCell(1);
+            }
+            else
             {
-                count++;
+                printCell(0);
             }
         }
     }
-    return count;
 }
 
-// Calculate next game board
-//    Param: (int) HEIGHT (HEIGHT of Board)
+/* -------------------- Functions driving the game engine -------------------- */
+// Replace the engine options with those tuned for the board size, if a profile was given
+// The first run on a machine and size measures every engine, later runs read the profile
+//    Param: (GameOptions*) options (Options of the game)
+//           (int) HEIGHT (HEIGHT of Board)
 //           (int) WIDTH (WIDTH of Board)
-//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
-//           (int**) nextBoard (Pointer to A 2D Dynamic Interger Array that serves as the next Game Board after calculations)
-void calculateNextBoard(int HEIGHT, int WIDTH, int **currentBoard, int **nextBoard)
+void engineTune(GameOptions *options, int HEIGHT, int WIDTH)
 {
-    // Stores the value of live neighbours of a cell
-    int cell;
+    char description[256];
 
-    for (int i = 0; i < HEIGHT; i++)
+    if (options->profileName == NULL)
     {
-        for (int j = 0; j < WIDTH; j++)
-        {
-
-            // Update live neighbours count
-            cell = countLiveNeighbourCell(i, j, HEIGHT, WIDTH, currentBoard);
+        return;
+    }
 
-            // Rules of the game
-            if (currentBoard[i][j] == 1 && (cell == 2 || cell == 3))
-            {
-                nextBoard[i][j] = 1;
-            }
+    // The engines measured only calculate Conway's rule
+    if (lifeOptionsEngine(options->life) == LARGER_ENGINE)
+    {
+        printf("Only Conway's rule is tuned, keeping the Larger than Life engine.\n");
+        return;
+    }
 
-            else if (currentBoard[i][j] == 0 && cell == 3)
-            {
-                nextBoard[i][j] = 1;
-            }
+    // Nor do they grow past the edges of the board
+    if (lifeOptionsEngine(options->life) == GROWING_ENGINE)
+    {
+        printf("Only boards of a fixed size are tuned, keeping the growing board.\n");
+        return;
+    }
 
-            else
-            {
-                nextBoard[i][j] = 0;
-            }
+    if (tuneLookup(options->profileName, HEIGHT, WIDTH, options->life) != 0)
+    {
+        printf("Measuring the engines on a %dx%d board, once for this machine and size:\n", HEIGHT, WIDTH);
+        if (tuneOptions(options->profileName, HEIGHT, WIDTH, options->life, stdout) < 0)
+        {
+            printf("No engine could be measured, keeping the options given.\n");
+            return;
         }
     }
 
-    // Copy Next Board to Current Board
-    assignBoard(HEIGHT, WIDTH, currentBoard, nextBoard);
+    tuneDescribe(options->life, description, sizeof(description));
+    printf("Engine tuned for a %dx%d board: %s.\n", HEIGHT, WIDTH, description);
 }
 
-/* ------------- Functions for different game modes of the game ------------- */
-// Mode 1: Randomize Board
+// Start the engine chosen on the command line, telling the user if it falls back to the single process engine
+//    Param: (Life*) life (The game, holding the board and the engine)
+void engineStart(Life *life)
+{
+    if (!lifeStart(life))
+    {
+        printf("Could not start the chosen engine, calculating in a single thread.\n");
+        delay(1000);
+    }
+}
 
-// Randommize the game's board of cells
-//    Param: (int) HEIGHT (HEIGHT of Board)
-//           (int) WIDTH (WIDTH of Board)
-//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
-void randomBoard(int HEIGHT, int WIDTH, int **currentBoard)
+// Stop the engine, print what it has to report and write the statistics and hardware counters if they were asked for
+//    Param: (Life*) life (The game, holding the board and the engine)
+//           (GameOptions*) options (Options of the game)
+void engineStop(Life *life, GameOptions *options)
 {
-    for (int i = 0; i < HEIGHT; i++)
+    PerfCounters *counters = lifeCounters(life);
+    if (lifeEngine(life) == TILE_ENGINE || lifeEngine(life) == CHANGELIST_ENGINE || lifeEngine(life) == LARGER_ENGINE || lifeEngine(life) == GROWING_ENGINE || counters != NULL)
     {
-        for (int j = 0; j < WIDTH; j++)
-        {
-            currentBoard[i][j] = rand() % 2;
-        }
+        printf("\n");
+        lifeReport(life, stdout);
+    }
+
+    if (counters != NULL && perfCountersAvailable(counters) > 0 && perfCountersWrite(counters, options->countersFileName) == 0)
+    {
+        printf("\nHardware counters of every generation written to %s.\n", options->countersFileName);
+    }
+
+    StatsSeries *series = lifeSeries(life);
+    if (series != NULL && statsSeriesWrite(series, options->statsFileName) == 0)
+    {
+        printf("\nStatistics of %d generations written to %s.\n", series->count, options->statsFileName);
     }
+
+    lifeFree(life);
 }
 
-// Mode 2: Load board from file
+/* ------------- Functions for different game modes of the game ------------- */
+// Mode 2: Load board from file (Mode 1, the randomized board, is done by the engine)
 
 // Get file name from user
 //    Return: (string) fileName (Name of Board)
@@ -392,108 +491,311 @@ char *getFileName()
     return fileName;
 }
 
-// Get Board Size from a save file
-//    Param: (int*) HEIGHT (HEIGHT of Board)
-//           (int*) WIDTH (WIDTH of Board)
-//           (string) fileName (Name of Board)
-void readBoardSizeFromFile(int *HEIGHT, int *WIDTH, char *fileName)
+// Mode 3: User-defined Board
+
+// Get the rectangle spanned by the mark and the cursor (Just the cursor Cell if no mark is set)
+//    Param: (EditorState*) editor (Pointer to the state of the board editor)
+//           (int*) top, left, bottom, right (Corners of the rectangle, inclusive)
+void editorRectangle(EditorState *editor, int *top, int *left, int *bottom, int *right)
 {
+    if (editor->markX < 0)
+    {
+        *top = *bottom = editor->y;
+        *left = *right = editor->x;
+        return;
+    }
 
-    FILE *board;
+    *top = min(editor->y, editor->markY);
+    *bottom = max(editor->y, editor->markY);
+    *left = min(editor->x, editor->markX);
+    *right = max(editor->x, editor->markX);
+}
 
-    board = fopen(fileName, "rb");
+// Set every Cell of a rectangle to the same value (Fill with 1, Clear with 0)
+//    Param: (int) top, left, bottom, right (Corners of the rectangle, inclusive)
+//           (int) value (Value of the Cells)
+//           (int**) board (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
+void fillRectangle(int top, int left, int bottom, int right, int value, int **board)
+{
+    for (int i = top; i <= bottom; i++)
+    {
+        for (int j = left; j <= right; j++)
+        {
+            board[i][j] = value;
+        }
+    }
+}
 
-    fread(HEIGHT, sizeof(int), 1, board);
-    fread(WIDTH, sizeof(int), 1, board);
+// Copy a rectangle of the board into the clipboard of the editor
+//    Param: (int) top, left, bottom, right (Corners of the rectangle, inclusive)
+//           (EditorState*) editor (Pointer to the state of the board editor)
+//           (int**) board (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
+void copyRectangle(int top, int left, int bottom, int right, EditorState *editor, int **board)
+{
+    if (editor->clipboard != NULL)
+    {
+        dynamicArrayFree(editor->clipHeight, editor->clipboard);
+    }
 
-    fclose(board);
+    editor->clipHeight = bottom - top + 1;
+    editor->clipWidth = right - left + 1;
+    editor->clipboard = dynamicArrayAllocate(editor->clipHeight, editor->clipWidth);
+
+    for (int i = 0; i < editor->clipHeight; i++)
+    {
+        for (int j = 0; j < editor->clipWidth; j++)
+        {
+            editor->clipboard[i][j] = board[top + i][left + j] == 1 ? 1 : 0;
+        }
+    }
 }
 
-// Read Board from a save file
+// Paste the clipboard of the editor with its upper left corner on the cursor, clipped to the board
 //    Param: (int) HEIGHT (HEIGHT of Board)
 //           (int) WIDTH (WIDTH of Board)
-//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
-//           (string) fileName (Name of Board)
-void readBoardFromFile(int HEIGHT, int WIDTH, int **currentBoard, char *fileName)
+//           (EditorState*) editor (Pointer to the state of the board editor)
+//           (int**) board (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
+void pasteClipboard(int HEIGHT, int WIDTH, EditorState *editor, int **board)
 {
-    FILE *board;
+    int rows = min(editor->clipHeight, HEIGHT - editor->y);
+    int cols = min(editor->clipWidth, WIDTH - editor->x);
 
-    board = fopen(fileName, "rb");
-
-    fseek(board, sizeof(int) * 2, SEEK_CUR);
-
-    for (int i = 0; i < HEIGHT; i++)
+    for (int i = 0; i < rows; i++)
     {
-        for (int j = 0; j < WIDTH; j++)
+        for (int j = 0; j < cols; j++)
         {
-            fread(&currentBoard[i][j], sizeof(int), 1, board);
+            board[editor->y + i][editor->x + j] = editor->clipboard[i][j];
         }
     }
-
-    fclose(board);
 }
 
-// Mode 3: User-defined Board
-
 // Draw a board and allow user to draw on it using keyboard input
+// Only the Cells affected by a key are redrawn, so editing does not slow down on large boards
 //    Param: (int) HEIGHT (HEIGHT of Board)
 //           (int) WIDTH (WIDTH of Board)
 //           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
-//           (int**) nextBoard (Pointer to A 2D Dynamic Interger Array that serves as the next Game Board after calculations)
 void userInputBoard(int HEIGHT, int WIDTH, int **currentBoard)
 {
+    EditorState editor = {0, 0, -1, -1, NULL, 0, 0};
 
-    int x = 0;
-    int y = 0;
+    // Start from a blank board, freshly allocated boards hold garbage
+    fillRectangle(0, 0, HEIGHT - 1, WIDTH - 1, 0, currentBoard);
 
-    // Draw board
+    // Draw board once, every key afterwards only redraws what changed
     econio_gotoxy(0, HEIGHT + 4);
     econio_clrscr();
-    printBoardWithCursor(0, HEIGHT, WIDTH, x, y, currentBoard);
+    printBoardWithCursor(0, HEIGHT, WIDTH, editor.x, editor.y, currentBoard);
 
     int key = 0;
+    int top, left, bottom, right;
 
     econio_rawmode();
+    econio_gotoxy(0, HEIGHT + 5);
     while (1)
     {
-        econio_gotoxy(0, HEIGHT + 4);
         if (econio_kbhit())
         {
             key = econio_getch();
 
+            int oldX = editor.x;
+            int oldY = editor.y;
+            int oldMarkX = editor.markX;
+            int oldMarkY = editor.markY;
+
+            // Region to redraw besides the old and new cursor (Empty when bottom < top)
+            top = 0;
+            bottom = -1;
+            left = right = 0;
+
             if (key == KEY_UP)
-                y = max(y - 1, 0);
+                editor.y = max(editor.y - 1, 0);
             else if (key == KEY_DOWN)
-                y = min(y + 1, HEIGHT - 1);
+                editor.y = min(editor.y + 1, HEIGHT - 1);
             else if (key == KEY_LEFT)
-                x = max(x - 1, 0);
+                editor.x = max(editor.x - 1, 0);
             else if (key == KEY_RIGHT)
-                x = min(x + 1, WIDTH - 1);
+                editor.x = min(editor.x + 1, WIDTH - 1);
             else if (key == KEY_ENTER)
             {
-                currentBoard[y][x] = currentBoard[y][x] == 0 ? 1 : 0;
+                currentBoard[editor.y][editor.x] = currentBoard[editor.y][editor.x] == 0 ? 1 : 0;
+            }
+            else if (key == 'm' || key == 'M')
+            {
+                if (editor.markX < 0)
+                {
+                    editor.markX = editor.x;
+                    editor.markY = editor.y;
+                }
+                else
+                {
+                    editor.markX = editor.markY = -1;
+                }
+            }
+            else if (key == 'f' || key == 'F' || key == 'c' || key == 'C')
+            {
+                editorRectangle(&editor, &top, &left, &bottom, &right);
+                fillRectangle(top, left, bottom, right, (key == 'f' || key == 'F') ? 1 : 0, currentBoard);
+                editor.markX = editor.markY = -1;
+            }
+            else if (key == 'y' || key == 'Y')
+            {
+                editorRectangle(&editor, &top, &left, &bottom, &right);
+                copyRectangle(top, left, bottom, right, &editor, currentBoard);
+                editor.markX = editor.markY = -1;
+
+                // Nothing on the board changed, only the mark has to disappear
+                bottom = -1;
+            }
+            else if ((key == 'p' || key == 'P') && editor.clipboard != NULL)
+            {
+                pasteClipboard(HEIGHT, WIDTH, &editor, currentBoard);
+                top = editor.y;
+                left = editor.x;
+                bottom = editor.y + editor.clipHeight - 1;
+                right = editor.x + editor.clipWidth - 1;
             }
             else if (key == KEY_ESCAPE)
             {
                 break;
             }
 
-            econio_clrscr();
-            printBoardWithCursor(0, HEIGHT, WIDTH, x, y, currentBoard);
+            redrawEditorRegion(top, left, bottom, right, HEIGHT, WIDTH, &editor, currentBoard);
+            redrawEditorCell(oldX, oldY, &editor, currentBoard);
+            redrawEditorCell(editor.x, editor.y, &editor, currentBoard);
+            if (oldMarkX >= 0)
+            {
+                redrawEditorCell(oldMarkX, oldMarkY, &editor, currentBoard);
+            }
+            if (editor.markX >= 0)
+            {
+                redrawEditorCell(editor.markX, editor.markY, &editor, currentBoard);
+            }
+
+            // Park the cursor below the board until the next key
+            econio_gotoxy(0, HEIGHT + 5);
         }
     }
 
+    if (editor.clipboard != NULL)
+    {
+        dynamicArrayFree(editor.clipHeight, editor.clipboard);
+    }
+
     printLoadingScr();
 }
 
-// Detect User Keyboard Hit and Act Accordingly (Switch Animation mode or Escape Animation mode)
+// Ask for the generation to fast-forward to, below the board
+//    Param: (long) generation (Generation of the board on screen)
+//    Return: (long) The generation asked for, 0 if none was given
+long promptGeneration(long generation)
+{
+    char line[32];
+    long target = 0;
+
+    econio_normalmode();
+    printf("Fast-forward from generation %ld to generation: ", generation);
+    fflush(stdout);
+    if (fgets(line, sizeof(line), stdin) != NULL)
+    {
+        target = strtol(line, NULL, 10);
+    }
+    econio_rawmode();
+
+    return target;
+}
+
+// Calculate the board up to the target generation, in chunks that grow while they take less than 50 ms
+// Runs on the background thread of a fast-forward
+//    Param: (void*) argument (Pointer to the FastForward)
+//    Return: (void*) NULL
+void *fastForwardWorker(void *argument)
+{
+    FastForward *jump = (FastForward *)argument;
+    long chunk = 1;
+
+    while (!atomic_load(&jump->cancel) && lifeGeneration(jump->life) < jump->target)
+    {
+        long remaining = jump->target - lifeGeneration(jump->life);
+        long steps = chunk < remaining ? chunk : remaining;
+        double start = secondsNow();
+
+        // The history records the board at the end of every chunk, the last generation gets a
+        // chunk of its own so that going back from the target lands one generation before it
+        if (steps == remaining && steps > 1)
+        {
+            steps--;
+        }
+        lifeStepFastest(jump->life, steps);
+        atomic_store(&jump->reached, lifeGeneration(jump->life));
+
+        // Short chunks keep ESC responsive, long ones keep gathering and history cheap
+        if (secondsNow() - start < 0.05 && chunk < FAST_FORWARD_MAX_CHUNK)
+        {
+            chunk *= 2;
+        }
+    }
+
+    atomic_store(&jump->finished, 1);
+    return NULL;
+}
+
+// Fast-forward the board to a generation on a background thread with the fastest engine available,
+// showing only a progress line until it is reached or ESC is pressed
+//    Param: (long) target (Generation to reach)
+//           (Life*) life (The game, holding the board and the engine)
+void fastForward(long target, Life *life)
+{
+    long start = lifeGeneration(life);
+    if (target <= start)
+    {
+        return;
+    }
+
+    FastForward jump = {.life = life, .target = target};
+    atomic_init(&jump.reached, start);
+    atomic_init(&jump.cancel, 0);
+    atomic_init(&jump.finished, 0);
+
+    pthread_t worker;
+    if (pthread_create(&worker, NULL, fastForwardWorker, &jump) != 0)
+    {
+        fastForwardWorker(&jump);
+        return;
+    }
+
+    double begin = secondsNow();
+    printf("\n");
+    while (!atomic_load(&jump.finished))
+    {
+        if (econio_kbhit() && econio_getch() == KEY_ESCAPE)
+        {
+            atomic_store(&jump.cancel, 1);
+        }
+
+        long reached = atomic_load(&jump.reached);
+        double elapsed = secondsNow() - begin;
+        double rate = elapsed > 0 ? (reached - start) / elapsed : 0;
+        printf("\rGeneration %ld of %ld | %.0f generations/s | ETA ", reached, target, rate);
+        if (rate > 0)
+        {
+            printf("%.1f s | Press [ESC] to stop here   ", (target - reached) / rate);
+        }
+        else
+        {
+            printf("unknown | Press [ESC] to stop here   ");
+        }
+        econio_flush();
+        delay(100);
+    }
+    pthread_join(worker, NULL);
+}
+
+// Detect User Keyboard Hit and Act Accordingly (Switch Animation mode, step forward or back in the history, fast-forward, or Escape Animation mode)
 //    Param: (int*) animation (Pointer to Current Animation Mode)
-//           (int) HEIGHT (HEIGHT of Board)
-//           (int) WIDTH (WIDTH of Board)
-//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
-//           (int**) nextBoard (Pointer to A 2D Dynamic Interger Array that serves as the next Game Board after calculations)
+//           (Life*) life (The game, holding the board and the engine)
+//           (GameOptions*) options (Options of the game)
 //    Return: (int) escape (1 means escape, 0 means keep playing)
-int animationController(AnimationMode *animation, int HEIGHT, int WIDTH, int **currentBoard, int **nextBoard)
+int animationController(AnimationMode *animation, Life *life, GameOptions *options)
 {
     int key = econio_getch();
 
@@ -510,13 +812,304 @@ int animationController(AnimationMode *animation, int HEIGHT, int WIDTH, int **c
     else if (key == KEY_RIGHT)
     {
         *animation = STEP;
-        calculateNextBoard(HEIGHT, WIDTH, currentBoard, nextBoard);
+        lifeStep(life, 1);
+    }
+    else if (key == KEY_LEFT)
+    {
+        *animation = STEP;
+        lifeRewind(life, 1);
+    }
+    else if (key == KEY_PAGEUP)
+    {
+        *animation = STEP;
+        lifeRewind(life, lifeOptionsInterval(options->life));
+    }
+    else if (key == 'f' || key == 'F')
+    {
+        *animation = STEP;
+        fastForward(promptGeneration(lifeGeneration(life)), life);
     }
 
     return 0;
 }
 
 /* --------------- Functions for phases or stages of the game --------------- */
+// Print how to start the game from the command line
+//    Param: (string) program (Name of the program)
+void printUsage(char *program)
+{
+    printf("Usage: %s [-p processes] [-u] [-t threads] [-k depth] [-z] [-i] [-l] [-E limit] [-R rule] [-T profile] [-s statsfile] [-C countersfile] [-g | -G] [-m megabytes] [-K interval] [-P name [-e every]] [-A cores | nodes]\n", program);
+    printf("       %s -S socket [-W workers] [engine options]\n", program);
+    printf("       %s -x image (-b board | -r HEIGHTxWIDTH) [-n generations] [-d stride] [-c scale] [-j threads] [engine options]\n", program);
+    printf("       %s -f patterns (-b board | -r HEIGHTxWIDTH) [-n generations] [-F every] [-o matchesfile] [-x image ...] [engine options]\n", program);
+    printf("    -p processes   Split the board across several worker processes.\n");
+    printf("    -u             Exchange rows between worker processes over UNIX sockets instead of shared memory.\n");
+    printf("    -t threads     Calculate the board in tiles on several threads, skipping stable tiles.\n");
+    printf("    -k depth       Calculate several generations per tile while it stays in the cache (0 chooses the depth from the cache size).\n");
+    printf("    -z             Keep the board in square tiles laid out in Z-order, for locality in both directions.\n");
+    printf("    -i             Calculate the board in place, keeping a single board in memory instead of two.\n");
+    printf("    -l             Only visit the Cells next to those that changed in the last generation, for boards where little moves.\n");
+    printf("    -E limit       Let Cells live on past the edges of the board, which grows up to limit Cells a side (the board shown grows with them, up to 32 Cells past every edge).\n");
+    printf("    -R rule        Play a Larger than Life rule, as in Golly (R5,C0,M1,S34..58,B34..45,NM) or by name (bosco, majority); -t sets its threads.\n");
+    printf("    -T profile     Use the fastest engine for the board size on this machine, measured once and kept in the profile file.\n");
+    printf("    -s statsfile   Write population, births, deaths and bounding box of every generation to a CSV file.\n");
+    printf("    -C countersfile Count cycles, instructions, cache and branch misses of the engine and write them per generation to a CSV file.\n");
+    printf("    -g             Back the boards with transparent huge pages.\n");
+    printf("    -G             Back the boards with explicit huge pages (hugetlbfs), or transparent ones if there are none.\n");
+    printf("    -m megabytes   Memory kept for going back to earlier generations (0 turns it off, default %d).\n", HISTORY_DEFAULT_MEGABYTES);
+    printf("    -K interval    Keep a full board every interval generations, [PAGE UP] jumps back as many (default %d).\n", HISTORY_DEFAULT_INTERVAL);
+    printf("    -P name        Publish the board to shared memory, for ./viewer name to watch from another terminal.\n");
+    printf("    -e every       Publish every given generation only (default 1).\n");
+    printf("    -A cores       Pin every worker thread or process to a core, spread over the NUMA nodes.\n");
+    printf("    -A nodes       Pin every worker thread or process to the cores of a NUMA node.\n");
+    printf("Serving clients over a UNIX domain socket instead of playing (see daemon.h for the protocol):\n");
+    printf("    -S socket      Keep boards resident and serve requests on the socket until Ctrl-C.\n");
+    printf("    -W workers     Threads serving the sessions (default one per core).\n");
+    printf("Exporting images without the terminal:\n");
+    printf("    -x image       Write the generations to life.gif (one animated GIF), or life.png or life.ppm (life_000000.png, ...).\n");
+    printf("    -b board       Start from a board file.\n");
+    printf("    -r HxW         Start from a random board of H rows and W columns.\n");
+    printf("    -n generations Generations to calculate (default %ld).\n", EXPORT_DEFAULT_GENERATIONS);
+    printf("    -d stride      Write every given generation only (default 1).\n");
+    printf("    -c scale       Pixels per Cell side (default %d).\n", EXPORT_DEFAULT_SCALE);
+    printf("    -j threads     Threads encoding the images or searching the board (default one per core).\n");
+    printf("Searching the board for patterns without the terminal:\n");
+    printf("    -f patterns    Find every glider, lwss, blinker, block, beehive, eater or pattern of a board file, comma separated.\n");
+    printf("    -F every       Search every given generation only (default 1).\n");
+    printf("    -o matchesfile Write every match, its generation, place, orientation and phase to a CSV file.\n");
+}
+
+// Read a whole number given on the command line
+//    Param: (string) text (The argument)
+//           (long) least (Smallest number accepted)
+//           (long) most (Largest number accepted)
+//           (long*) number (Receives the number)
+//    Return: (int) valid (1 means the argument is such a number, 0 means it is not)
+int parseNumber(char *text, long least, long most, long *number)
+{
+    char *end;
+    errno = 0;
+    *number = strtol(text, &end, 10);
+    return errno == 0 && end != text && *end == '\0' && *number >= least && *number <= most;
+}
+
+// Read the options given on the command line
+//    Param: (int) argc (Number of arguments)
+//           (string*) argv (Arguments)
+//           (GameOptions*) options (Options of the game)
+//    Return: (int) valid (1 means the options are valid, 0 means they are not)
+int parseArguments(int argc, char **argv, GameOptions *options)
+{
+    int option;
+    int larger = 0;
+    int value;
+    long number;
+
+    while ((option = getopt(argc, argv, "p:ut:k:zilE:R:T:s:C:gGm:K:P:e:A:x:b:r:n:d:c:j:f:F:o:S:W:")) != -1)
+    {
+        switch (option)
+        {
+        case 'p':
+            value = atoi(optarg);
+            if (value < 1)
+            {
+                return 0;
+            }
+            lifeOptionsSetProcesses(options->life, value);
+            lifeOptionsSetEngine(options->life, value > 1 ? DOMAIN_ENGINE : GENERIC_ENGINE);
+            break;
+        case 'u':
+            lifeOptionsSetTransport(options->life, UNIX_SOCKET);
+            break;
+        case 't':
+            value = atoi(optarg);
+            if (value < 1)
+            {
+                return 0;
+            }
+            lifeOptionsSetThreads(options->life, value);
+            lifeOptionsSetEngine(options->life, TILE_ENGINE);
+            break;
+        case 'k':
+            value = atoi(optarg);
+            if (value < 0)
+            {
+                return 0;
+            }
+            lifeOptionsSetDepth(options->life, value);
+            lifeOptionsSetEngine(options->life, TEMPORAL_ENGINE);
+            break;
+        case 'z':
+            lifeOptionsSetEngine(options->life, ZORDER_ENGINE);
+            break;
+        case 'i':
+            lifeOptionsSetEngine(options->life, INPLACE_ENGINE);
+            break;
+        case 'l':
+            lifeOptionsSetEngine(options->life, CHANGELIST_ENGINE);
+            break;
+        case 'E':
+            value = atoi(optarg);
+            if (value < 1)
+            {
+                return 0;
+            }
+            lifeOptionsSetGrowLimit(options->life, value);
+            lifeOptionsSetEngine(options->life, GROWING_ENGINE);
+            break;
+        case 'R':
+            if (lifeOptionsSetRule(options->life, optarg) != 0)
+            {
+                return 0;
+            }
+            larger = 1;
+            break;
+        case 'T':
+            options->profileName = optarg;
+            break;
+        case 's':
+            options->statsFileName = optarg;
+            lifeOptionsSetSeries(options->life, 1);
+            break;
+        case 'C':
+            options->countersFileName = optarg;
+            lifeOptionsSetCounters(options->life, 1);
+            break;
+        case 'g':
+            lifeOptionsSetPages(options->life, ARENA_TRANSPARENT_HUGE_PAGES);
+            break;
+        case 'G':
+            lifeOptionsSetPages(options->life, ARENA_EXPLICIT_HUGE_PAGES);
+            break;
+        case 'm':
+            value = atoi(optarg);
+            if (value < 0)
+            {
+                return 0;
+            }
+            lifeOptionsSetHistory(options->life, value);
+            break;
+        case 'K':
+            value = atoi(optarg);
+            if (value < 1)
+            {
+                return 0;
+            }
+            lifeOptionsSetInterval(options->life, value);
+            break;
+        case 'A':
+            if (strcmp(optarg, "cores") == 0)
+            {
+                lifeOptionsSetPinning(options->life, NUMA_PIN_CORES);
+            }
+            else if (strcmp(optarg, "nodes") == 0)
+            {
+                lifeOptionsSetPinning(options->life, NUMA_PIN_NODES);
+            }
+            else
+            {
+                return 0;
+            }
+            break;
+        case 'P':
+            options->publishName = optarg;
+            break;
+        case 'e':
+            options->publishEvery = atoi(optarg);
+            if (options->publishEvery < 1)
+            {
+                return 0;
+            }
+            break;
+        case 'x':
+            options->exportName = optarg;
+            options->export.format = exportFormatOf(optarg);
+            if (options->export.format == 0)
+            {
+                return 0;
+            }
+            break;
+        case 'b':
+            options->boardFileName = optarg;
+            break;
+        case 'r':
+            if (sscanf(optarg, "%dx%d", &options->boardHeight, &options->boardWidth) != 2 || options->boardHeight < 1 || options->boardWidth < 1)
+            {
+                return 0;
+            }
+            break;
+        case 'n':
+            // One more than the last generation is still a long
+            if (!parseNumber(optarg, 0, LONG_MAX - 1, &options->generations))
+            {
+                return 0;
+            }
+            break;
+        case 'd':
+            if (!parseNumber(optarg, 1, INT_MAX, &number))
+            {
+                return 0;
+            }
+            options->stride = (int)number;
+            break;
+        case 'c':
+            options->export.scale = atoi(optarg);
+            if (options->export.scale < 1)
+            {
+                return 0;
+            }
+            break;
+        case 'j':
+            options->export.threads = atoi(optarg);
+            if (options->export.threads < 1)
+            {
+                return 0;
+            }
+            break;
+        case 'f':
+            options->patterns = optarg;
+            break;
+        case 'F':
+            if (!parseNumber(optarg, 1, INT_MAX, &number))
+            {
+                return 0;
+            }
+            options->searchEvery = (int)number;
+            break;
+        case 'o':
+            options->matchesFileName = optarg;
+            break;
+        case 'S':
+            options->socketPath = optarg;
+            break;
+        case 'W':
+            options->workers = atoi(optarg);
+            if (options->workers < 1)
+            {
+                return 0;
+            }
+            break;
+        default:
+            return 0;
+        }
+    }
+
+    // Only the Larger than Life engine calculates other rules, -t then sets its threads
+    if (larger)
+    {
+        lifeOptionsSetEngine(options->life, LARGER_ENGINE);
+    }
+
+    // An export or a search starts from a board file or a random board, as there is no one to ask
+    if ((options->exportName != NULL || options->patterns != NULL) && options->boardFileName == NULL && options->boardHeight < 1)
+    {
+        return 0;
+    }
+
+    return 1;
+}
+
+
 // Prompt user to start the game by pressing ENTER
 void gameBegin()
 {
@@ -570,46 +1163,257 @@ void gameSetup(PlayMode *mode)
     printLoadingScr();
 }
 
-// Write Board to file
-//    Param: (int) HEIGHT (HEIGHT of Board)
-//           (int) WIDTH (WIDTH of Board)
-//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
-//           (string) fileName (Name of Board)
-void writeToFile(int HEIGHT, int WIDTH, int **currentBoard, char *fileName)
+// Serve clients over a UNIX domain socket, without the terminal game (Daemon mode)
+//    Param: (GameOptions*) options (Options of the game)
+//    Return: (int) Exit status of the program
+int serveGame(GameOptions *options)
 {
-    FILE *board;
+    // Clients have no way to step back, boards only keep their latest generation
+    lifeOptionsSetHistory(options->life, 0);
+
+    printf("Serving on %s, press Ctrl-C to stop.\n", options->socketPath);
+    fflush(stdout);
+    if (daemonServe(options->socketPath, options->life, options->workers) != 0)
+    {
+        printf("Could not serve on %s.\n", options->socketPath);
+        return 1;
+    }
 
-    board = fopen(fileName, "wb");
+    printf("Stopped serving on %s.\n", options->socketPath);
+    return 0;
+}
 
-    if (board == NULL)
+// Compile the patterns given on the command line, built-in names or board files separated by commas
+//    Param: (GameOptions*) options (Options of the game)
+//    Return: (PatternSearch*) The search, NULL if a pattern could not be compiled
+PatternSearch *searchSetUp(GameOptions *options)
+{
+    PatternSearch *search = searchCreate(SEARCH_DEFAULT_MARGIN, options->export.threads);
+    char *names = strdup(options->patterns);
+    if (search == NULL || names == NULL)
     {
-        printf("Error!");
-        printf("Something is wrong.");
-        return;
+        printf("Not enough memory for the search.\n");
+        searchFree(search);
+        free(names);
+        return NULL;
     }
 
-    fwrite(&HEIGHT, sizeof(int), 1, board);
-    fwrite(&WIDTH, sizeof(int), 1, board);
+    char *rest = names;
+    char *name;
+    while ((name = strsep(&rest, ",")) != NULL)
+    {
+        if (*name != '\0' && searchAddNamed(search, name) < 0)
+        {
+            printf("Could not search for %s: it is neither a known pattern nor a board file with a pattern of at most %dx%d Cells.\n", name, SEARCH_MAX_SIZE - 2 * SEARCH_DEFAULT_MARGIN, SEARCH_MAX_SIZE - 2 * SEARCH_DEFAULT_MARGIN);
+            searchFree(search);
+            free(names);
+            return NULL;
+        }
+    }
+    free(names);
 
-    for (int i = 0; i < HEIGHT; i++)
+    return search;
+}
+
+// Search the board for the patterns, print how many of each were found and write the matches
+//    Param: (PatternSearch*) search (The search)
+//           (Life*) life (The game, holding the board)
+//           (FILE*) matchesFile (Where to write the matches, or NULL)
+//    Return: (int) Number of matches, -1 if the search failed
+int searchGeneration(PatternSearch *search, Life *life, FILE *matchesFile)
+{
+    SearchMatch *matches;
+    int count = searchRun(search, lifeBoard(life), lifeHeight(life), lifeWidth(life), &matches);
+    if (count < 0)
     {
-        for (int j = 0; j < WIDTH; j++)
+        return -1;
+    }
+
+    printf("Generation %ld:", lifeGeneration(life));
+    for (int p = 0; p < searchPatterns(search); p++)
+    {
+        int found = 0;
+        for (int m = 0; m < count; m++)
         {
-            fwrite(&currentBoard[i][j], sizeof(int), 1, board);
+            found += matches[m].pattern == p;
         }
+        printf(" %d %s%s", found, searchPatternName(search, p), p + 1 < searchPatterns(search) ? "," : "\n");
     }
 
-    fclose(board);
+    if (matchesFile != NULL)
+    {
+        searchWriteMatches(search, matchesFile, lifeGeneration(life), matches, count);
+    }
+    return count;
+}
 
-    return;
+// Export generations to images and search them for patterns, without the terminal game (Headless mode)
+// The engine runs at full speed, the images are encoded behind it on threads of their own
+//    Param: (GameOptions*) options (Options of the game)
+//    Return: (int) Exit status of the program
+int headlessGame(GameOptions *options)
+{
+    int HEIGHT = options->boardHeight, WIDTH = options->boardWidth;
+    if (options->boardFileName != NULL && lifeReadSize(options->boardFileName, &HEIGHT, &WIDTH) != 0)
+    {
+        printf("Could not read a board from %s.\n", options->boardFileName);
+        return 1;
+    }
+
+    PatternSearch *search = NULL;
+    FILE *matchesFile = NULL;
+    if (options->patterns != NULL)
+    {
+        search = searchSetUp(options);
+        if (search == NULL)
+        {
+            return 1;
+        }
+        if (options->matchesFileName != NULL)
+        {
+            matchesFile = fopen(options->matchesFileName, "w");
+            if (matchesFile == NULL)
+            {
+                printf("Could not write the matches to %s.\n", options->matchesFileName);
+                searchFree(search);
+                return 1;
+            }
+            fprintf(matchesFile, "generation,pattern,row,column,orientation,phase\n");
+        }
+    }
+
+    // The encoder threads start before the Life, so that the hardware counters of the engine leave them out
+    Exporter *exporter = NULL;
+    if (options->exportName != NULL)
+    {
+        exporter = exporterCreate(options->exportName, HEIGHT, WIDTH, &options->export);
+        if (exporter == NULL)
+        {
+            printf("Could not export to %s.\n", options->exportName);
+            searchFree(search);
+            if (matchesFile != NULL)
+            {
+                fclose(matchesFile);
+            }
+            return 1;
+        }
+    }
+
+    // Nobody steps back through the generations of an export
+    lifeOptionsSetHistory(options->life, 0);
+    engineTune(options, HEIGHT, WIDTH);
+    Life *life = lifeCreate(HEIGHT, WIDTH, options->life);
+    int loaded = life != NULL && (options->boardFileName == NULL || lifeLoad(life, options->boardFileName) == 0);
+    if (!loaded)
+    {
+        if (life == NULL)
+        {
+            printf("Not enough memory for a %dx%d board.\n", HEIGHT, WIDTH);
+        }
+        else
+        {
+            printf("Could not read a board from %s.\n", options->boardFileName);
+            lifeFree(life);
+        }
+        if (exporter != NULL)
+        {
+            exporterFinish(exporter);
+        }
+        searchFree(search);
+        if (matchesFile != NULL)
+        {
+            fclose(matchesFile);
+        }
+        return 1;
+    }
+
+    if (options->boardFileName == NULL)
+    {
+        lifeRandomize(life);
+    }
+
+    engineStart(life);
+    double start = secondsNow();
+    double searchSeconds = 0;
+    long searches = 0;
+    long found = 0;
+    int failed = 0;
+
+    // The engine calculates up to the next generation to export or to search, whichever comes first
+    long generation = lifeGeneration(life);
+    while (1)
+    {
+        if (exporter != NULL && generation % options->stride == 0)
+        {
+            exporterSubmit(exporter, lifeBoard(life), generation);
+        }
+        if (search != NULL && generation % options->searchEvery == 0)
+        {
+            double searchStart = secondsNow();
+            int count = searchGeneration(search, life, matchesFile);
+            searchSeconds += secondsNow() - searchStart;
+            failed |= count < 0;
+            found += count > 0 ? count : 0;
+            searches++;
+        }
+
+        long next = options->generations + 1;
+        long nextImage = (generation / options->stride + 1) * options->stride;
+        long nextSearch = (generation / options->searchEvery + 1) * options->searchEvery;
+        if (exporter != NULL && nextImage < next)
+        {
+            next = nextImage;
+        }
+        if (search != NULL && nextSearch < next)
+        {
+            next = nextSearch;
+        }
+        if (next > options->generations)
+        {
+            break;
+        }
+        // lifeStep counts generations in an int, the stretch to the next image or search may be longer
+        while (generation < next)
+        {
+            int generations = next - generation > INT_MAX ? INT_MAX : (int)(next - generation);
+            lifeStep(life, generations);
+            generation += generations;
+        }
+    }
+    long frames = exporter != NULL ? exporterFinish(exporter) : 0;
+    double seconds = secondsNow() - start;
+
+    if (frames < 0)
+    {
+        printf("Could not write every image to %s.\n", options->exportName);
+    }
+    else if (exporter != NULL)
+    {
+        printf("Exported %ld generations as %ld images to %s in %.2f s (%.1f images per second).\n", lifeGeneration(life), frames, options->exportName, seconds, seconds > 0 ? frames / seconds : 0.0);
+    }
+
+    if (search != NULL)
+    {
+        if (failed)
+        {
+            printf("Not enough memory to keep every match.\n");
+        }
+        printf("Searched %ld generations for %d patterns (%d variants): %ld matches, %.3f ms per search.\n", searches, searchPatterns(search), searchVariants(search), found, searches > 0 ? searchSeconds * 1e3 / searches : 0.0);
+        searchFree(search);
+        if (matchesFile != NULL)
+        {
+            fclose(matchesFile);
+        }
+    }
+
+    engineStop(life, options);
+    return frames < 0 || failed;
 }
 
 // Prompt user to enter the name of the save file and end the game
-//    Param: (int) HEIGHT (Height of the Board)
-//           (int) WIDTH (Width of the Board)
-//           (int**) currentBoard (Pointer to A 2D Dynamic Interger Array that serves as the Game Board)
-//           (int**) nextBoard (Pointer to A 2D Dynamic Interger Array that serves as the next Game Board after calculations)
-void gameEnd(int HEIGHT, int WIDTH, int **currentBoard, int **nextBoard, char *fileName)
+//    Param: (Life*) life (The game, holding the board)
+//           (string) fileName (Name of the save file)
+void gameEnd(Life *life, char *fileName)
 {
 
     econio_clrscr();
@@ -618,10 +1422,12 @@ void gameEnd(int HEIGHT, int WIDTH, int **currentBoard, int **nextBoard, char *f
     printf("Saving your file! Please enter a name for your file: ");
     fileName = dynamicStringInput();
 
-    writeToFile(HEIGHT, WIDTH, currentBoard, fileName);
+    if (lifeSave(life, fileName) != 0)
+    {
+        printf("Error!");
+        printf("Something is wrong.");
+    }
 
-    dynamicArrayFree(HEIGHT, currentBoard);
-    dynamicArrayFree(HEIGHT, nextBoard);
     free(fileName);
 
     printLoadingScr();
@@ -664,7 +1470,7 @@ void boardSetUp(int *HEIGHT, int *WIDTH)
 }
 
 /* -------------------------- Main Loop of the game ------------------------- */
-int main()
+int main(int argc, char **argv)
 {
     // Init Variables for the game
     int inPlay = 0;
@@ -672,10 +1478,42 @@ int main()
     int key = 0;
     PlayMode mode = RANDOM_MODE;
     AnimationMode animation = STEP;
+    GameOptions options = {.profileName = NULL, .statsFileName = NULL, .countersFileName = NULL, .publishName = NULL, .publishEvery = 1, .exportName = NULL, .boardFileName = NULL, .generations = EXPORT_DEFAULT_GENERATIONS, .stride = 1, .patterns = NULL, .searchEvery = 1, .matchesFileName = NULL, .socketPath = NULL, .workers = 0};
+
+    // The interactive game keeps a history by default
+    options.life = lifeOptionsCreate();
+    if (options.life == NULL)
+    {
+        return 1;
+    }
+    lifeOptionsSetHistory(options.life, HISTORY_DEFAULT_MEGABYTES);
+    exportDefaultOptions(&options.export);
 
-    // Init pointer to pointer for Dynamic Array
-    int **currentBoard;
-    int **nextBoard;
+    if (!parseArguments(argc, argv, &options))
+    {
+        printUsage(argv[0]);
+        lifeOptionsFree(options.life);
+        return 1;
+    }
+
+    // Exporting images or searching the board needs no terminal at all
+    if (options.exportName != NULL || options.patterns != NULL)
+    {
+        int status = headlessGame(&options);
+        lifeOptionsFree(options.life);
+        return status;
+    }
+
+    // Neither does serving clients, who step their boards on request and go back with frames of their own
+    if (options.socketPath != NULL)
+    {
+        int status = serveGame(&options);
+        lifeOptionsFree(options.life);
+        return status;
+    }
+
+    // The game: board, engine, statistics and history
+    Life *life;
 
     // Dynamic Filename
     char *fileName = NULL;
@@ -699,39 +1537,76 @@ int main()
         fileName = getFileName();
 
         // Get board size
-        readBoardSizeFromFile(&HEIGHT, &WIDTH, fileName);
+        if (lifeReadSize(fileName, &HEIGHT, &WIDTH) != 0)
+        {
+            printf("Could not read a board from %s.\n", fileName);
+            lifeOptionsFree(options.life);
+            return 1;
+        }
         break;
     case USER_MODE:
         // Get board size
         boardSetUp(&HEIGHT, &WIDTH);
         break;
     default:
+        lifeOptionsFree(options.life);
         return 0;
     }
 
-    // Initialize Board Array
-    currentBoard = dynamicArrayAllocate(HEIGHT, WIDTH);
-    nextBoard = dynamicArrayAllocate(HEIGHT, WIDTH);
+    // Initialize the game with the engine tuned for its size, its boards come from a single aligned arena
+    engineTune(&options, HEIGHT, WIDTH);
+    life = lifeCreate(HEIGHT, WIDTH, options.life);
+    if (life == NULL)
+    {
+        printf("Not enough memory for a %dx%d board.\n", HEIGHT, WIDTH);
+        lifeOptionsFree(options.life);
+        return 1;
+    }
 
     // Populate Board Cells
     switch (mode)
     {
     case RANDOM_MODE:
         // Randomize board
-        randomBoard(HEIGHT, WIDTH, currentBoard);
+        lifeRandomize(life);
         break;
     case FILE_MODE:
         // Init board
-        readBoardFromFile(HEIGHT, WIDTH, currentBoard, fileName);
+        if (lifeLoad(life, fileName) != 0)
+        {
+            printf("Could not read a board from %s.\n", fileName);
+            lifeFree(life);
+            lifeOptionsFree(options.life);
+            return 1;
+        }
         break;
     case USER_MODE:
-        // Init Board
-        userInputBoard(HEIGHT, WIDTH, currentBoard);
+        // Init Board, drawn straight into the game's memory
+        userInputBoard(HEIGHT, WIDTH, lifeBoard(life));
+        lifeBoardChanged(life);
         break;
     default:
+        lifeFree(life);
+        lifeOptionsFree(options.life);
         return 0;
     }
 
+    engineStart(life);
+
+    // Viewers in other terminals watch the game through shared memory
+    int published = options.publishName != NULL ? lifePublish(life, options.publishName, options.publishEvery) : 0;
+    if (published == -2)
+    {
+        printf("Another game publishes as %s (or left it behind when it crashed: remove /dev/shm/%s), playing without viewers.\n",
+               options.publishName, options.publishName[0] == '/' ? options.publishName + 1 : options.publishName);
+        delay(1000);
+    }
+    else if (published != 0)
+    {
+        printf("Could not publish the board as %s, playing without viewers.\n", options.publishName);
+        delay(1000);
+    }
+
     // Animation Process
     econio_rawmode();
     while (1)
@@ -739,27 +1614,29 @@ int main()
         if (animation == CONTINOUS)
         {
 
-            calculateNextBoard(HEIGHT, WIDTH, currentBoard, nextBoard);
-            printBoard(100, HEIGHT, WIDTH, currentBoard);
+            lifeStep(life, 1);
+            printGame(100, life, lifeStats(life));
 
             // econio_getch() blocks code from running without user input, I have used this "feature" to implement Step-By-Step and Continous Mode.
             if (econio_kbhit())
             {
-                if (animationController(&animation, HEIGHT, WIDTH, currentBoard, nextBoard))
+                if (animationController(&animation, life, &options))
                     break;
             }
         }
         else if (animation == STEP)
         {
-            printBoard(0, HEIGHT, WIDTH, currentBoard);
+            printGame(0, life, lifeGeneration(life) > 0 ? lifeStats(life) : NULL);
 
-            if (animationController(&animation, HEIGHT, WIDTH, currentBoard, nextBoard))
+            if (animationController(&animation, life, &options))
                 break;
         }
     }
 
     /* ---------------------------- Phase 4: Game End --------------------------- */
-    gameEnd(HEIGHT, WIDTH, currentBoard, nextBoard, fileName);
+    gameEnd(life, fileName);
+    engineStop(life, &options);
+    lifeOptionsFree(options.life);
 
     return 0;
 }
@@ -0,0 +1,761 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <patsearch.h>
+
+/* -------------------------------------------------------------------------- */
+/*        Search of a board for every occurrence of a set of patterns         */
+/* -------------------------------------------------------------------------- */
+
+// Bits in a word of the packed board, the columns tested at once
+#define SEARCH_WORD_BITS 64
+
+// Words of padding left of the packed rows, so windows sticking out of the board read dead Cells
+#define SEARCH_PAD_WORDS 1
+
+// Matches a thread keeps room for before growing its list
+#define SEARCH_INITIAL_MATCHES 64
+
+/* ------------------ Data Structures of the Pattern Search ------------------ */
+// A pattern cropped to its live Cells, one byte per Cell.
+struct SearchShape
+{
+    int height;
+    int width;
+    unsigned char cells[SEARCH_MAX_SIZE][SEARCH_MAX_SIZE];
+};
+typedef struct SearchShape SearchShape;
+
+// A Cell of a window to test: its row and column in the window, and whether it must be alive.
+struct SearchTest
+{
+    unsigned char row;
+    unsigned char column;
+    unsigned char alive;
+};
+typedef struct SearchTest SearchTest;
+
+// A phase of a pattern in one orientation: the size of its box, and the window of the box and its
+// margins, as masks of the live Cells and as the list of Cells to test, the live ones first.
+struct SearchVariant
+{
+    int pattern;
+    int orientation;
+    int phase;
+    int height;
+    int width;
+    int windowHeight;
+    int windowWidth;
+    uint64_t live[SEARCH_MAX_SIZE];
+    SearchTest *tests;
+    int testCount;
+};
+typedef struct SearchVariant SearchVariant;
+
+struct SearchWorker
+{
+    PatternSearch *search;
+    pthread_t thread;
+
+    // Rows of the board packed, and rows where the upper left corner of a match is looked for
+    int firstRow;
+    int lastRow;
+
+    SearchMatch *matches;
+    int matchCount;
+    int matchSize;
+    int failed;
+};
+typedef struct SearchWorker SearchWorker;
+
+struct PatternSearch
+{
+    int margin;
+    int threads;
+
+    char **names;
+    int patternCount;
+    SearchVariant *variants;
+    int variantCount;
+
+    // The board of the search running, and its rows packed into bits behind the left padding
+    int **board;
+    int HEIGHT;
+    int WIDTH;
+    uint64_t *packed;
+    uint64_t *deadRow;
+    size_t stride;
+    size_t packedSize;
+    pthread_barrier_t packedBarrier;
+    SearchWorker *workers;
+
+    // Threads of the search running, fewer than asked for when some could not be created.
+    // Held while they are created, so that rows are dealt once their number is known.
+    int running;
+    pthread_mutex_t launch;
+
+    SearchMatch *matches;
+    int matchSize;
+};
+
+// A pattern known by name, row by row, 'O' for a live Cell.
+struct SearchNamedPattern
+{
+    const char *name;
+    const char *rows[4];
+};
+typedef struct SearchNamedPattern SearchNamedPattern;
+
+static SearchNamedPattern namedPatterns[] = {
+    {"glider", {".O.", "..O", "OOO", NULL}},
+    {"lwss", {".O..O", "O....", "O...O", "OOOO."}},
+    {"blinker", {"OOO", NULL, NULL, NULL}},
+    {"block", {"OO", "OO", NULL, NULL}},
+    {"beehive", {".OO.", "O..O", ".OO.", NULL}},
+    {"eater", {"OO..", "O.O.", "..O.", "..OO"}},
+};
+
+static const char *orientationNames[] = {"r0", "r90", "r180", "r270", "m0", "m90", "m180", "m270"};
+
+/* ---------------------- Functions to compile patterns ---------------------- */
+// Crop a pattern to the box of its live Cells
+//    Param: (int**) cells (Pointer to A 2D Dynamic Interger Array holding the pattern)
+//           (int) HEIGHT (HEIGHT of the pattern)
+//           (int) WIDTH (WIDTH of the pattern)
+//           (int) size (Largest height and width accepted)
+//           (SearchShape*) shape (Receives the cropped pattern)
+//    Return: (int) 0 on success, -1 if the pattern is empty or larger than size
+static int searchCrop(int **cells, int HEIGHT, int WIDTH, int size, SearchShape *shape)
+{
+    int top = HEIGHT, bottom = -1, left = WIDTH, right = -1;
+    for (int i = 0; i < HEIGHT; i++)
+    {
+        for (int j = 0; j < WIDTH; j++)
+        {
+            if (cells[i][j])
+            {
+                top = i < top ? i : top;
+                bottom = i;
+                left = j < left ? j : left;
+                right = j > right ? j : right;
+            }
+        }
+    }
+    if (bottom < 0 || bottom - top + 1 > size || right - left + 1 > size)
+    {
+        return -1;
+    }
+
+    shape->height = bottom - top + 1;
+    shape->width = right - left + 1;
+    for (int i = 0; i < shape->height; i++)
+    {
+        for (int j = 0; j < shape->width; j++)
+        {
+            shape->cells[i][j] = cells[top + i][left + j] != 0;
+        }
+    }
+    return 0;
+}
+
+// Calculate the next generation of a pattern on its own, on an empty plane
+//    Param: (SearchShape*) from (The pattern)
+//           (SearchShape*) to (Receives the next generation, cropped)
+//           (int) size (Largest height and width accepted)
+//    Return: (int) 0 on success, -1 if the pattern died or grew larger than size
+static int searchEvolve(SearchShape *from, SearchShape *to, int size)
+{
+    // The next generation can only grow by one Cell on every side
+    int HEIGHT = from->height + 2, WIDTH = from->width + 2;
+    int rows[SEARCH_MAX_SIZE + 2][SEARCH_MAX_SIZE + 2];
+    int *grid[SEARCH_MAX_SIZE + 2];
+
+    for (int i = 0; i < HEIGHT; i++)
+    {
+        grid[i] = rows[i];
+        for (int j = 0; j < WIDTH; j++)
+        {
+            int neighbours = 0, alive = 0;
+            for (int di = -1; di <= 1; di++)
+            {
+                for (int dj = -1; dj <= 1; dj++)
+                {
+                    int r = i + di - 1, c = j + dj - 1;
+                    int cell = r >= 0 && r < from->height && c >= 0 && c < from->width && from->cells[r][c];
+                    if (di == 0 && dj == 0)
+                    {
+                        alive = cell;
+                    }
+                    else
+                    {
+                        neighbours += cell;
+                    }
+                }
+            }
+            rows[i][j] = neighbours == 3 || (alive && neighbours == 2);
+        }
+    }
+
+    return searchCrop(grid, HEIGHT, WIDTH, size, to);
+}
+
+// Turn a pattern into one of the 8 orientations: mirrored left to right or not, then turned clockwise
+//    Param: (SearchShape*) from (The pattern)
+//           (int) orientation (The orientation, 0 to 3 turned, 4 to 7 mirrored then turned)
+//           (SearchShape*) to (Receives the pattern turned)
+static void searchOrient(SearchShape *from, int orientation, SearchShape *to)
+{
+    int turns = orientation % 4;
+    int mirrored = orientation >= 4;
+
+    to->height = turns % 2 ? from->width : from->height;
+    to->width = turns % 2 ? from->height : from->width;
+    for (int i = 0; i < from->height; i++)
+    {
+        for (int j = 0; j < from->width; j++)
+        {
+            int c = mirrored ? from->width - 1 - j : j;
+            int r = i;
+            int w = from->width;
+            int h = from->height;
+            // A clockwise turn sends (r, c) of an h x w pattern to (c, h - 1 - r)
+            for (int t = 0; t < turns; t++)
+            {
+                int turned = c;
+                c = h - 1 - r;
+                r = turned;
+                int swap = h;
+                h = w;
+                w = swap;
+            }
+            to->cells[r][c] = from->cells[i][j];
+        }
+    }
+}
+
+// Whether two patterns are the same, up to where they sit on the plane
+//    Param: (SearchShape*) a (A pattern)
+//           (SearchShape*) b (Another pattern)
+//    Return: (int) 1 if they are, 0 if not
+static int searchSameShape(SearchShape *a, SearchShape *b)
+{
+    if (a->height != b->height || a->width != b->width)
+    {
+        return 0;
+    }
+    for (int i = 0; i < a->height; i++)
+    {
+        if (memcmp(a->cells[i], b->cells[i], a->width) != 0)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Compile a phase of a pattern in one orientation into a variant, unless the pattern already has the same one
+//    Param: (PatternSearch*) search (The search)
+//           (SearchShape*) shape (The pattern turned)
+//           (int) pattern (Index of the pattern)
+//           (int) orientation (The orientation)
+//           (int) phase (The phase)
+//    Return: (int) 0 on success, -1 if memory ran out
+static int searchAddVariant(PatternSearch *search, SearchShape *shape, int pattern, int orientation, int phase)
+{
+    int margin = search->margin;
+    SearchVariant variant;
+    memset(&variant, 0, sizeof(SearchVariant));
+    variant.pattern = pattern;
+    variant.orientation = orientation;
+    variant.phase = phase;
+    variant.height = shape->height;
+    variant.width = shape->width;
+    variant.windowHeight = shape->height + 2 * margin;
+    variant.windowWidth = shape->width + 2 * margin;
+    for (int i = 0; i < shape->height; i++)
+    {
+        for (int j = 0; j < shape->width; j++)
+        {
+            variant.live[i + margin] |= (uint64_t)shape->cells[i][j] << (j + margin);
+        }
+    }
+
+    for (int v = search->variantCount - 1; v >= 0 && search->variants[v].pattern == pattern; v--)
+    {
+        SearchVariant *other = &search->variants[v];
+        if (other->height == variant.height && other->width == variant.width && memcmp(other->live, variant.live, sizeof(variant.live)) == 0)
+        {
+            return 0;
+        }
+    }
+
+    // Live Cells are rare on a board, testing them first rules most places out at once
+    variant.tests = (SearchTest *)malloc(sizeof(SearchTest) * variant.windowHeight * variant.windowWidth);
+    SearchVariant *variants = (SearchVariant *)realloc(search->variants, sizeof(SearchVariant) * (search->variantCount + 1));
+    if (variant.tests == NULL || variants == NULL)
+    {
+        free(variant.tests);
+        search->variants = variants != NULL ? variants : search->variants;
+        return -1;
+    }
+    search->variants = variants;
+    for (int alive = 1; alive >= 0; alive--)
+    {
+        for (int i = 0; i < variant.windowHeight; i++)
+        {
+            for (int j = 0; j < variant.windowWidth; j++)
+            {
+                if ((int)((variant.live[i] >> j) & 1) == alive)
+                {
+                    variant.tests[variant.testCount++] = (SearchTest){(unsigned char)i, (unsigned char)j, (unsigned char)alive};
+                }
+            }
+        }
+    }
+
+    search->variants[search->variantCount++] = variant;
+    return 0;
+}
+
+/* ----------------------- Functions to search a board ----------------------- */
+// Read 64 Cells of a packed row, starting at any column
+//    Param: (uint64_t*) row (The packed row)
+//           (int) column (Column of the first Cell, from -64 on)
+//    Return: (uint64_t) The Cells, the first one in the lowest bit
+static inline uint64_t searchCells(const uint64_t *row, int column)
+{
+    int bit = column + SEARCH_PAD_WORDS * SEARCH_WORD_BITS;
+    int word = bit / SEARCH_WORD_BITS;
+    int shift = bit % SEARCH_WORD_BITS;
+    return shift == 0 ? row[word] : (row[word] >> shift) | (row[word + 1] << (SEARCH_WORD_BITS - shift));
+}
+
+// Packed row of the board, the dead row above and below it
+//    Param: (PatternSearch*) search (The search)
+//           (int) i (Row of the board)
+//    Return: (uint64_t*) The packed row
+static inline const uint64_t *searchRow(PatternSearch *search, int i)
+{
+    return i < 0 || i >= search->HEIGHT ? search->deadRow : search->packed + (size_t)i * search->stride;
+}
+
+// Pack a band of rows of the board into bits
+//    Param: (SearchWorker*) worker (The thread and its rows)
+static void searchPack(SearchWorker *worker)
+{
+    PatternSearch *search = worker->search;
+    for (int i = worker->firstRow; i < worker->lastRow; i++)
+    {
+        uint64_t *row = search->packed + (size_t)i * search->stride;
+        memset(row, 0, search->stride * sizeof(uint64_t));
+        for (int j = 0; j < search->WIDTH; j++)
+        {
+            row[SEARCH_PAD_WORDS + j / SEARCH_WORD_BITS] |= (uint64_t)(search->board[i][j] != 0) << (j % SEARCH_WORD_BITS);
+        }
+    }
+}
+
+// Keep a match found by a thread
+//    Param: (SearchWorker*) worker (The thread)
+//           (SearchVariant*) variant (The variant found)
+//           (int) row (Row of its upper left corner)
+//           (int) column (Column of its upper left corner)
+static void searchKeep(SearchWorker *worker, SearchVariant *variant, int row, int column)
+{
+    if (worker->matchCount == worker->matchSize)
+    {
+        int size = worker->matchSize ? worker->matchSize * 2 : SEARCH_INITIAL_MATCHES;
+        SearchMatch *matches = (SearchMatch *)realloc(worker->matches, sizeof(SearchMatch) * size);
+        if (matches == NULL)
+        {
+            worker->failed = 1;
+            return;
+        }
+        worker->matches = matches;
+        worker->matchSize = size;
+    }
+    worker->matches[worker->matchCount++] = (SearchMatch){variant->pattern, row, column, variant->orientation, variant->phase};
+}
+
+// Look for every variant with its upper left corner in a band of rows, 64 columns at once
+//    Param: (SearchWorker*) worker (The thread and its rows)
+static void searchScan(SearchWorker *worker)
+{
+    PatternSearch *search = worker->search;
+    int margin = search->margin;
+
+    for (int v = 0; v < search->variantCount; v++)
+    {
+        SearchVariant *variant = &search->variants[v];
+        int lastRow = search->HEIGHT - variant->height;
+        int lastColumn = search->WIDTH - variant->width;
+        for (int i = worker->firstRow; i < worker->lastRow && i <= lastRow; i++)
+        {
+            for (int column = 0; column <= lastColumn; column += SEARCH_WORD_BITS)
+            {
+                // Bit k stands for the variant placed at column + k, as far as it fits on the board
+                uint64_t candidates = ~(uint64_t)0;
+                if (lastColumn - column < SEARCH_WORD_BITS - 1)
+                {
+                    candidates >>= SEARCH_WORD_BITS - 1 - (lastColumn - column);
+                }
+
+                for (int t = 0; t < variant->testCount && candidates; t++)
+                {
+                    SearchTest *test = &variant->tests[t];
+                    uint64_t cells = searchCells(searchRow(search, i - margin + test->row), column - margin + test->column);
+                    candidates &= test->alive ? cells : ~cells;
+                }
+
+                while (candidates)
+                {
+                    int k = __builtin_ctzll(candidates);
+                    searchKeep(worker, variant, i, column + k);
+                    candidates &= candidates - 1;
+                }
+            }
+        }
+    }
+}
+
+// Pack a band of rows, wait for the other threads to pack theirs, then search the band
+//    Param: (void*) argument (The SearchWorker)
+//    Return: (void*) NULL
+static void *searchWorkerThread(void *argument)
+{
+    SearchWorker *worker = (SearchWorker *)argument;
+    pthread_mutex_lock(&worker->search->launch);
+    pthread_mutex_unlock(&worker->search->launch);
+
+    searchPack(worker);
+    if (worker->search->running > 1)
+    {
+        pthread_barrier_wait(&worker->search->packedBarrier);
+    }
+    searchScan(worker);
+    return NULL;
+}
+
+// Order matches by row, column, pattern, orientation and phase
+//    Param: (void*) a (A SearchMatch)
+//           (void*) b (Another SearchMatch)
+//    Return: (int) Less than, equal to or greater than 0 as a comes before, with or after b
+static int searchCompareMatches(const void *a, const void *b)
+{
+    const SearchMatch *x = (const SearchMatch *)a;
+    const SearchMatch *y = (const SearchMatch *)b;
+    if (x->row != y->row)
+    {
+        return x->row < y->row ? -1 : 1;
+    }
+    if (x->column != y->column)
+    {
+        return x->column < y->column ? -1 : 1;
+    }
+    if (x->pattern != y->pattern)
+    {
+        return x->pattern < y->pattern ? -1 : 1;
+    }
+    if (x->orientation != y->orientation)
+    {
+        return x->orientation < y->orientation ? -1 : 1;
+    }
+    return x->phase < y->phase ? -1 : x->phase > y->phase;
+}
+
+/* ----------------------------- Pattern Search API -------------------------- */
+PatternSearch *searchCreate(int margin, int threads)
+{
+    if (margin < 0 || 2 * margin >= SEARCH_MAX_SIZE)
+    {
+        return NULL;
+    }
+
+    PatternSearch *search = (PatternSearch *)calloc(1, sizeof(PatternSearch));
+    if (search == NULL)
+    {
+        return NULL;
+    }
+
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    search->margin = margin;
+    search->threads = threads > 0 ? threads : (cores > 0 ? (int)cores : 1);
+    search->workers = (SearchWorker *)calloc(search->threads, sizeof(SearchWorker));
+    if (search->workers == NULL)
+    {
+        free(search);
+        return NULL;
+    }
+    for (int w = 0; w < search->threads; w++)
+    {
+        search->workers[w].search = search;
+    }
+    pthread_mutex_init(&search->launch, NULL);
+
+    return search;
+}
+
+int searchAddPattern(PatternSearch *search, const char *name, int **cells, int HEIGHT, int WIDTH, int phases)
+{
+    int size = SEARCH_MAX_SIZE - 2 * search->margin;
+    int limit = phases > 0 && phases < SEARCH_MAX_PHASES ? phases : SEARCH_MAX_PHASES;
+    SearchShape *shapes = (SearchShape *)malloc(sizeof(SearchShape) * (SEARCH_MAX_PHASES + 1));
+    char *copy = strdup(name);
+    char **names = (char **)realloc(search->names, sizeof(char *) * (search->patternCount + 1));
+    if (names != NULL)
+    {
+        search->names = names;
+    }
+    if (shapes == NULL || copy == NULL || names == NULL || searchCrop(cells, HEIGHT, WIDTH, size, &shapes[0]) != 0)
+    {
+        free(shapes);
+        free(copy);
+        return -1;
+    }
+
+    // Let the pattern run until it comes back to its first phase, up to where it sits
+    int count = 1;
+    int repeats = 0;
+    while (count < limit && searchEvolve(&shapes[count - 1], &shapes[count], size) == 0)
+    {
+        if (searchSameShape(&shapes[count], &shapes[0]))
+        {
+            repeats = 1;
+            break;
+        }
+        count++;
+    }
+
+    // A pattern that never repeats (a gun and its gliders, a pattern settling) is only looked for as given
+    if (phases == 0 && !repeats)
+    {
+        count = 1;
+    }
+
+    int pattern = search->patternCount;
+    int first = search->variantCount;
+    int failed = 0;
+    SearchShape turned;
+    for (int phase = 0; phase < count && !failed; phase++)
+    {
+        for (int orientation = 0; orientation < 8 && !failed; orientation++)
+        {
+            searchOrient(&shapes[phase], orientation, &turned);
+            failed = searchAddVariant(search, &turned, pattern, orientation, phase) != 0;
+        }
+    }
+    free(shapes);
+
+    if (failed)
+    {
+        while (search->variantCount > first)
+        {
+            free(search->variants[--search->variantCount].tests);
+        }
+        free(copy);
+        return -1;
+    }
+
+    search->names[search->patternCount++] = copy;
+    return pattern;
+}
+
+int searchAddNamed(PatternSearch *search, const char *name)
+{
+    int rows[SEARCH_MAX_SIZE][SEARCH_MAX_SIZE];
+    int *cells[SEARCH_MAX_SIZE];
+
+    for (size_t p = 0; p < sizeof(namedPatterns) / sizeof(namedPatterns[0]); p++)
+    {
+        if (strcmp(namedPatterns[p].name, name) == 0)
+        {
+            int HEIGHT = 0, WIDTH = (int)strlen(namedPatterns[p].rows[0]);
+            for (; HEIGHT < 4 && namedPatterns[p].rows[HEIGHT] != NULL; HEIGHT++)
+            {
+                cells[HEIGHT] = rows[HEIGHT];
+                for (int j = 0; j < WIDTH; j++)
+                {
+                    rows[HEIGHT][j] = namedPatterns[p].rows[HEIGHT][j] == 'O';
+                }
+            }
+            return searchAddPattern(search, name, cells, HEIGHT, WIDTH, 0);
+        }
+    }
+
+    // A board saved by the game: its height and width, then its Cells row by row
+    FILE *file = fopen(name, "rb");
+    if (file == NULL)
+    {
+        return -1;
+    }
+    int HEIGHT = 0, WIDTH = 0;
+    int **board = NULL;
+    int read = fread(&HEIGHT, sizeof(int), 1, file) == 1 && fread(&WIDTH, sizeof(int), 1, file) == 1 && HEIGHT > 0 && WIDTH > 0;
+    if (read)
+    {
+        board = (int **)calloc(HEIGHT, sizeof(int *));
+        read = board != NULL;
+    }
+    for (int i = 0; i < HEIGHT && read; i++)
+    {
+        board[i] = (int *)malloc(sizeof(int) * WIDTH);
+        read = board[i] != NULL && fread(board[i], sizeof(int), WIDTH, file) == (size_t)WIDTH;
+    }
+    fclose(file);
+
+    int pattern = read ? searchAddPattern(search, name, board, HEIGHT, WIDTH, 0) : -1;
+    for (int i = 0; board != NULL && i < HEIGHT; i++)
+    {
+        free(board[i]);
+    }
+    free(board);
+    return pattern;
+}
+
+int searchRun(PatternSearch *search, int **board, int HEIGHT, int WIDTH, SearchMatch **matches)
+{
+    // One word of padding left, the Cells, and words right for the windows reading past the last column
+    size_t stride = SEARCH_PAD_WORDS + ((size_t)WIDTH + SEARCH_WORD_BITS - 1) / SEARCH_WORD_BITS + 3;
+    size_t packedSize = stride * (HEIGHT + 1);
+    if (packedSize > search->packedSize)
+    {
+        free(search->packed);
+        search->packed = (uint64_t *)malloc(packedSize * sizeof(uint64_t));
+        search->packedSize = search->packed != NULL ? packedSize : 0;
+        if (search->packed == NULL)
+        {
+            return -1;
+        }
+    }
+    search->board = board;
+    search->HEIGHT = HEIGHT;
+    search->WIDTH = WIDTH;
+    search->stride = stride;
+    search->deadRow = search->packed + stride * HEIGHT;
+    memset(search->deadRow, 0, stride * sizeof(uint64_t));
+
+    // The calling thread is worker 0, the others get threads of their own for this search
+    pthread_mutex_lock(&search->launch);
+    search->running = 1;
+    while (search->running < search->threads && pthread_create(&search->workers[search->running].thread, NULL, searchWorkerThread, &search->workers[search->running]) == 0)
+    {
+        search->running++;
+    }
+    if (search->running > 1)
+    {
+        pthread_barrier_init(&search->packedBarrier, NULL, search->running);
+    }
+    for (int w = 0; w < search->threads; w++)
+    {
+        SearchWorker *worker = &search->workers[w];
+        int band = w < search->running ? w : search->running;
+        worker->firstRow = (int)((long)HEIGHT * band / search->running);
+        worker->lastRow = (int)((long)HEIGHT * (w < search->running ? band + 1 : band) / search->running);
+        worker->matchCount = 0;
+        worker->failed = 0;
+    }
+    pthread_mutex_unlock(&search->launch);
+    searchWorkerThread(&search->workers[0]);
+
+    int count = 0;
+    int failed = 0;
+    for (int w = 0; w < search->threads; w++)
+    {
+        if (w > 0 && w < search->running)
+        {
+            pthread_join(search->workers[w].thread, NULL);
+        }
+        count += search->workers[w].matchCount;
+        failed |= search->workers[w].failed;
+    }
+    if (search->running > 1)
+    {
+        pthread_barrier_destroy(&search->packedBarrier);
+    }
+
+    if (count > search->matchSize)
+    {
+        SearchMatch *all = (SearchMatch *)realloc(search->matches, sizeof(SearchMatch) * count);
+        if (all == NULL)
+        {
+            return -1;
+        }
+        search->matches = all;
+        search->matchSize = count;
+    }
+    int m = 0;
+    for (int w = 0; w < search->threads; w++)
+    {
+        if (search->workers[w].matchCount > 0)
+        {
+            memcpy(search->matches + m, search->workers[w].matches, sizeof(SearchMatch) * search->workers[w].matchCount);
+            m += search->workers[w].matchCount;
+        }
+    }
+    if (count > 1)
+    {
+        qsort(search->matches, count, sizeof(SearchMatch), searchCompareMatches);
+    }
+
+    *matches = search->matches;
+    return failed ? -1 : count;
+}
+
+int searchPatterns(PatternSearch *search)
+{
+    return search->patternCount;
+}
+
+int searchVariants(PatternSearch *search)
+{
+    return search->variantCount;
+}
+
+const char *searchPatternName(PatternSearch *search, int pattern)
+{
+    return search->names[pattern];
+}
+
+const char *searchOrientationName(int orientation)
+{
+    return orientationNames[orientation & 7];
+}
+
+void searchWriteMatches(PatternSearch *search, FILE *stream, long generation, SearchMatch *matches, int count)
+{
+    for (int m = 0; m < count; m++)
+    {
+        fprintf(stream, "%ld,%s,%d,%d,%s,%d\n", generation, search->names[matches[m].pattern], matches[m].row, matches[m].column, searchOrientationName(matches[m].orientation), matches[m].phase);
+    }
+}
+
+void searchFree(PatternSearch *search)
+{
+    if (search == NULL)
+    {
+        return;
+    }
+
+    for (int p = 0; p < search->patternCount; p++)
+    {
+        free(search->names[p]);
+    }
+    for (int v = 0; v < search->variantCount; v++)
+    {
+        free(search->variants[v].tests);
+    }
+    for (int w = 0; w < search->threads; w++)
+    {
+        free(search->workers[w].matches);
+    }
+    pthread_mutex_destroy(&search->launch);
+    free(search->names);
+    free(search->variants);
+    free(search->workers);
+    free(search->packed);
+    free(search->matches);
+    free(search);
+}
@@ -0,0 +1,317 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include <perfcount.h>
+
+/* -------------------------------------------------------------------------- */
+/*     Hardware performance counters around the calculation of generations     */
+/* -------------------------------------------------------------------------- */
+
+// Samples kept before the first one grows the list
+#define PERF_FIRST_CAPACITY 1024
+
+struct PerfCounters
+{
+    int fds[PERF_EVENTS];
+    int available;
+
+    // Errno of the first event the kernel refused, 0 if none was
+    int refused;
+
+    // Scaled counts when the running sample started
+    double started[PERF_EVENTS];
+
+    PerfSample total;
+    PerfSample *samples;
+    int count;
+    int capacity;
+};
+
+// Names of the events, in the order of PerfEvent
+static const char *perfEventNames[PERF_EVENTS] = {"cycles", "instructions", "llc_misses", "branches", "branch_misses"};
+
+// Generic hardware events of the kernel, in the order of PerfEvent (cache misses are last level cache misses)
+static const unsigned long long perfEventConfigs[PERF_EVENTS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+                                                                 PERF_COUNT_HW_BRANCH_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES};
+
+/* ------------------------- Utilities of the Counters ----------------------- */
+// Open a counter of the calling thread and of the threads and processes it starts from now on
+//    Param: (unsigned long long) config (Generic hardware event)
+//    Return: (int) File descriptor of the counter, -1 with errno set if the kernel refused it
+static int perfOpen(unsigned long long config)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.inherit = 1;
+
+    // User space only, which a perf_event_paranoid of 2 still allows
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    // More events than hardware counters are multiplexed, the times let the counts be scaled back
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+// Read a counter, scaled up for the time it was not scheduled on the hardware
+//    Param: (int) fd (File descriptor of the counter)
+//    Return: (double) The count, 0 if it could not be read
+static double perfRead(int fd)
+{
+    uint64_t values[3];
+    if (read(fd, values, sizeof(values)) != sizeof(values) || values[2] == 0)
+    {
+        return 0;
+    }
+    return values[2] < values[1] ? (double)values[0] * values[1] / values[2] : (double)values[0];
+}
+
+// Ratio of two counts
+//    Param: (double) numerator, denominator (The counts, -1 if not counted)
+//    Return: (double) The ratio, -1 if a count is missing or the denominator is 0
+static double perfRatio(double numerator, double denominator)
+{
+    if (numerator < 0 || denominator <= 0)
+    {
+        return -1;
+    }
+    return numerator / denominator;
+}
+
+// Print a ratio, or n/a if it is missing
+//    Param: (FILE*) stream (Where to print)
+//           (string) format (printf format of the ratio)
+//           (double) ratio (The ratio, -1 if missing)
+static void perfPrintRatio(FILE *stream, const char *format, double ratio)
+{
+    if (ratio < 0)
+    {
+        fprintf(stream, "n/a");
+    }
+    else
+    {
+        fprintf(stream, format, ratio);
+    }
+}
+
+/* ------------------------------ Counters API ------------------------------- */
+PerfCounters *perfCountersOpen()
+{
+    PerfCounters *counters = (PerfCounters *)calloc(1, sizeof(PerfCounters));
+    if (counters == NULL)
+    {
+        return NULL;
+    }
+
+    for (int e = 0; e < PERF_EVENTS; e++)
+    {
+        counters->fds[e] = perfOpen(perfEventConfigs[e]);
+        if (counters->fds[e] >= 0)
+        {
+            counters->available++;
+            counters->total.counts[e] = 0;
+        }
+        else
+        {
+            if (counters->refused == 0)
+            {
+                counters->refused = errno;
+            }
+            counters->total.counts[e] = -1;
+        }
+    }
+
+    return counters;
+}
+
+int perfCountersAvailable(PerfCounters *counters)
+{
+    return counters->available;
+}
+
+void perfCountersStart(PerfCounters *counters)
+{
+    for (int e = 0; e < PERF_EVENTS; e++)
+    {
+        if (counters->fds[e] >= 0)
+        {
+            counters->started[e] = perfRead(counters->fds[e]);
+        }
+    }
+}
+
+void perfCountersStop(PerfCounters *counters, long first, long generations, double cells)
+{
+    if (counters->available == 0 || generations <= 0)
+    {
+        return;
+    }
+
+    PerfSample sample;
+    sample.first = first;
+    sample.generations = generations;
+    sample.cells = cells * generations;
+    for (int e = 0; e < PERF_EVENTS; e++)
+    {
+        if (counters->fds[e] < 0)
+        {
+            sample.counts[e] = -1;
+            continue;
+        }
+
+        // Scaling a multiplexed counter can make it go back a little, never by a whole generation
+        double count = perfRead(counters->fds[e]) - counters->started[e];
+        sample.counts[e] = count > 0 ? count : 0;
+        counters->total.counts[e] += sample.counts[e];
+    }
+    counters->total.generations += generations;
+    counters->total.cells += sample.cells;
+
+    if (counters->count == counters->capacity)
+    {
+        // Doubling keeps appending amortised constant time, a sample that does not fit only misses the CSV
+        int capacity = counters->capacity > 0 ? 2 * counters->capacity : PERF_FIRST_CAPACITY;
+        PerfSample *samples = (PerfSample *)realloc(counters->samples, capacity * sizeof(PerfSample));
+        if (samples == NULL)
+        {
+            return;
+        }
+        counters->samples = samples;
+        counters->capacity = capacity;
+    }
+    counters->samples[counters->count++] = sample;
+}
+
+PerfSample *perfCountersTotal(PerfCounters *counters)
+{
+    return &counters->total;
+}
+
+double perfSampleIpc(PerfSample *sample)
+{
+    return perfRatio(sample->counts[PERF_INSTRUCTIONS], sample->counts[PERF_CYCLES]);
+}
+
+double perfSampleMissesPerCell(PerfSample *sample)
+{
+    return perfRatio(sample->counts[PERF_CACHE_MISSES], sample->cells);
+}
+
+double perfSampleBranchMissRate(PerfSample *sample)
+{
+    return perfRatio(sample->counts[PERF_BRANCH_MISSES], sample->counts[PERF_BRANCHES]);
+}
+
+void perfCountersReport(PerfCounters *counters, FILE *stream)
+{
+    if (counters->available == 0)
+    {
+        fprintf(stream, "Hardware counters are not available here (perf_event_open: %s).\n", strerror(counters->refused));
+        return;
+    }
+
+    PerfSample *total = &counters->total;
+    fprintf(stream, "Hardware counters over %ld generations:\n", total->generations);
+    for (int e = 0; e < PERF_EVENTS; e++)
+    {
+        if (total->counts[e] < 0)
+        {
+            fprintf(stream, "    %-14s not counted\n", perfEventNames[e]);
+        }
+        else
+        {
+            fprintf(stream, "    %-14s %.0f (%.1f per generation)\n", perfEventNames[e], total->counts[e],
+                    total->generations > 0 ? total->counts[e] / total->generations : 0.0);
+        }
+    }
+
+    fprintf(stream, "    IPC ");
+    perfPrintRatio(stream, "%.2f", perfSampleIpc(total));
+    fprintf(stream, " | LLC misses per Cell ");
+    perfPrintRatio(stream, "%.4f", perfSampleMissesPerCell(total));
+    fprintf(stream, " | Branch misses ");
+    perfPrintRatio(stream, "%.2f%%", 100 * perfSampleBranchMissRate(total));
+    fprintf(stream, "\n");
+
+    if (counters->refused != 0)
+    {
+        fprintf(stream, "    Some events could not be counted (perf_event_open: %s).\n", strerror(counters->refused));
+    }
+}
+
+int perfCountersWrite(PerfCounters *counters, char *fileName)
+{
+    FILE *file = fopen(fileName, "w");
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    fprintf(file, "first_generation,generations");
+    for (int e = 0; e < PERF_EVENTS; e++)
+    {
+        fprintf(file, ",%s", perfEventNames[e]);
+    }
+    fprintf(file, ",ipc,llc_misses_per_cell,branch_miss_rate\n");
+
+    // Counts are per generation, a run calculated in one go is spread evenly over its generations
+    for (int i = 0; i < counters->count; i++)
+    {
+        PerfSample *sample = &counters->samples[i];
+        double ratios[3] = {perfSampleIpc(sample), perfSampleMissesPerCell(sample), perfSampleBranchMissRate(sample)};
+
+        fprintf(file, "%ld,%ld", sample->first, sample->generations);
+        for (int e = 0; e < PERF_EVENTS; e++)
+        {
+            if (sample->counts[e] < 0)
+            {
+                fprintf(file, ",");
+            }
+            else
+            {
+                fprintf(file, ",%.0f", sample->counts[e] / sample->generations);
+            }
+        }
+        for (int r = 0; r < 3; r++)
+        {
+            if (ratios[r] < 0)
+            {
+                fprintf(file, ",");
+            }
+            else
+            {
+                fprintf(file, ",%.6f", ratios[r]);
+            }
+        }
+        fprintf(file, "\n");
+    }
+
+    return fclose(file) == 0 ? 0 : -1;
+}
+
+void perfCountersClose(PerfCounters *counters)
+{
+    if (counters == NULL)
+    {
+        return;
+    }
+
+    for (int e = 0; e < PERF_EVENTS; e++)
+    {
+        if (counters->fds[e] >= 0)
+        {
+            close(counters->fds[e]);
+        }
+    }
+    free(counters->samples);
+    free(counters);
+}
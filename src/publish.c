@@ -0,0 +1,345 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <publish.h>
+
+/* -------------------------------------------------------------------------- */
+/*      Frames of a running game published in POSIX shared memory (seqlock)   */
+/* -------------------------------------------------------------------------- */
+
+// Marks a shared memory object as a ring of Life frames
+#define PUBLISH_MAGIC 0x4C494645
+
+// Size of a cache line, every frame starts on its own lines
+#define PUBLISH_CACHE_LINE 64
+
+// Times a viewer tries to copy a frame the writer is overwriting before giving up for now
+#define PUBLISH_RETRIES 8
+
+/* ----------------------- Layout of the shared memory ----------------------- */
+// Header of the ring, written once before any frame.
+struct PublishHeader
+{
+    int magic;
+    int HEIGHT;
+    int WIDTH;
+    int slots;
+    size_t frameSize;
+
+    // Number of frames published so far, the newest being in slot (published - 1) % slots
+    _Alignas(PUBLISH_CACHE_LINE) atomic_ulong published;
+};
+typedef struct PublishHeader PublishHeader;
+
+// A frame: the seqlock, then the statistics and the Cells packed in bits row by row.
+struct PublishFrame
+{
+    _Alignas(PUBLISH_CACHE_LINE) atomic_ulong sequence;
+    GenerationStats stats;
+    uint64_t cells[];
+};
+typedef struct PublishFrame PublishFrame;
+
+struct Publisher
+{
+    char *name;
+    void *shared;
+    size_t sharedSize;
+    PublishHeader *header;
+    size_t words;
+};
+
+struct Viewer
+{
+    void *shared;
+    size_t sharedSize;
+    PublishHeader *header;
+
+    // The layout, read once from the header and checked against the size of the object
+    int HEIGHT;
+    int WIDTH;
+    int slots;
+    size_t frameSize;
+    size_t words;
+    uint64_t *copy;
+
+    // Frames published when the last frame was copied
+    unsigned long seen;
+};
+
+/* --------------------------- Utilities of the Ring ------------------------- */
+// Name of the shared memory object, with the leading '/' POSIX asks for
+//    Param: (string) name (Name given by the user)
+//    Return: (string) Allocated name, NULL if out of memory
+static char *publishName(char *name)
+{
+    char *shmName = (char *)malloc(strlen(name) + 2);
+    if (shmName != NULL)
+    {
+        sprintf(shmName, "%s%s", name[0] == '/' ? "" : "/", name);
+    }
+    return shmName;
+}
+
+// Size of the header, rounded to cache lines
+//    Return: (size_t) Size in bytes
+static size_t publishHeaderSize()
+{
+    return (sizeof(PublishHeader) + PUBLISH_CACHE_LINE - 1) / PUBLISH_CACHE_LINE * PUBLISH_CACHE_LINE;
+}
+
+// Size of a frame with its board in bits, rounded to cache lines
+//    Param: (size_t) words (64-bit words holding the board)
+//    Return: (size_t) Size in bytes
+static size_t publishFrameSize(size_t words)
+{
+    size_t size = sizeof(PublishFrame) + words * sizeof(uint64_t);
+    return (size + PUBLISH_CACHE_LINE - 1) / PUBLISH_CACHE_LINE * PUBLISH_CACHE_LINE;
+}
+
+// A frame of the ring
+//    Param: (PublishHeader*) header (Header of the ring)
+//           (size_t) frameSize (Size of a frame)
+//           (unsigned long) slot (Slot of the frame)
+//    Return: (PublishFrame*) The frame
+static PublishFrame *publishFrame(PublishHeader *header, size_t frameSize, unsigned long slot)
+{
+    return (PublishFrame *)((unsigned char *)header + publishHeaderSize() + slot * frameSize);
+}
+
+/* -------------------------------- Writer Side ------------------------------ */
+Publisher *publisherCreate(char *name, int HEIGHT, int WIDTH)
+{
+    Publisher *publisher = (Publisher *)calloc(1, sizeof(Publisher));
+    if (publisher == NULL)
+    {
+        return NULL;
+    }
+
+    publisher->name = publishName(name);
+    publisher->words = ((size_t)HEIGHT * WIDTH + 63) / 64;
+    size_t frameSize = publishFrameSize(publisher->words);
+    publisher->sharedSize = publishHeaderSize() + PUBLISH_SLOTS * frameSize;
+
+    // Never an object already there: truncating the one of a game still publishing would fault its mappings
+    int fd = publisher->name != NULL ? shm_open(publisher->name, O_CREAT | O_EXCL | O_RDWR, 0600) : -1;
+    if (fd < 0)
+    {
+        int error = publisher->name != NULL ? errno : ENOMEM;
+        free(publisher->name);
+        free(publisher);
+        errno = error;
+        return NULL;
+    }
+
+    if (ftruncate(fd, publisher->sharedSize) != 0)
+    {
+        close(fd);
+        shm_unlink(publisher->name);
+        free(publisher->name);
+        free(publisher);
+        return NULL;
+    }
+
+    publisher->shared = mmap(NULL, publisher->sharedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (publisher->shared == MAP_FAILED)
+    {
+        shm_unlink(publisher->name);
+        free(publisher->name);
+        free(publisher);
+        return NULL;
+    }
+
+    // The object is zero filled: every sequence is even and nothing is published yet
+    publisher->header = (PublishHeader *)publisher->shared;
+    publisher->header->HEIGHT = HEIGHT;
+    publisher->header->WIDTH = WIDTH;
+    publisher->header->slots = PUBLISH_SLOTS;
+    publisher->header->frameSize = frameSize;
+    atomic_init(&publisher->header->published, 0);
+
+    // Viewers check the magic last, once the rest of the header can be trusted
+    atomic_thread_fence(memory_order_release);
+    publisher->header->magic = PUBLISH_MAGIC;
+
+    return publisher;
+}
+
+void publisherPublish(Publisher *publisher, int **currentBoard, GenerationStats *stats)
+{
+    PublishHeader *header = publisher->header;
+    unsigned long published = atomic_load_explicit(&header->published, memory_order_relaxed);
+    PublishFrame *frame = publishFrame(header, header->frameSize, published % header->slots);
+
+    // Odd sequence: the frame is being written, viewers copying it will throw their copy away
+    unsigned long sequence = atomic_load_explicit(&frame->sequence, memory_order_relaxed);
+    atomic_store_explicit(&frame->sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    frame->stats = *stats;
+    memset(frame->cells, 0, publisher->words * sizeof(uint64_t));
+    size_t bit = 0;
+    for (int i = 0; i < header->HEIGHT; i++)
+    {
+        for (int j = 0; j < header->WIDTH; j++, bit++)
+        {
+            frame->cells[bit / 64] |= (uint64_t)(currentBoard[i][j] == 1) << (bit % 64);
+        }
+    }
+
+    atomic_store_explicit(&frame->sequence, sequence + 2, memory_order_release);
+    atomic_store_explicit(&header->published, published + 1, memory_order_release);
+}
+
+void publisherFree(Publisher *publisher)
+{
+    if (publisher == NULL)
+    {
+        return;
+    }
+
+    munmap(publisher->shared, publisher->sharedSize);
+    shm_unlink(publisher->name);
+    free(publisher->name);
+    free(publisher);
+}
+
+/* -------------------------------- Viewer Side ------------------------------ */
+Viewer *viewerOpen(char *name)
+{
+    char *shmName = publishName(name);
+    int fd = shmName != NULL ? shm_open(shmName, O_RDONLY, 0) : -1;
+    free(shmName);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(PublishHeader))
+    {
+        close(fd);
+        return NULL;
+    }
+
+    Viewer *viewer = (Viewer *)calloc(1, sizeof(Viewer));
+    if (viewer == NULL)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    viewer->sharedSize = info.st_size;
+    viewer->shared = mmap(NULL, viewer->sharedSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (viewer->shared == MAP_FAILED)
+    {
+        free(viewer);
+        return NULL;
+    }
+
+    viewer->header = (PublishHeader *)viewer->shared;
+    if (viewer->header->magic != PUBLISH_MAGIC)
+    {
+        viewerClose(viewer);
+        return NULL;
+    }
+    atomic_thread_fence(memory_order_acquire);
+
+    // A stale or foreign object may hold any header: its frames must be those of its board and lie in the object
+    viewer->HEIGHT = viewer->header->HEIGHT;
+    viewer->WIDTH = viewer->header->WIDTH;
+    viewer->slots = viewer->header->slots;
+    viewer->frameSize = viewer->header->frameSize;
+    viewer->words = viewer->HEIGHT > 0 && viewer->WIDTH > 0 ? ((size_t)viewer->HEIGHT * viewer->WIDTH + 63) / 64 : 0;
+    if (viewer->words == 0 || viewer->slots <= 0 || viewer->frameSize != publishFrameSize(viewer->words) ||
+        viewer->sharedSize < publishHeaderSize() || (size_t)viewer->slots > (viewer->sharedSize - publishHeaderSize()) / viewer->frameSize)
+    {
+        viewerClose(viewer);
+        return NULL;
+    }
+
+    viewer->copy = (uint64_t *)malloc(viewer->words * sizeof(uint64_t));
+    if (viewer->copy == NULL)
+    {
+        viewerClose(viewer);
+        return NULL;
+    }
+
+    return viewer;
+}
+
+int viewerHeight(Viewer *viewer)
+{
+    return viewer->HEIGHT;
+}
+
+int viewerWidth(Viewer *viewer)
+{
+    return viewer->WIDTH;
+}
+
+int viewerRead(Viewer *viewer, int **currentBoard, GenerationStats *stats)
+{
+    PublishHeader *header = viewer->header;
+
+    for (int attempt = 0; attempt < PUBLISH_RETRIES; attempt++)
+    {
+        unsigned long published = atomic_load_explicit(&header->published, memory_order_acquire);
+        if (published == viewer->seen)
+        {
+            return 0;
+        }
+
+        PublishFrame *frame = publishFrame(header, viewer->frameSize, (published - 1) % viewer->slots);
+        unsigned long before = atomic_load_explicit(&frame->sequence, memory_order_acquire);
+        if (before & 1)
+        {
+            continue;
+        }
+
+        GenerationStats copy = frame->stats;
+        memcpy(viewer->copy, frame->cells, viewer->words * sizeof(uint64_t));
+
+        // The copy only counts if the writer did not touch the frame in the meantime
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&frame->sequence, memory_order_relaxed) != before)
+        {
+            continue;
+        }
+
+        size_t bit = 0;
+        for (int i = 0; i < viewer->HEIGHT; i++)
+        {
+            for (int j = 0; j < viewer->WIDTH; j++, bit++)
+            {
+                currentBoard[i][j] = (viewer->copy[bit / 64] >> (bit % 64)) & 1;
+            }
+        }
+        *stats = copy;
+        viewer->seen = published;
+        return 1;
+    }
+
+    return 0;
+}
+
+void viewerClose(Viewer *viewer)
+{
+    if (viewer == NULL)
+    {
+        return;
+    }
+
+    munmap(viewer->shared, viewer->sharedSize);
+    free(viewer->copy);
+    free(viewer);
+}
@@ -0,0 +1,77 @@
+#include <stdio.h>
+#include <econio.h>
+#include <render.h>
+
+/* -------------------------------------------------------------------------- */
+/*      Rendering of Life's board, shared by the game and the viewer          */
+/* -------------------------------------------------------------------------- */
+
+int cellColor(int color)
+{
+    switch (color)
+    {
+    case 1:
+        return COL_GREEN;
+    case 0:
+        return COL_BLACK;
+    case 3:
+        return COL_YELLOW;
+    case 5:
+        return COL_CYAN;
+    default:
+        return COL_WHITE;
+    }
+}
+
+void printCell(int color)
+{
+    econio_textcolor(cellColor(color));
+    printf("██");
+    econio_textcolor(COL_RESET);
+}
+
+void frameCell(int x, int y, int color)
+{
+    // Every cell is 2 characters wide
+    econio_frame_put(x * 2, y, "██", cellColor(color), COL_RESET);
+}
+
+void frameRowLine(int y, int WIDTH)
+{
+    for (int i = 0; i < WIDTH + 2; i++)
+    {
+        frameCell(i, y, 4);
+    }
+}
+
+void printStats(GenerationStats *stats)
+{
+    econio_frame_printf("Generation: %ld | Population: %ld | Births: %ld | Deaths: %ld", stats->generation, stats->population, stats->births, stats->deaths);
+    if (stats->top >= 0)
+    {
+        econio_frame_printf(" | Bounding box: (%d, %d) to (%d, %d)", stats->left, stats->top, stats->right, stats->bottom);
+    }
+    econio_frame_printf("\n");
+}
+
+void frameBoard(int HEIGHT, int WIDTH, int **board, GenerationStats *stats)
+{
+    econio_frame_begin(true);
+    frameRowLine(0, WIDTH);
+    for (int i = 0; i < HEIGHT; i++)
+    {
+        frameCell(0, i + 1, 4);
+        for (int j = 0; j < WIDTH; j++)
+        {
+            frameCell(j + 1, i + 1, board[i][j] == 1 ? 1 : 0);
+        }
+        frameCell(WIDTH + 1, i + 1, 4);
+    }
+    frameRowLine(HEIGHT + 1, WIDTH);
+
+    econio_frame_gotoxy(0, HEIGHT + 2);
+    if (stats != NULL)
+    {
+        printStats(stats);
+    }
+}
@@ -0,0 +1,809 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+/* -------------------------------------------------------------------------- */
+/*   Renderer benchmark: replays recorded keys into the game on a terminal    */
+/* -------------------------------------------------------------------------- */
+
+// The game runs on a pseudo-terminal, its keys come from a session file and its
+// output goes back to the pseudo-terminal or to /dev/null. econio keeps a record
+// of every frame when ECONIO_FRAME_LOG is set (see econio.c), which is read back
+// once the game exits and summed up per kind of frame.
+//
+// A session file holds one key per line, after the milliseconds to wait before it
+// and optionally followed by how many times to press it (waiting before each):
+//
+//    # Comment
+//    500 ENTER
+//    1500 "40\n"
+//    20 RIGHT 50
+//
+// Keys are named (ENTER, ESC, UP, DOWN, LEFT, RIGHT, PAGEUP, PAGEDOWN, SPACE,
+// TAB, BACKSPACE) or given as text between quotes, with \n, \r, \t, \e, \\, \"
+// and \xNN escapes. ./renderbench -r records such a file from a real game.
+
+// Longest key, in bytes
+#define SESSION_KEY_SIZE 64
+
+// Seconds the game has to exit after the last key, before it is killed
+#define RENDERBENCH_DEFAULT_TIMEOUT 10
+
+// Struct for a key of a session: the bytes sent, the wait before them and how many times
+struct SessionKey
+{
+    int delay;
+    int repeat;
+    int length;
+    char bytes[SESSION_KEY_SIZE];
+};
+typedef struct SessionKey SessionKey;
+
+// Struct for a named key and the bytes a terminal sends for it
+struct KeyName
+{
+    char *name;
+    char *bytes;
+};
+typedef struct KeyName KeyName;
+
+static KeyName keyNames[] = {
+    {"ENTER", "\n"},
+    {"ESC", "\033"},
+    {"UP", "\033[A"},
+    {"DOWN", "\033[B"},
+    {"RIGHT", "\033[C"},
+    {"LEFT", "\033[D"},
+    {"PAGEUP", "\033[5~"},
+    {"PAGEDOWN", "\033[6~"},
+    {"SPACE", " "},
+    {"TAB", "\t"},
+    {"BACKSPACE", "\177"},
+    {NULL, NULL}};
+
+// Struct for the figures of one kind of frame
+struct FrameSummary
+{
+    char kind;
+    char *description;
+    int count;
+    double bytes;
+    double writes;
+    double writeSeconds;
+    size_t maxBytes;
+    size_t maxWrites;
+    double maxWriteSeconds;
+    double *composeSeconds;
+};
+typedef struct FrameSummary FrameSummary;
+
+// Set once SIGINT or SIGTERM arrive, the game is then stopped
+static volatile sig_atomic_t interrupted = 0;
+
+static void onSignal(int signal)
+{
+    (void)signal;
+    interrupted = 1;
+}
+
+// Milliseconds on a monotonic clock
+static long long millisecondsNow()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000LL + now.tv_nsec / 1000000;
+}
+
+// Parse a key written between quotes, with its escapes
+//    Param: (string) text (The text after the opening quote)
+//           (SessionKey*) key (Receives the bytes)
+//    Return: (int) 0 on success, -1 if the text is not closed or too long
+static int parseLiteral(char *text, SessionKey *key)
+{
+    key->length = 0;
+    while (*text != '"')
+    {
+        if (*text == '\0' || key->length == SESSION_KEY_SIZE)
+        {
+            return -1;
+        }
+
+        char c = *text++;
+        if (c == '\\')
+        {
+            c = *text++;
+            switch (c)
+            {
+            case 'n':
+                c = '\n';
+                break;
+            case 'r':
+                c = '\r';
+                break;
+            case 't':
+                c = '\t';
+                break;
+            case 'e':
+                c = '\033';
+                break;
+            case 'x':
+            {
+                unsigned int value;
+                int used;
+                if (sscanf(text, "%2x%n", &value, &used) != 1)
+                {
+                    return -1;
+                }
+                c = (char)value;
+                text += used;
+                break;
+            }
+            case '\0':
+                return -1;
+            default:
+                break;
+            }
+        }
+        key->bytes[key->length++] = c;
+    }
+    return 0;
+}
+
+// Read a session file
+//    Param: (string) fileName (Name of the session file)
+//           (int*) count (Receives the number of keys)
+//    Return: (SessionKey*) The keys, to be freed by the caller, NULL if the file could not be read
+static SessionKey *sessionRead(char *fileName, int *count)
+{
+    FILE *file = fopen(fileName, "r");
+    if (file == NULL)
+    {
+        perror(fileName);
+        return NULL;
+    }
+
+    SessionKey *keys = NULL;
+    int capacity = 0;
+    char line[256];
+    int number = 0;
+
+    *count = 0;
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        number++;
+
+        char *text = line + strspn(line, " \t");
+        if (*text == '#' || *text == '\n' || *text == '\0')
+        {
+            continue;
+        }
+
+        SessionKey key = {0, 1, 0, {0}};
+        int used = 0;
+        if (sscanf(text, "%d %n", &key.delay, &used) != 1 || key.delay < 0)
+        {
+            fprintf(stderr, "%s:%d: expected the milliseconds to wait\n", fileName, number);
+            break;
+        }
+        text += used;
+
+        char *rest;
+        if (*text == '"')
+        {
+            if (parseLiteral(text + 1, &key) != 0)
+            {
+                fprintf(stderr, "%s:%d: unterminated or too long text\n", fileName, number);
+                break;
+            }
+            // Skip to the closing quote, escaped quotes included
+            for (rest = text + 1; *rest != '"'; rest++)
+            {
+                if (*rest == '\\')
+                {
+                    rest++;
+                }
+            }
+            rest++;
+        }
+        else
+        {
+            size_t length = strcspn(text, " \t\n");
+            int i;
+            for (i = 0; keyNames[i].name != NULL; i++)
+            {
+                if (strlen(keyNames[i].name) == length && strncmp(keyNames[i].name, text, length) == 0)
+                {
+                    break;
+                }
+            }
+            if (keyNames[i].name == NULL)
+            {
+                fprintf(stderr, "%s:%d: unknown key %.*s\n", fileName, number, (int)length, text);
+                break;
+            }
+            key.length = strlen(keyNames[i].bytes);
+            memcpy(key.bytes, keyNames[i].bytes, key.length);
+            rest = text + length;
+        }
+
+        if (sscanf(rest, "%d", &key.repeat) == 1 && key.repeat < 1)
+        {
+            fprintf(stderr, "%s:%d: a key is pressed at least once\n", fileName, number);
+            break;
+        }
+
+        if (*count == capacity)
+        {
+            capacity = capacity != 0 ? capacity * 2 : 64;
+            SessionKey *grown = realloc(keys, capacity * sizeof(SessionKey));
+            if (grown == NULL)
+            {
+                break;
+            }
+            keys = grown;
+        }
+        keys[(*count)++] = key;
+    }
+
+    // Stopped before the end of the file: a line was wrong
+    int complete = feof(file);
+    fclose(file);
+    if (!complete)
+    {
+        free(keys);
+        return NULL;
+    }
+    return keys;
+}
+
+// Start a command on a new pseudo-terminal
+//    Param: (char**) command (The command and its arguments)
+//           (int) nullSink (1 sends the output of the command to /dev/null, 0 to the pseudo-terminal)
+//           (string) logName (File econio records the frames to, or NULL)
+//           (pid_t*) pid (Receives the process of the command)
+//    Return: (int) Master side of the pseudo-terminal, -1 on failure
+static int spawnOnTerminal(char **command, int nullSink, char *logName, pid_t *pid)
+{
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0)
+    {
+        perror("posix_openpt");
+        if (master >= 0)
+        {
+            close(master);
+        }
+        return -1;
+    }
+    char *slaveName = ptsname(master);
+
+    *pid = fork();
+    if (*pid < 0)
+    {
+        perror("fork");
+        close(master);
+        return -1;
+    }
+
+    if (*pid == 0)
+    {
+        // The pseudo-terminal becomes the controlling terminal of a new session
+        setsid();
+        int slave = open(slaveName, O_RDWR);
+        if (slave < 0)
+        {
+            _exit(127);
+        }
+        int sink = nullSink ? open("/dev/null", O_WRONLY) : slave;
+        dup2(slave, STDIN_FILENO);
+        dup2(sink, STDOUT_FILENO);
+        dup2(sink, STDERR_FILENO);
+        close(master);
+
+        if (logName != NULL)
+        {
+            setenv("ECONIO_FRAME_LOG", logName, 1);
+        }
+        execvp(command[0], command);
+        _exit(127);
+    }
+
+    return master;
+}
+
+// Read what the command printed on the pseudo-terminal, for some time or until there is nothing more
+//    Param: (int) master (Master side of the pseudo-terminal)
+//           (int) milliseconds (Time to keep reading)
+//           (int) echo (1 copies what was read to our stdout)
+//           (long long*) received (Incremented by the bytes read)
+//    Return: (int) 0, or -1 once the command closed the terminal
+static int drainTerminal(int master, int milliseconds, int echo, long long *received)
+{
+    char buffer[65536];
+    long long end = millisecondsNow() + milliseconds;
+
+    while (!interrupted)
+    {
+        long long left = end - millisecondsNow();
+        struct pollfd fd = {master, POLLIN, 0};
+        int ready = poll(&fd, 1, left > 0 ? (int)left : 0);
+        if (ready < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (ready <= 0)
+        {
+            return 0;
+        }
+
+        ssize_t count = read(master, buffer, sizeof(buffer));
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count <= 0)
+        {
+            // EIO: the last process holding the terminal is gone
+            return -1;
+        }
+        *received += count;
+        if (echo && write(STDOUT_FILENO, buffer, count) < 0)
+        {
+            echo = 0;
+        }
+    }
+    return 0;
+}
+
+// Write bytes to the terminal of the command, all of them
+//    Param: (int) master (Master side of the pseudo-terminal)
+//           (string) bytes (The bytes)
+//           (int) length (How many)
+//    Return: (int) 0 on success, -1 if the terminal is gone
+static int sendKey(int master, char *bytes, int length)
+{
+    while (length > 0)
+    {
+        ssize_t count = write(master, bytes, length);
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count <= 0)
+        {
+            return -1;
+        }
+        bytes += count;
+        length -= count;
+    }
+    return 0;
+}
+
+// Wait for the command to exit, reading its output meanwhile, and kill it after a timeout
+//    Param: (pid_t) pid (Process of the command)
+//           (int) master (Master side of the pseudo-terminal)
+//           (int) seconds (Time it has to exit)
+//           (long long*) received (Incremented by the bytes read)
+//    Return: (int) 0 if it exited by itself, -1 if it was killed
+static int awaitExit(pid_t pid, int master, int seconds, long long *received)
+{
+    long long end = millisecondsNow() + seconds * 1000LL;
+    int status;
+    int open = 1;
+
+    while (waitpid(pid, &status, WNOHANG) == 0)
+    {
+        if (interrupted || millisecondsNow() > end)
+        {
+            kill(pid, SIGKILL);
+            waitpid(pid, &status, 0);
+            return -1;
+        }
+        if (!open || drainTerminal(master, 50, 0, received) != 0)
+        {
+            open = 0;
+            usleep(10000);
+        }
+    }
+    return 0;
+}
+
+static int compareSeconds(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Read the frames econio recorded and sum them up per kind
+//    Param: (string) logName (The CSV written by econio)
+//           (FrameSummary*) summaries (The kinds, their figures are filled in)
+//           (int) kinds (Number of kinds)
+//    Return: (int) Frames read, -1 if the file could not be read
+static int summarizeFrames(char *logName, FrameSummary *summaries, int kinds)
+{
+    FILE *log = fopen(logName, "r");
+    if (log == NULL)
+    {
+        return -1;
+    }
+
+    char line[256];
+    int frames = 0;
+    int capacity[8] = {0};
+
+    // Header
+    if (fgets(line, sizeof(line), log) == NULL)
+    {
+        fclose(log);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), log) != NULL)
+    {
+        char kind;
+        long long composeNs, writeNs;
+        size_t bytes, writes;
+        if (sscanf(line, "%c,%lld,%lld,%zu,%zu", &kind, &composeNs, &writeNs, &bytes, &writes) != 5)
+        {
+            continue;
+        }
+
+        for (int i = 0; i < kinds; i++)
+        {
+            FrameSummary *summary = &summaries[i];
+            if (summary->kind != kind)
+            {
+                continue;
+            }
+
+            if (summary->count == capacity[i])
+            {
+                capacity[i] = capacity[i] != 0 ? capacity[i] * 2 : 256;
+                double *grown = realloc(summary->composeSeconds, capacity[i] * sizeof(double));
+                if (grown == NULL)
+                {
+                    break;
+                }
+                summary->composeSeconds = grown;
+            }
+            summary->composeSeconds[summary->count++] = composeNs / 1e9;
+            summary->bytes += bytes;
+            summary->writes += writes;
+            summary->writeSeconds += writeNs / 1e9;
+            if (bytes > summary->maxBytes)
+            {
+                summary->maxBytes = bytes;
+            }
+            if (writes > summary->maxWrites)
+            {
+                summary->maxWrites = writes;
+            }
+            if (writeNs / 1e9 > summary->maxWriteSeconds)
+            {
+                summary->maxWriteSeconds = writeNs / 1e9;
+            }
+            frames++;
+        }
+    }
+    fclose(log);
+    return frames;
+}
+
+// Print the figures of one kind of frame
+//    Param: (FrameSummary*) summary (The figures)
+static void printSummary(FrameSummary *summary)
+{
+    int count = summary->count;
+
+    printf("%s: %d\n", summary->description, count);
+    if (count == 0)
+    {
+        return;
+    }
+
+    double *compose = summary->composeSeconds;
+    qsort(compose, count, sizeof(double), compareSeconds);
+    double composeSum = 0;
+    for (int i = 0; i < count; i++)
+    {
+        composeSum += compose[i];
+    }
+
+    printf("    bytes per frame      mean %10.0f    max %10zu\n", summary->bytes / count, summary->maxBytes);
+    printf("    write() per frame    mean %10.2f    max %10zu\n", summary->writes / count, summary->maxWrites);
+    printf("    compose (ms)         mean %10.3f    p50 %10.3f    p95 %10.3f    max %10.3f\n",
+           composeSum / count * 1e3, compose[count / 2] * 1e3, compose[(int)(count * 0.95)] * 1e3, compose[count - 1] * 1e3);
+    printf("    write (ms)           mean %10.3f    max %10.3f\n", summary->writeSeconds / count * 1e3, summary->maxWriteSeconds * 1e3);
+}
+
+// Replay a session into a command and report its frames
+//    Param: (string) sessionName (Name of the session file)
+//           (char**) command (The command and its arguments)
+//           (int) nullSink (1 sends the output of the command to /dev/null, 0 to the pseudo-terminal)
+//           (string) csvName (File keeping the record of every frame, or NULL)
+//           (int) timeout (Seconds the command has to exit after the last key)
+//    Return: (int) Exit status of the program
+static int replaySession(char *sessionName, char **command, int nullSink, char *csvName, int timeout)
+{
+    int count;
+    SessionKey *keys = sessionRead(sessionName, &count);
+    if (keys == NULL)
+    {
+        return 1;
+    }
+
+    // Without a file asked for, the records go to a temporary one
+    char temporary[] = "/tmp/renderbench-XXXXXX";
+    char *logName = csvName;
+    if (logName == NULL)
+    {
+        int fd = mkstemp(temporary);
+        if (fd < 0)
+        {
+            perror("mkstemp");
+            free(keys);
+            return 1;
+        }
+        close(fd);
+        logName = temporary;
+    }
+
+    pid_t pid;
+    int master = spawnOnTerminal(command, nullSink, logName, &pid);
+    if (master < 0)
+    {
+        free(keys);
+        return 1;
+    }
+
+    long long received = 0;
+    long long begin = millisecondsNow();
+    int pressed = 0;
+    for (int i = 0; i < count && !interrupted; i++)
+    {
+        for (int j = 0; j < keys[i].repeat && !interrupted; j++)
+        {
+            drainTerminal(master, keys[i].delay, 0, &received);
+            if (sendKey(master, keys[i].bytes, keys[i].length) != 0)
+            {
+                break;
+            }
+            pressed++;
+        }
+    }
+    free(keys);
+
+    int killed = awaitExit(pid, master, timeout, &received);
+    double seconds = (millisecondsNow() - begin) / 1e3;
+    close(master);
+
+    FrameSummary summaries[] = {
+        {'F', "Frames composed (printBoard, printBoardWithCursor)", 0, 0, 0, 0, 0, 0, 0, NULL},
+        {'K', "Output answering a key (printCell, editor redraws)", 0, 0, 0, 0, 0, 0, 0, NULL}};
+    int kinds = sizeof(summaries) / sizeof(summaries[0]);
+    int frames = summarizeFrames(logName, summaries, kinds);
+    if (csvName == NULL)
+    {
+        unlink(logName);
+    }
+
+    printf("Session %s: %d keys in %.1f s, output to %s\n", sessionName, pressed, seconds, nullSink ? "/dev/null" : "the pseudo-terminal");
+    if (killed)
+    {
+        printf("%s did not exit within %d s after the last key and was killed.\n", command[0], timeout);
+    }
+    if (frames < 0)
+    {
+        printf("No frames were recorded: %s has to be built with econio.\n", command[0]);
+        return 1;
+    }
+    for (int i = 0; i < kinds; i++)
+    {
+        printSummary(&summaries[i]);
+        free(summaries[i].composeSeconds);
+    }
+    if (!nullSink)
+    {
+        printf("Bytes read from the pseudo-terminal: %lld (the output above, other text and the echo of the keys)\n", received);
+    }
+    return killed ? 1 : 0;
+}
+
+// Write a key as read from the terminal to a session, by name or as text
+//    Param: (FILE*) session (The session file)
+//           (int) delay (Milliseconds since the key before)
+//           (string) bytes (The bytes of the key)
+//           (int) length (How many)
+static void sessionWrite(FILE *session, int delay, char *bytes, int length)
+{
+    fprintf(session, "%d ", delay);
+
+    for (int i = 0; keyNames[i].name != NULL; i++)
+    {
+        if ((int)strlen(keyNames[i].bytes) == length && memcmp(keyNames[i].bytes, bytes, length) == 0)
+        {
+            fprintf(session, "%s\n", keyNames[i].name);
+            return;
+        }
+    }
+
+    fputc('"', session);
+    for (int i = 0; i < length; i++)
+    {
+        unsigned char c = bytes[i];
+        if (c == '\n' || c == '\r')
+        {
+            // The terminal of the game turns carriage returns into newlines, as it would have
+            fputs("\\n", session);
+        }
+        else if (c == '"' || c == '\\')
+        {
+            fprintf(session, "\\%c", c);
+        }
+        else if (c == '\033')
+        {
+            fputs("\\e", session);
+        }
+        else if (c < 0x20 || c == 0x7F)
+        {
+            fprintf(session, "\\x%02x", c);
+        }
+        else
+        {
+            fputc(c, session);
+        }
+    }
+    fputs("\"\n", session);
+}
+
+// Run a command on a pseudo-terminal between it and our terminal, recording the keys typed
+//    Param: (string) sessionName (Name of the session file written)
+//           (char**) command (The command and its arguments)
+//    Return: (int) Exit status of the program
+static int recordSession(char *sessionName, char **command)
+{
+    FILE *session = fopen(sessionName, "w");
+    if (session == NULL)
+    {
+        perror(sessionName);
+        return 1;
+    }
+    fprintf(session, "# Recorded from %s\n", command[0]);
+
+    pid_t pid;
+    int master = spawnOnTerminal(command, 0, NULL, &pid);
+    if (master < 0)
+    {
+        fclose(session);
+        return 1;
+    }
+
+    // Our terminal passes every key through as it is typed, the game's terminal does the rest
+    struct termios saved, raw;
+    int terminal = tcgetattr(STDIN_FILENO, &saved) == 0;
+    if (terminal)
+    {
+        raw = saved;
+        cfmakeraw(&raw);
+        tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+    }
+
+    long long received = 0;
+    long long last = millisecondsNow();
+    char buffer[SESSION_KEY_SIZE];
+    while (!interrupted)
+    {
+        struct pollfd fds[2] = {{STDIN_FILENO, POLLIN, 0}, {master, POLLIN, 0}};
+        if (poll(fds, 2, -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+        if (fds[1].revents != 0 && drainTerminal(master, 0, 1, &received) != 0)
+        {
+            break;
+        }
+        if (fds[0].revents != 0)
+        {
+            ssize_t count = read(STDIN_FILENO, buffer, sizeof(buffer));
+            if (count <= 0)
+            {
+                break;
+            }
+            long long now = millisecondsNow();
+            sessionWrite(session, (int)(now - last), buffer, count);
+            last = now;
+            if (sendKey(master, buffer, count) != 0)
+            {
+                break;
+            }
+        }
+    }
+
+    if (terminal)
+    {
+        tcsetattr(STDIN_FILENO, TCSANOW, &saved);
+    }
+    awaitExit(pid, master, RENDERBENCH_DEFAULT_TIMEOUT, &received);
+    close(master);
+    fclose(session);
+    printf("\nSession recorded to %s\n", sessionName);
+    return 0;
+}
+
+static void printUsage(char *program)
+{
+    printf("Usage: %s [-n] [-c csvfile] [-w seconds] session [command [arguments]]\n", program);
+    printf("       %s -r session [command [arguments]]\n", program);
+    printf("    Replay the keys of a session into the game (./main by default) on a pseudo-terminal,\n");
+    printf("    and report the bytes, write() calls and composition time of its frames.\n");
+    printf("    -n             Send the output of the game to /dev/null instead of the pseudo-terminal.\n");
+    printf("    -c csvfile     Keep the record of every frame in a CSV file.\n");
+    printf("    -w seconds     Time the game has to exit after the last key (default %d).\n", RENDERBENCH_DEFAULT_TIMEOUT);
+    printf("    -r             Play the game and record the keys typed to the session file instead.\n");
+}
+
+int main(int argc, char **argv)
+{
+    int nullSink = 0;
+    int record = 0;
+    int timeout = RENDERBENCH_DEFAULT_TIMEOUT;
+    char *csvName = NULL;
+    int option;
+
+    // Options stop at the session, those after it belong to the command
+    while ((option = getopt(argc, argv, "+nc:w:r")) != -1)
+    {
+        switch (option)
+        {
+        case 'n':
+            nullSink = 1;
+            break;
+        case 'c':
+            csvName = optarg;
+            break;
+        case 'w':
+            timeout = atoi(optarg);
+            if (timeout < 1)
+            {
+                printUsage(argv[0]);
+                return 1;
+            }
+            break;
+        case 'r':
+            record = 1;
+            break;
+        default:
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (optind >= argc)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    char *sessionName = argv[optind];
+    char *defaultCommand[] = {"./main", NULL};
+    char **command = optind + 1 < argc ? &argv[optind + 1] : defaultCommand;
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = onSignal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    return record ? recordSession(sessionName, command) : replaySession(sessionName, command, nullSink, csvName, timeout);
+}
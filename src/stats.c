@@ -0,0 +1,185 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stats.h>
+
+/* -------------------------------------------------------------------------- */
+/*     Statistics of a generation, gathered by the kernels while stepping     */
+/* -------------------------------------------------------------------------- */
+
+// Bit 0 of every byte of a 64-bit word
+#define STATS_LOW_BITS 0x0101010101010101ULL
+
+/* ----------------------------- Generation Stats ---------------------------- */
+void statsReset(GenerationStats *stats, long generation)
+{
+    stats->generation = generation;
+    stats->population = 0;
+    stats->births = 0;
+    stats->deaths = 0;
+    stats->top = -1;
+    stats->left = -1;
+    stats->bottom = -1;
+    stats->right = -1;
+}
+
+void statsIncludeRun(GenerationStats *stats, int row, int first, int last)
+{
+    if (stats->top < 0)
+    {
+        stats->top = stats->bottom = row;
+        stats->left = first;
+        stats->right = last;
+        return;
+    }
+
+    stats->top = row < stats->top ? row : stats->top;
+    stats->bottom = row > stats->bottom ? row : stats->bottom;
+    stats->left = first < stats->left ? first : stats->left;
+    stats->right = last > stats->right ? last : stats->right;
+}
+
+void statsMerge(GenerationStats *stats, GenerationStats *part)
+{
+    stats->population += part->population;
+    stats->births += part->births;
+    stats->deaths += part->deaths;
+
+    if (part->top >= 0)
+    {
+        statsIncludeRun(stats, part->top, part->left, part->right);
+        statsIncludeRun(stats, part->bottom, part->left, part->right);
+    }
+}
+
+void statsAccountBytes(GenerationStats *stats, unsigned char *before, unsigned char *after, int count, int row, int column)
+{
+    int first = -1;
+    int last = -1;
+    int j = 0;
+
+    // Cells are 0 or 1, so a popcount of eight packed Cells counts the live ones
+    for (; j + 8 <= count; j += 8)
+    {
+        uint64_t old, new;
+        memcpy(&old, before + j, 8);
+        memcpy(&new, after + j, 8);
+
+        stats->population += __builtin_popcountll(new);
+        stats->births += __builtin_popcountll(new & ~old & STATS_LOW_BITS);
+        stats->deaths += __builtin_popcountll(old & ~new & STATS_LOW_BITS);
+
+        if (new != 0)
+        {
+            // Bytes are loaded little-endian: the lowest set bit is the leftmost live Cell
+            if (first < 0)
+            {
+                first = j + __builtin_ctzll(new) / 8;
+            }
+            last = j + (63 - __builtin_clzll(new)) / 8;
+        }
+    }
+
+    for (; j < count; j++)
+    {
+        stats->population += after[j];
+        stats->births += after[j] & !before[j];
+        stats->deaths += before[j] & !after[j];
+        if (after[j])
+        {
+            first = first < 0 ? j : first;
+            last = j;
+        }
+    }
+
+    if (first >= 0)
+    {
+        statsIncludeRun(stats, row, column + first, column + last);
+    }
+}
+
+void statsRecord(StatsRecorder *recorder, GenerationStats *stats)
+{
+    stats->generation = ++recorder->generation;
+    recorder->last = *stats;
+
+    if (recorder->series != NULL)
+    {
+        statsSeriesAppend(recorder->series, stats);
+    }
+}
+
+/* ---------------------------------- Series --------------------------------- */
+StatsSeries *statsSeriesCreate()
+{
+    StatsSeries *series = (StatsSeries *)calloc(1, sizeof(StatsSeries));
+    if (series == NULL)
+    {
+        return NULL;
+    }
+
+    series->capacity = 1024;
+    series->entries = (GenerationStats *)malloc(series->capacity * sizeof(GenerationStats));
+    if (series->entries == NULL)
+    {
+        free(series);
+        return NULL;
+    }
+    return series;
+}
+
+void statsSeriesAppend(StatsSeries *series, GenerationStats *stats)
+{
+    if (series->count == series->capacity)
+    {
+        // Doubling keeps appending amortised constant time
+        GenerationStats *entries = (GenerationStats *)realloc(series->entries, 2 * series->capacity * sizeof(GenerationStats));
+        if (entries == NULL)
+        {
+            return;
+        }
+        series->entries = entries;
+        series->capacity *= 2;
+    }
+
+    series->entries[series->count++] = *stats;
+}
+
+void statsSeriesTruncate(StatsSeries *series, long generation)
+{
+    while (series->count > 0 && series->entries[series->count - 1].generation > generation)
+    {
+        series->count--;
+    }
+}
+
+int statsSeriesWrite(StatsSeries *series, char *fileName)
+{
+    FILE *file = fopen(fileName, "w");
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    fprintf(file, "generation,population,births,deaths,top,left,bottom,right\n");
+    for (int i = 0; i < series->count; i++)
+    {
+        GenerationStats *stats = &series->entries[i];
+        fprintf(file, "%ld,%ld,%ld,%ld,%d,%d,%d,%d\n", stats->generation, stats->population, stats->births, stats->deaths, stats->top, stats->left, stats->bottom, stats->right);
+    }
+
+    fclose(file);
+    return 0;
+}
+
+void statsSeriesFree(StatsSeries *series)
+{
+    if (series == NULL)
+    {
+        return;
+    }
+
+    free(series->entries);
+    free(series);
+}
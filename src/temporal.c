@@ -0,0 +1,300 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <temporal.h>
+
+/* -------------------------------------------------------------------------- */
+/*       Temporal blocking: several generations per cache-resident tile       */
+/* -------------------------------------------------------------------------- */
+
+// Deepest halo ever used, deeper halos waste more work on redundant Cells than they save
+#define TEMPORAL_MAX_DEPTH 16
+
+// Cache size assumed when the system does not report one
+#define TEMPORAL_DEFAULT_CACHE (256 * 1024)
+
+struct TemporalStepper
+{
+    int HEIGHT;
+    int WIDTH;
+    int depth;
+    int tileSize;
+
+    // Two local buffers of (side + 2) x (side + 2) bytes, with an always dead frame around them
+    int side;
+    int stride;
+    unsigned char *cells;
+    unsigned char *next;
+    unsigned char *columns;
+};
+
+/* ----------------------- Utilities of the Temporal Stepper ----------------- */
+// Read a cache size like "1024K" from sysfs
+//    Param: (string) path (Path of the sysfs file)
+//    Return: (long) Size in bytes, 0 if unknown
+static long temporalReadCacheFile(char *path)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+    {
+        return 0;
+    }
+
+    long size = 0;
+    char unit = 0;
+    if (fscanf(file, "%ld%c", &size, &unit) < 1)
+    {
+        size = 0;
+    }
+    fclose(file);
+
+    if (unit == 'K')
+    {
+        size *= 1024;
+    }
+    else if (unit == 'M')
+    {
+        size *= 1024 * 1024;
+    }
+    return size;
+}
+
+long temporalCacheSize()
+{
+    long size = 0;
+
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+    if (size <= 0)
+    {
+        size = temporalReadCacheFile("/sys/devices/system/cpu/cpu0/cache/index2/size");
+    }
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+    if (size <= 0)
+    {
+        size = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+    }
+#endif
+    if (size <= 0)
+    {
+        size = TEMPORAL_DEFAULT_CACHE;
+    }
+    return size;
+}
+
+/* ------------------------------- Tile Kernel ------------------------------- */
+// Calculate one generation of the rows and columns [top, bottom) x [left, right) of the local buffer
+// Cells outside the buffer are dead, matching the edge of the board
+//    Param: (TemporalStepper*) stepper (The stepper)
+//           (int) top, bottom, left, right (Region to calculate, in buffer coordinates starting at 1)
+static void temporalStepRegion(TemporalStepper *stepper, int top, int bottom, int left, int right)
+{
+    int stride = stepper->stride;
+    unsigned char *columns = stepper->columns;
+
+    for (int i = top; i < bottom; i++)
+    {
+        unsigned char *up = stepper->cells + (size_t)(i - 1) * stride;
+        unsigned char *row = stepper->cells + (size_t)i * stride;
+        unsigned char *down = stepper->cells + (size_t)(i + 1) * stride;
+        unsigned char *out = stepper->next + (size_t)i * stride;
+
+        // Vertical sums first, then every count is three of them minus the Cell itself
+        for (int j = left - 1; j <= right; j++)
+        {
+            columns[j] = up[j] + row[j] + down[j];
+        }
+        for (int j = left; j < right; j++)
+        {
+            unsigned char count = columns[j - 1] + columns[j] + columns[j + 1] - row[j];
+            out[j] = (count == 3) | ((count == 2) & row[j]);
+        }
+    }
+}
+
+// Load a tile and its halo, advance it some generations and write its center to the next board
+//    Param: (TemporalStepper*) stepper (The stepper)
+//           (int) top, left (Upper left Cell of the tile on the board)
+//           (int) generations (Generations to advance, at most the depth)
+//           (int**) currentBoard (Board to read)
+//           (int**) nextBoard (Board to write)
+//           (GenerationStats*) passStats (Statistics of every generation of the pass, or NULL)
+static void temporalStepTile(TemporalStepper *stepper, int top, int left, int generations, int **currentBoard, int **nextBoard, GenerationStats *passStats)
+{
+    int HEIGHT = stepper->HEIGHT;
+    int WIDTH = stepper->WIDTH;
+    int stride = stepper->stride;
+    int bottom = top + stepper->tileSize < HEIGHT ? top + stepper->tileSize : HEIGHT;
+    int right = left + stepper->tileSize < WIDTH ? left + stepper->tileSize : WIDTH;
+
+    // Region loaded: the tile plus a halo, clipped to the board
+    int loadTop = top - generations > 0 ? top - generations : 0;
+    int loadLeft = left - generations > 0 ? left - generations : 0;
+    int loadBottom = bottom + generations < HEIGHT ? bottom + generations : HEIGHT;
+    int loadRight = right + generations < WIDTH ? right + generations : WIDTH;
+    int rows = loadBottom - loadTop;
+    int cols = loadRight - loadLeft;
+
+    // The frame of both buffers has to be dead
+    memset(stepper->cells, 0, (size_t)(rows + 2) * stride);
+    memset(stepper->next, 0, (size_t)(rows + 2) * stride);
+
+    for (int i = 0; i < rows; i++)
+    {
+        int *source = currentBoard[loadTop + i];
+        unsigned char *target = stepper->cells + (size_t)(i + 1) * stride + 1;
+        for (int j = 0; j < cols; j++)
+        {
+            target[j] = source[loadLeft + j] == 1;
+        }
+    }
+
+    // A side of the buffer that is not the edge of the board holds wrong Cells one step deeper every generation
+    int shrinkTop = loadTop > 0;
+    int shrinkLeft = loadLeft > 0;
+    int shrinkBottom = loadBottom < HEIGHT;
+    int shrinkRight = loadRight < WIDTH;
+
+    for (int s = 1; s <= generations; s++)
+    {
+        temporalStepRegion(stepper, 1 + s * shrinkTop, rows + 1 - s * shrinkBottom, 1 + s * shrinkLeft, cols + 1 - s * shrinkRight);
+
+        // The center of the tile is valid in every generation of the pass, count it while it is in the cache
+        if (passStats != NULL)
+        {
+            for (int i = top; i < bottom; i++)
+            {
+                size_t offset = (size_t)(i - loadTop + 1) * stride + 1 + left - loadLeft;
+                statsAccountBytes(&passStats[s - 1], stepper->cells + offset, stepper->next + offset, right - left, i, left);
+            }
+        }
+
+        unsigned char *swap = stepper->cells;
+        stepper->cells = stepper->next;
+        stepper->next = swap;
+    }
+
+    for (int i = top; i < bottom; i++)
+    {
+        unsigned char *source = stepper->cells + (size_t)(i - loadTop + 1) * stride + 1 - loadLeft;
+        int *target = nextBoard[i];
+        for (int j = left; j < right; j++)
+        {
+            target[j] = source[j];
+        }
+    }
+}
+
+/* ------------------------------- Stepper API ------------------------------- */
+TemporalStepper *temporalStepperCreate(int HEIGHT, int WIDTH, int depth)
+{
+    TemporalStepper *stepper = (TemporalStepper *)calloc(1, sizeof(TemporalStepper));
+    if (stepper == NULL)
+    {
+        return NULL;
+    }
+
+    // Both byte buffers together should take at most half of the cache
+    long cache = temporalCacheSize();
+    int side = 16;
+    while ((long)(2 * side + 2) * (2 * side + 2) * 2 <= cache / 2)
+    {
+        side *= 2;
+    }
+
+    // Automatic depth: a halo of 1/16 of the buffer on each side costs about 25% redundant work
+    if (depth <= 0)
+    {
+        depth = side / 16;
+    }
+    if (depth > TEMPORAL_MAX_DEPTH)
+    {
+        depth = TEMPORAL_MAX_DEPTH;
+    }
+    if (depth < 1)
+    {
+        depth = 1;
+    }
+    if (side < 4 * depth)
+    {
+        side = 4 * depth;
+    }
+
+    stepper->HEIGHT = HEIGHT;
+    stepper->WIDTH = WIDTH;
+    stepper->depth = depth;
+    stepper->side = side;
+    stepper->tileSize = side - 2 * depth;
+    stepper->stride = side + 2;
+    stepper->cells = (unsigned char *)malloc((size_t)stepper->stride * stepper->stride);
+    stepper->next = (unsigned char *)malloc((size_t)stepper->stride * stepper->stride);
+    stepper->columns = (unsigned char *)malloc(stepper->stride);
+
+    if (stepper->cells == NULL || stepper->next == NULL || stepper->columns == NULL)
+    {
+        temporalStepperFree(stepper);
+        return NULL;
+    }
+
+    return stepper;
+}
+
+void temporalStepperStep(TemporalStepper *stepper, int generations, int **currentBoard, int **nextBoard, StatsRecorder *recorder)
+{
+    GenerationStats passStats[TEMPORAL_MAX_DEPTH];
+
+    while (generations > 0)
+    {
+        int pass = generations < stepper->depth ? generations : stepper->depth;
+        for (int s = 0; s < pass; s++)
+        {
+            statsReset(&passStats[s], 0);
+        }
+
+        for (int top = 0; top < stepper->HEIGHT; top += stepper->tileSize)
+        {
+            for (int left = 0; left < stepper->WIDTH; left += stepper->tileSize)
+            {
+                temporalStepTile(stepper, top, left, pass, currentBoard, nextBoard, recorder != NULL ? passStats : NULL);
+            }
+        }
+
+        // Tiles read the old board for their halos, so it is only replaced once all of them are done
+        for (int i = 0; i < stepper->HEIGHT; i++)
+        {
+            memcpy(currentBoard[i], nextBoard[i], stepper->WIDTH * sizeof(int));
+        }
+
+        for (int s = 0; s < pass && recorder != NULL; s++)
+        {
+            statsRecord(recorder, &passStats[s]);
+        }
+
+        generations -= pass;
+    }
+}
+
+int temporalStepperDepth(TemporalStepper *stepper)
+{
+    return stepper->depth;
+}
+
+int temporalStepperTileSize(TemporalStepper *stepper)
+{
+    return stepper->tileSize;
+}
+
+void temporalStepperFree(TemporalStepper *stepper)
+{
+    if (stepper == NULL)
+    {
+        return;
+    }
+
+    free(stepper->cells);
+    free(stepper->next);
+    free(stepper->columns);
+    free(stepper);
+}
@@ -0,0 +1,671 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <tilesched.h>
+
+/* -------------------------------------------------------------------------- */
+/*        Tile based multi-threaded stepping with work-stealing deques        */
+/* -------------------------------------------------------------------------- */
+
+// Side of a tile when none is given, 64 x 64 ints fill 16 KB
+#define TILE_DEFAULT_SIZE 64
+
+// Size of a cache line, per-thread data is kept on its own lines
+#define TILE_CACHE_LINE 64
+
+/* ------------------- Data Structures of the Tile Scheduler ----------------- */
+// Enum for the phases of a generation: calculate the active tiles, then copy the changed ones back.
+// Before the first generation, every thread touches the tiles it will calculate (NUMA first touch).
+enum TilePhase
+{
+    TILE_CALCULATE = 1,
+    TILE_COMMIT = 2,
+    TILE_QUIT = 3,
+    TILE_TOUCH = 4
+};
+typedef enum TilePhase TilePhase;
+
+// Chase-Lev deque of tile indices: the owner pops at the bottom, thieves steal at the top.
+// All tasks are pushed before a phase starts, so the buffer never grows.
+struct TileDeque
+{
+    _Alignas(TILE_CACHE_LINE) atomic_long top;
+    _Alignas(TILE_CACHE_LINE) atomic_long bottom;
+    int *tasks;
+};
+typedef struct TileDeque TileDeque;
+
+struct TileWorker
+{
+    _Alignas(TILE_CACHE_LINE) TileScheduler *scheduler;
+    int index;
+    unsigned int seed;
+    pthread_t thread;
+    TileDeque deque;
+    TileThreadStats stats;
+
+    // Where the thread runs: the CPU or node it is pinned to (-1 if not pinned) and the node it last ran on
+    int pinned;
+    int node;
+};
+typedef struct TileWorker TileWorker;
+
+struct TileScheduler
+{
+    int HEIGHT;
+    int WIDTH;
+    int tileSize;
+    int tileRows;
+    int tileColumns;
+    int tiles;
+    int threads;
+
+    // changed[t]: tile t changed during the last generation, active[t]: tile t has to be calculated
+    unsigned char *changed;
+    unsigned char *active;
+    int *activeList;
+
+    // Statistics of every tile, population and bounding box stay valid while a tile is skipped
+    GenerationStats *tileStats;
+
+    int **currentBoard;
+    int **nextBoard;
+    TilePhase phase;
+    pthread_barrier_t start;
+    pthread_barrier_t finish;
+
+    // Held while the threads are created, so that none waits at start before all of them exist
+    pthread_mutex_t launch;
+    int launched;
+
+    double wallSeconds;
+    TileWorker *workers;
+
+    // Worker 0 is whichever thread steps the board, it is pinned when it first does
+    NumaPinning pinning;
+    pthread_t caller;
+    int callerPinned;
+};
+
+/* ------------------------ Utilities of the Tile Scheduler ------------------ */
+// Read a monotonic clock
+//    Return: (double) Time in seconds
+static double tileClock()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+// Take a task from the bottom of the own deque
+//    Param: (TileDeque*) deque (Deque of the calling thread)
+//    Return: (int) Tile index, -1 if the deque is empty
+static int tileDequePop(TileDeque *deque)
+{
+    long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    if (top > bottom)
+    {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return -1;
+    }
+
+    int task = deque->tasks[bottom];
+    if (top == bottom)
+    {
+        // Last task: race the thieves for it
+        if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed))
+        {
+            task = -1;
+        }
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    }
+    return task;
+}
+
+// Take a task from the top of another thread's deque
+//    Param: (TileDeque*) deque (Deque of the victim)
+//    Return: (int) Tile index, -1 if the deque is empty or another thief won
+static int tileDequeSteal(TileDeque *deque)
+{
+    long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+    if (top >= bottom)
+    {
+        return -1;
+    }
+
+    int task = deque->tasks[top];
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed))
+    {
+        return -1;
+    }
+    return task;
+}
+
+/* ------------------------------- Tile Kernels ------------------------------ */
+// Calculate the next generation of one tile and remember whether it changed
+//    Param: (TileScheduler*) scheduler (The scheduler)
+//           (int) tile (Index of the tile)
+static void tileCalculate(TileScheduler *scheduler, int tile)
+{
+    int HEIGHT = scheduler->HEIGHT;
+    int WIDTH = scheduler->WIDTH;
+    int **currentBoard = scheduler->currentBoard;
+    int **nextBoard = scheduler->nextBoard;
+
+    int top = tile / scheduler->tileColumns * scheduler->tileSize;
+    int left = tile % scheduler->tileColumns * scheduler->tileSize;
+    int bottom = top + scheduler->tileSize < HEIGHT ? top + scheduler->tileSize : HEIGHT;
+    int right = left + scheduler->tileSize < WIDTH ? left + scheduler->tileSize : WIDTH;
+    int changed = 0;
+    GenerationStats *stats = &scheduler->tileStats[tile];
+    statsReset(stats, 0);
+
+    for (int i = top; i < bottom; i++)
+    {
+        int first = -1;
+        int last = -1;
+
+        int *up = i > 0 ? currentBoard[i - 1] : NULL;
+        int *row = currentBoard[i];
+        int *down = i < HEIGHT - 1 ? currentBoard[i + 1] : NULL;
+        int *out = nextBoard[i];
+
+        for (int j = left; j < right; j++)
+        {
+            int count = 0;
+            for (int k = j - 1; k <= j + 1; k++)
+            {
+                if (k < 0 || k >= WIDTH)
+                {
+                    continue;
+                }
+                count += (up != NULL && up[k] == 1) + (down != NULL && down[k] == 1) + (k != j && row[k] == 1);
+            }
+
+            // Rules of the game
+            int alive = row[j] == 1;
+            int cell = (count == 3 || (alive && count == 2)) ? 1 : 0;
+            out[j] = cell;
+            changed |= cell != alive;
+
+            stats->population += cell;
+            stats->births += cell & !alive;
+            stats->deaths += alive & !cell;
+            if (cell)
+            {
+                first = first < 0 ? j : first;
+                last = j;
+            }
+        }
+
+        if (first >= 0)
+        {
+            statsIncludeRun(stats, i, first, last);
+        }
+    }
+
+    scheduler->changed[tile] = (unsigned char)changed;
+}
+
+// Copy a changed tile from the next board back to the current board
+//    Param: (TileScheduler*) scheduler (The scheduler)
+//           (int) tile (Index of the tile)
+static void tileCommit(TileScheduler *scheduler, int tile)
+{
+    if (!scheduler->changed[tile])
+    {
+        return;
+    }
+
+    int top = tile / scheduler->tileColumns * scheduler->tileSize;
+    int left = tile % scheduler->tileColumns * scheduler->tileSize;
+    int bottom = top + scheduler->tileSize < scheduler->HEIGHT ? top + scheduler->tileSize : scheduler->HEIGHT;
+    int right = left + scheduler->tileSize < scheduler->WIDTH ? left + scheduler->tileSize : scheduler->WIDTH;
+
+    for (int i = top; i < bottom; i++)
+    {
+        memcpy(scheduler->currentBoard[i] + left, scheduler->nextBoard[i] + left, (right - left) * sizeof(int));
+    }
+}
+
+// Touch the Cells of a tile on both boards, so their pages are placed on the node of the touching thread
+// The Cells are written back unchanged, a board that was already written keeps its Cells (and its pages)
+//    Param: (TileScheduler*) scheduler (The scheduler)
+//           (int) tile (Index of the tile)
+static void tileTouch(TileScheduler *scheduler, int tile)
+{
+    int top = tile / scheduler->tileColumns * scheduler->tileSize;
+    int left = tile % scheduler->tileColumns * scheduler->tileSize;
+    int bottom = top + scheduler->tileSize < scheduler->HEIGHT ? top + scheduler->tileSize : scheduler->HEIGHT;
+    int right = left + scheduler->tileSize < scheduler->WIDTH ? left + scheduler->tileSize : scheduler->WIDTH;
+
+    for (int i = top; i < bottom; i++)
+    {
+        volatile int *current = scheduler->currentBoard[i];
+        volatile int *next = scheduler->nextBoard[i];
+        for (int j = left; j < right; j++)
+        {
+            current[j] = current[j];
+            next[j] = next[j];
+        }
+    }
+}
+
+/* ------------------------------ Worker Threads ----------------------------- */
+// Run tasks until no deque has any left: own deque first, then steal from random victims
+//    Param: (TileWorker*) worker (The calling thread)
+static void tileRunPhase(TileWorker *worker)
+{
+    TileScheduler *scheduler = worker->scheduler;
+    double begin = tileClock();
+    worker->node = numaCurrentNode();
+
+    while (1)
+    {
+        int task = tileDequePop(&worker->deque);
+
+        // Touching must stay with the owner of the tiles, a thief would place them on its own node
+        if (task < 0 && scheduler->threads > 1 && scheduler->phase != TILE_TOUCH)
+        {
+            // Sweep the other deques once, starting from a random victim
+            int first = rand_r(&worker->seed) % scheduler->threads;
+            for (int v = 0; v < scheduler->threads && task < 0; v++)
+            {
+                int victim = (first + v) % scheduler->threads;
+                if (victim == worker->index)
+                {
+                    continue;
+                }
+
+                TileDeque *deque = &scheduler->workers[victim].deque;
+                while (task < 0 && atomic_load(&deque->top) < atomic_load(&deque->bottom))
+                {
+                    task = tileDequeSteal(deque);
+                }
+            }
+
+            if (task >= 0)
+            {
+                worker->stats.steals++;
+            }
+        }
+
+        // No new tasks appear during a phase, so empty deques everywhere means done
+        if (task < 0)
+        {
+            break;
+        }
+
+        if (scheduler->phase == TILE_CALCULATE)
+        {
+            tileCalculate(scheduler, task);
+            worker->stats.tiles++;
+        }
+        else if (scheduler->phase == TILE_TOUCH)
+        {
+            tileTouch(scheduler, task);
+        }
+        else
+        {
+            tileCommit(scheduler, task);
+        }
+    }
+
+    // Touching happens before the first generation, it is not part of the stepping being measured
+    if (scheduler->phase != TILE_TOUCH)
+    {
+        worker->stats.busySeconds += tileClock() - begin;
+    }
+}
+
+// Body of a helper thread: wait for a phase, run it, report back
+//    Param: (void*) argument (The TileWorker of the thread)
+static void *tileWorkerThread(void *argument)
+{
+    TileWorker *worker = (TileWorker *)argument;
+    TileScheduler *scheduler = worker->scheduler;
+
+    // A thread that could not be created leaves the others to quit before the first phase
+    pthread_mutex_lock(&scheduler->launch);
+    pthread_mutex_unlock(&scheduler->launch);
+    if (!scheduler->launched)
+    {
+        return NULL;
+    }
+
+    worker->pinned = numaPin(worker->index, scheduler->threads, scheduler->pinning);
+
+    while (1)
+    {
+        pthread_barrier_wait(&scheduler->start);
+        if (scheduler->phase == TILE_QUIT)
+        {
+            break;
+        }
+        tileRunPhase(worker);
+        pthread_barrier_wait(&scheduler->finish);
+    }
+
+    return NULL;
+}
+
+// Deal the active tiles to the deques in contiguous blocks and run one phase on every thread
+//    Param: (TileScheduler*) scheduler (The scheduler)
+//           (TilePhase) phase (The phase to run)
+//           (int) count (Number of active tiles)
+static void tileDispatch(TileScheduler *scheduler, TilePhase phase, int count)
+{
+    int threads = scheduler->threads;
+
+    for (int w = 0; w < threads; w++)
+    {
+        TileDeque *deque = &scheduler->workers[w].deque;
+        int from = (int)((long)count * w / threads);
+        int to = (int)((long)count * (w + 1) / threads);
+
+        // Pushed in reverse, so the owner pops its block in board order
+        for (int k = from; k < to; k++)
+        {
+            deque->tasks[to - 1 - k] = scheduler->activeList[k];
+        }
+        atomic_store(&deque->top, 0);
+        atomic_store(&deque->bottom, to - from);
+    }
+
+    scheduler->phase = phase;
+    pthread_barrier_wait(&scheduler->start);
+    tileRunPhase(&scheduler->workers[0]);
+    pthread_barrier_wait(&scheduler->finish);
+}
+
+/* ------------------------------ Scheduler API ------------------------------ */
+// Free the memory of a scheduler whose threads are not running
+//    Param: (TileScheduler*) scheduler (The scheduler)
+//           (int) workers (Number of workers whose deques were allocated)
+static void tileSchedulerRelease(TileScheduler *scheduler, int workers)
+{
+    for (int w = 0; w < workers; w++)
+    {
+        free(scheduler->workers[w].deque.tasks);
+    }
+    free(scheduler->workers);
+    free(scheduler->changed);
+    free(scheduler->active);
+    free(scheduler->activeList);
+    free(scheduler->tileStats);
+    free(scheduler);
+}
+
+TileScheduler *tileSchedulerCreate(int HEIGHT, int WIDTH, int threads, int tileSize, NumaPinning pinning)
+{
+    TileScheduler *scheduler = (TileScheduler *)calloc(1, sizeof(TileScheduler));
+    if (scheduler == NULL)
+    {
+        return NULL;
+    }
+
+    scheduler->HEIGHT = HEIGHT;
+    scheduler->WIDTH = WIDTH;
+    scheduler->tileSize = tileSize > 0 ? tileSize : TILE_DEFAULT_SIZE;
+    scheduler->tileRows = (HEIGHT + scheduler->tileSize - 1) / scheduler->tileSize;
+    scheduler->tileColumns = (WIDTH + scheduler->tileSize - 1) / scheduler->tileSize;
+    scheduler->tiles = scheduler->tileRows * scheduler->tileColumns;
+    scheduler->threads = threads < 1 ? 1 : threads;
+    scheduler->pinning = pinning;
+
+    scheduler->changed = (unsigned char *)calloc(scheduler->tiles, 1);
+    scheduler->active = (unsigned char *)calloc(scheduler->tiles, 1);
+    scheduler->activeList = (int *)calloc(scheduler->tiles, sizeof(int));
+    scheduler->tileStats = (GenerationStats *)calloc(scheduler->tiles, sizeof(GenerationStats));
+    scheduler->workers = (TileWorker *)aligned_alloc(TILE_CACHE_LINE, ((sizeof(TileWorker) * scheduler->threads + TILE_CACHE_LINE - 1) / TILE_CACHE_LINE) * TILE_CACHE_LINE);
+
+    if (scheduler->changed == NULL || scheduler->active == NULL || scheduler->activeList == NULL || scheduler->tileStats == NULL || scheduler->workers == NULL)
+    {
+        tileSchedulerRelease(scheduler, 0);
+        return NULL;
+    }
+
+    memset(scheduler->workers, 0, sizeof(TileWorker) * scheduler->threads);
+    for (int w = 0; w < scheduler->threads; w++)
+    {
+        TileWorker *worker = &scheduler->workers[w];
+        worker->scheduler = scheduler;
+        worker->index = w;
+        worker->seed = 0x9E3779B9u * (w + 1);
+        worker->pinned = -1;
+        worker->node = -1;
+        worker->deque.tasks = (int *)calloc(scheduler->tiles, sizeof(int));
+        if (worker->deque.tasks == NULL)
+        {
+            tileSchedulerRelease(scheduler, scheduler->threads);
+            return NULL;
+        }
+    }
+
+    pthread_barrier_init(&scheduler->start, NULL, scheduler->threads);
+    pthread_barrier_init(&scheduler->finish, NULL, scheduler->threads);
+    pthread_mutex_init(&scheduler->launch, NULL);
+
+    // The calling thread is worker 0, the others get threads of their own
+    pthread_mutex_lock(&scheduler->launch);
+    for (int w = 1; w < scheduler->threads; w++)
+    {
+        if (pthread_create(&scheduler->workers[w].thread, NULL, tileWorkerThread, &scheduler->workers[w]) != 0)
+        {
+            // The threads created so far quit as soon as they pass the launch lock
+            pthread_mutex_unlock(&scheduler->launch);
+            for (int created = 1; created < w; created++)
+            {
+                pthread_join(scheduler->workers[created].thread, NULL);
+            }
+            pthread_barrier_destroy(&scheduler->start);
+            pthread_barrier_destroy(&scheduler->finish);
+            pthread_mutex_destroy(&scheduler->launch);
+            tileSchedulerRelease(scheduler, scheduler->threads);
+            return NULL;
+        }
+    }
+    scheduler->launched = 1;
+    pthread_mutex_unlock(&scheduler->launch);
+
+    tileSchedulerReset(scheduler);
+
+    return scheduler;
+}
+
+void tileSchedulerReset(TileScheduler *scheduler)
+{
+    memset(scheduler->changed, 1, scheduler->tiles);
+}
+
+// Pin the thread stepping the board as worker 0, if it is not pinned yet
+//    Param: (TileScheduler*) scheduler (The scheduler)
+static void tilePinCaller(TileScheduler *scheduler)
+{
+    if (scheduler->pinning == NUMA_PIN_NONE || (scheduler->callerPinned && pthread_equal(scheduler->caller, pthread_self())))
+    {
+        return;
+    }
+
+    scheduler->caller = pthread_self();
+    scheduler->callerPinned = 1;
+    scheduler->workers[0].pinned = numaPin(0, scheduler->threads, scheduler->pinning);
+}
+
+void tileSchedulerFirstTouch(TileScheduler *scheduler, int **currentBoard, int **nextBoard)
+{
+    tilePinCaller(scheduler);
+    scheduler->currentBoard = currentBoard;
+    scheduler->nextBoard = nextBoard;
+
+    // Every tile is active in the first generation, so the blocks dealt now are the blocks calculated then
+    for (int t = 0; t < scheduler->tiles; t++)
+    {
+        scheduler->activeList[t] = t;
+    }
+    tileDispatch(scheduler, TILE_TOUCH, scheduler->tiles);
+}
+
+// Add up the statistics of all tiles, skipped tiles had neither births nor deaths
+//    Param: (TileScheduler*) scheduler (The scheduler)
+//           (StatsRecorder*) recorder (Receives the statistics of the generation)
+static void tileRecordStats(TileScheduler *scheduler, StatsRecorder *recorder)
+{
+    GenerationStats stats;
+    statsReset(&stats, 0);
+
+    for (int t = 0; t < scheduler->tiles; t++)
+    {
+        if (!scheduler->active[t])
+        {
+            scheduler->tileStats[t].births = 0;
+            scheduler->tileStats[t].deaths = 0;
+        }
+        statsMerge(&stats, &scheduler->tileStats[t]);
+    }
+
+    statsRecord(recorder, &stats);
+}
+
+void tileSchedulerStep(TileScheduler *scheduler, int generations, int **currentBoard, int **nextBoard, StatsRecorder *recorder)
+{
+    double begin = tileClock();
+
+    tilePinCaller(scheduler);
+    scheduler->currentBoard = currentBoard;
+    scheduler->nextBoard = nextBoard;
+
+    for (int g = 0; g < generations; g++)
+    {
+        // A tile can only change if itself or a neighbour tile changed last generation
+        memset(scheduler->active, 0, scheduler->tiles);
+        for (int r = 0; r < scheduler->tileRows; r++)
+        {
+            for (int c = 0; c < scheduler->tileColumns; c++)
+            {
+                if (!scheduler->changed[r * scheduler->tileColumns + c])
+                {
+                    continue;
+                }
+                for (int i = r - 1; i <= r + 1; i++)
+                {
+                    for (int j = c - 1; j <= c + 1; j++)
+                    {
+                        if (i >= 0 && j >= 0 && i < scheduler->tileRows && j < scheduler->tileColumns)
+                        {
+                            scheduler->active[i * scheduler->tileColumns + j] = 1;
+                        }
+                    }
+                }
+            }
+        }
+
+        int count = 0;
+        for (int t = 0; t < scheduler->tiles; t++)
+        {
+            if (scheduler->active[t])
+            {
+                scheduler->activeList[count++] = t;
+            }
+            else
+            {
+                scheduler->changed[t] = 0;
+            }
+        }
+
+        // A stable board needs no calculation, every further generation is the same
+        if (count > 0)
+        {
+            tileDispatch(scheduler, TILE_CALCULATE, count);
+            tileDispatch(scheduler, TILE_COMMIT, count);
+        }
+
+        if (recorder != NULL)
+        {
+            tileRecordStats(scheduler, recorder);
+        }
+        else if (count == 0)
+        {
+            break;
+        }
+    }
+
+    scheduler->wallSeconds += tileClock() - begin;
+}
+
+TileThreadStats tileSchedulerThreadStats(TileScheduler *scheduler, int thread)
+{
+    return scheduler->workers[thread].stats;
+}
+
+void tileSchedulerReport(TileScheduler *scheduler, FILE *out)
+{
+    fprintf(out, "Tile scheduler: %d threads, %d tiles of %dx%d, %.3f s stepping\n", scheduler->threads, scheduler->tiles, scheduler->tileSize, scheduler->tileSize, scheduler->wallSeconds);
+    for (int w = 0; w < scheduler->threads; w++)
+    {
+        TileThreadStats stats = scheduler->workers[w].stats;
+        double utilisation = scheduler->wallSeconds > 0 ? 100.0 * stats.busySeconds / scheduler->wallSeconds : 0;
+        fprintf(out, "    Thread %2d: %5.1f%% busy, %ld tiles, %ld steals\n", w, utilisation, stats.tiles, stats.steals);
+    }
+}
+
+void tileSchedulerPlacement(TileScheduler *scheduler, FILE *out)
+{
+    fprintf(out, "Placement: %d NUMA nodes, threads pinned to %s\n", numaNodes(), numaPinningName(scheduler->pinning));
+    for (int w = 0; w < scheduler->threads; w++)
+    {
+        TileWorker *worker = &scheduler->workers[w];
+
+        // The first tile of every row of tiles in the thread's block tells where its memory is
+        int from = (int)((long)scheduler->tiles * w / scheduler->threads);
+        int to = (int)((long)scheduler->tiles * (w + 1) / scheduler->threads);
+        int local = 0, known = 0;
+        for (int t = from; t < to && scheduler->currentBoard != NULL; t++)
+        {
+            if (t != from && t % scheduler->tileColumns != 0)
+            {
+                continue;
+            }
+            int node = numaNodeOfAddress(&scheduler->currentBoard[t / scheduler->tileColumns * scheduler->tileSize][t % scheduler->tileColumns * scheduler->tileSize]);
+            known += node >= 0;
+            local += node >= 0 && node == worker->node;
+        }
+
+        fprintf(out, "    Thread %2d: ", w);
+        if (worker->pinned >= 0)
+        {
+            fprintf(out, "pinned to %s %d, ", scheduler->pinning == NUMA_PIN_CORES ? "cpu" : "node", worker->pinned);
+        }
+        fprintf(out, "running on node %d, %d of %d sampled pages of its tiles local\n", worker->node, local, known);
+    }
+}
+
+void tileSchedulerFree(TileScheduler *scheduler)
+{
+    if (scheduler == NULL)
+    {
+        return;
+    }
+
+    scheduler->phase = TILE_QUIT;
+    pthread_barrier_wait(&scheduler->start);
+    for (int w = 1; w < scheduler->threads; w++)
+    {
+        pthread_join(scheduler->workers[w].thread, NULL);
+    }
+
+    pthread_barrier_destroy(&scheduler->start);
+    pthread_barrier_destroy(&scheduler->finish);
+    pthread_mutex_destroy(&scheduler->launch);
+    tileSchedulerRelease(scheduler, scheduler->threads);
+}
@@ -0,0 +1,402 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <tune.h>
+#include <lifeoptions.h>
+
+/* -------------------------------------------------------------------------- */
+/*        Choice of the fastest engine for a board size, on this machine       */
+/* -------------------------------------------------------------------------- */
+
+// Most candidates measured in one tuning
+#define TUNE_MAX_CANDIDATES 64
+
+// Longest line of a profile
+#define TUNE_LINE 512
+
+// Seed of the random board measured, the same for every candidate and every tuning
+#define TUNE_SEED 0x9E3779B97F4A7C15ULL
+
+/* -------------------------- Utilities of the Tuner ------------------------- */
+// Current time
+//    Return: (double) Seconds since an arbitrary point in the past
+static double tuneNow()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// Number of cores online
+//    Return: (int) The cores, 1 if the system does not tell
+static int tuneCores()
+{
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return cores > 0 ? (int)cores : 1;
+}
+
+// Model of the CPU, as /proc/cpuinfo names it, with no tabs in it
+//    Param: (string) model (Receives the model, "unknown" if it can not be read)
+//           (size_t) size (Size of the model)
+static void tuneCpuModel(char *model, size_t size)
+{
+    char line[TUNE_LINE];
+    snprintf(model, size, "unknown");
+
+    FILE *cpuinfo = fopen("/proc/cpuinfo", "r");
+    if (cpuinfo == NULL)
+    {
+        return;
+    }
+
+    // x86 says model name, other architectures say Processor, cpu model or Hardware
+    while (fgets(line, sizeof(line), cpuinfo) != NULL)
+    {
+        char *colon = strchr(line, ':');
+        if (colon == NULL || (strncmp(line, "model name", 10) != 0 && strncmp(line, "Processor", 9) != 0 && strncmp(line, "cpu model", 9) != 0 &&
+                              strncmp(line, "Hardware", 8) != 0))
+        {
+            continue;
+        }
+
+        char *value = colon + 1 + strspn(colon + 1, " \t");
+        value[strcspn(value, "\n")] = '\0';
+        snprintf(model, size, "%s", value);
+        for (char *c = model; *c != '\0'; c++)
+        {
+            *c = *c == '\t' ? ' ' : *c;
+        }
+        break;
+    }
+
+    fclose(cpuinfo);
+}
+
+// Key of the profile lines for a board size on this machine: CPU model, cores and board size, tab separated
+//    Param: (int) HEIGHT (HEIGHT of Board)
+//           (int) WIDTH (WIDTH of Board)
+//           (string) key (Receives the key)
+//           (size_t) size (Size of the key)
+static void tuneKey(int HEIGHT, int WIDTH, char *key, size_t size)
+{
+    char model[TUNE_LINE / 2];
+    tuneCpuModel(model, sizeof(model));
+    snprintf(key, size, "%s\t%d\t%dx%d\t", model, tuneCores(), HEIGHT, WIDTH);
+}
+
+// Copy the engine options, and only them, from a tuning
+//    Param: (LifeOptions*) options (Receives the engine options)
+//           (LifeOptions*) tuned (The tuned options)
+static void tuneCopyEngine(LifeOptions *options, LifeOptions *tuned)
+{
+    options->engine = tuned->engine;
+    options->processes = tuned->processes;
+    options->threads = tuned->threads;
+    options->tileSize = tuned->tileSize;
+    options->depth = tuned->depth;
+}
+
+// List the candidates for a tuning
+//    Param: (LifeOptions*) base (Options every candidate starts from)
+//           (LifeOptions*) candidates (Receives the candidates, TUNE_MAX_CANDIDATES at most)
+//    Return: (int) Number of candidates
+static int tuneCandidates(LifeOptions *base, LifeOptions *candidates)
+{
+    int count = 0;
+    int cores = tuneCores();
+    int tileSizes[] = TUNE_TILE_SIZES;
+    int depths[] = {0, 2, 8};
+    LifeEngine single[] = {GENERIC_ENGINE, INPLACE_ENGINE, ZORDER_ENGINE, CHANGELIST_ENGINE};
+
+    for (int e = 0; e < (int)(sizeof(single) / sizeof(single[0])); e++)
+    {
+        candidates[count] = *base;
+        candidates[count].engine = single[e];
+        count++;
+    }
+
+    for (int d = 0; d < (int)(sizeof(depths) / sizeof(depths[0])); d++)
+    {
+        candidates[count] = *base;
+        candidates[count].engine = TEMPORAL_ENGINE;
+        candidates[count].depth = depths[d];
+        count++;
+    }
+
+    // Powers of two below the cores, and all of them
+    int threadCounts[TUNE_MAX_CANDIDATES];
+    int threadCountCount = 0;
+    for (int threads = 1; threads < cores; threads *= 2)
+    {
+        threadCounts[threadCountCount++] = threads;
+    }
+    threadCounts[threadCountCount++] = cores;
+
+    int tileSizeCount = (int)(sizeof(tileSizes) / sizeof(tileSizes[0]));
+    for (int n = 0; n < threadCountCount && count + tileSizeCount + 1 <= TUNE_MAX_CANDIDATES; n++)
+    {
+        for (int t = 0; t < tileSizeCount; t++)
+        {
+            candidates[count] = *base;
+            candidates[count].engine = TILE_ENGINE;
+            candidates[count].threads = threadCounts[n];
+            candidates[count].tileSize = tileSizes[t];
+            count++;
+        }
+
+        if (threadCounts[n] > 1)
+        {
+            candidates[count] = *base;
+            candidates[count].engine = DOMAIN_ENGINE;
+            candidates[count].processes = threadCounts[n];
+            count++;
+        }
+    }
+
+    return count;
+}
+
+// Fill a board with random Cells from a generator of its own, so that rand() is left alone
+//    Param: (Life*) life (The Life)
+static void tuneRandomBoard(Life *life)
+{
+    uint64_t state = TUNE_SEED;
+    int **board = lifeBoard(life);
+
+    for (int i = 0; i < lifeHeight(life); i++)
+    {
+        for (int j = 0; j < lifeWidth(life); j++)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            board[i][j] = state >> 63;
+        }
+    }
+    lifeBoardChanged(life);
+}
+
+// Measure a candidate on a board
+//    Param: (LifeOptions*) candidate (The candidate)
+//           (Life*) reference (The board measured, left as it is)
+//    Return: (double) Seconds per generation, -1 if the candidate could not run
+static double tuneCandidate(LifeOptions *candidate, Life *reference)
+{
+    int HEIGHT = lifeHeight(reference), WIDTH = lifeWidth(reference);
+    Life *life = lifeCreate(HEIGHT, WIDTH, candidate);
+    if (life == NULL)
+    {
+        return -1;
+    }
+
+    int **from = lifeBoard(reference), **to = lifeBoard(life);
+    for (int i = 0; i < HEIGHT; i++)
+    {
+        memcpy(to[i], from[i], WIDTH * sizeof(int));
+    }
+
+    // An engine falling back to the single process one is no candidate, starting and the first generation are not timed
+    if (!lifeStart(life))
+    {
+        lifeFree(life);
+        return -1;
+    }
+    lifeStep(life, 1);
+
+    double seconds = 0;
+    long generations = 0;
+    for (int chunk = 1; seconds < TUNE_SECONDS; chunk *= 2)
+    {
+        double start = tuneNow();
+        lifeStep(life, chunk);
+        seconds += tuneNow() - start;
+        generations += chunk;
+    }
+
+    lifeFree(life);
+    return seconds / generations;
+}
+
+/* -------------------------------- Tuner API -------------------------------- */
+void tuneDescribe(LifeOptions *options, char *description, size_t size)
+{
+    switch (options->engine)
+    {
+    case DOMAIN_ENGINE:
+        snprintf(description, size, "%s, %d processes", lifeEngineName(options->engine), options->processes);
+        break;
+    case TILE_ENGINE:
+        if (options->tileSize > 0)
+        {
+            snprintf(description, size, "%s, %d threads, %dx%d tiles", lifeEngineName(options->engine), options->threads, options->tileSize, options->tileSize);
+        }
+        else
+        {
+            snprintf(description, size, "%s, %d threads", lifeEngineName(options->engine), options->threads);
+        }
+        break;
+    case TEMPORAL_ENGINE:
+        if (options->depth > 0)
+        {
+            snprintf(description, size, "%s, depth %d", lifeEngineName(options->engine), options->depth);
+        }
+        else
+        {
+            snprintf(description, size, "%s, depth from the cache size", lifeEngineName(options->engine));
+        }
+        break;
+    default:
+        snprintf(description, size, "%s", lifeEngineName(options->engine));
+        break;
+    }
+}
+
+int tuneLookup(char *profileName, int HEIGHT, int WIDTH, LifeOptions *options)
+{
+    char key[TUNE_LINE], line[TUNE_LINE];
+    tuneKey(HEIGHT, WIDTH, key, sizeof(key));
+
+    FILE *profile = fopen(profileName, "r");
+    if (profile == NULL)
+    {
+        return -1;
+    }
+
+    int found = -1;
+    while (found != 0 && fgets(line, sizeof(line), profile) != NULL)
+    {
+        LifeOptions tuned;
+        int engine;
+        if (strncmp(line, key, strlen(key)) != 0 ||
+            sscanf(line + strlen(key), "%d %d %d %d %d", &engine, &tuned.processes, &tuned.threads, &tuned.tileSize, &tuned.depth) != 5 ||
+            engine < GENERIC_ENGINE || engine > CHANGELIST_ENGINE)
+        {
+            continue;
+        }
+        tuned.engine = (LifeEngine)engine;
+        tuneCopyEngine(options, &tuned);
+        found = 0;
+    }
+
+    fclose(profile);
+    return found;
+}
+
+double tuneMeasure(int HEIGHT, int WIDTH, LifeOptions *options, FILE *progress)
+{
+    // Candidates only calculate: no history, series, counters or pinning of their own
+    LifeOptions base = *options;
+    base.historyMegabytes = 0;
+    base.keepSeries = 0;
+    base.counters = 0;
+    base.pinning = NUMA_PIN_NONE;
+
+    LifeOptions reference = base;
+    reference.engine = GENERIC_ENGINE;
+    Life *board = lifeCreate(HEIGHT, WIDTH, &reference);
+    if (board == NULL)
+    {
+        return -1;
+    }
+    tuneRandomBoard(board);
+    lifeStepFastest(board, TUNE_SETTLE_GENERATIONS);
+
+    LifeOptions candidates[TUNE_MAX_CANDIDATES];
+    int count = tuneCandidates(&base, candidates);
+    int fastest = -1;
+    double fastestSeconds = -1;
+
+    for (int c = 0; c < count; c++)
+    {
+        char description[TUNE_LINE];
+        tuneDescribe(&candidates[c], description, sizeof(description));
+
+        double seconds = tuneCandidate(&candidates[c], board);
+        if (progress != NULL && seconds < 0)
+        {
+            fprintf(progress, "    %-48s could not run\n", description);
+        }
+        else if (progress != NULL)
+        {
+            fprintf(progress, "    %-48s %10.3f ms per generation\n", description, seconds * 1000);
+        }
+
+        if (seconds >= 0 && (fastest < 0 || seconds < fastestSeconds))
+        {
+            fastest = c;
+            fastestSeconds = seconds;
+        }
+    }
+
+    lifeFree(board);
+    if (fastest >= 0)
+    {
+        tuneCopyEngine(options, &candidates[fastest]);
+    }
+    return fastestSeconds;
+}
+
+int tuneStore(char *profileName, int HEIGHT, int WIDTH, LifeOptions *options, double seconds)
+{
+    char key[TUNE_LINE], line[TUNE_LINE];
+    tuneKey(HEIGHT, WIDTH, key, sizeof(key));
+
+    // The profile is written next to itself and renamed over it, so that a run reading it never sees half of it
+    char *temporaryName = (char *)malloc(strlen(profileName) + 8);
+    if (temporaryName == NULL)
+    {
+        return -1;
+    }
+    sprintf(temporaryName, "%s.%d", profileName, (int)getpid() % 100000);
+
+    FILE *temporary = fopen(temporaryName, "w");
+    if (temporary == NULL)
+    {
+        free(temporaryName);
+        return -1;
+    }
+
+    // Every other line is kept as it is
+    FILE *profile = fopen(profileName, "r");
+    if (profile != NULL)
+    {
+        while (fgets(line, sizeof(line), profile) != NULL)
+        {
+            if (strncmp(line, key, strlen(key)) != 0)
+            {
+                fputs(line, temporary);
+            }
+        }
+        fclose(profile);
+    }
+    fprintf(temporary, "%s%d %d %d %d %d\t%.9f\n", key, options->engine, options->processes, options->threads, options->tileSize, options->depth, seconds);
+
+    int written = fclose(temporary) == 0 && rename(temporaryName, profileName) == 0;
+    if (!written)
+    {
+        remove(temporaryName);
+    }
+    free(temporaryName);
+    return written ? 0 : -1;
+}
+
+int tuneOptions(char *profileName, int HEIGHT, int WIDTH, LifeOptions *options, FILE *progress)
+{
+    if (tuneLookup(profileName, HEIGHT, WIDTH, options) == 0)
+    {
+        return 1;
+    }
+
+    double seconds = tuneMeasure(HEIGHT, WIDTH, options, progress);
+    if (seconds < 0)
+    {
+        return -1;
+    }
+
+    // A profile that can not be written only means measuring again next time
+    tuneStore(profileName, HEIGHT, WIDTH, options, seconds);
+    return 0;
+}
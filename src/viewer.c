@@ -0,0 +1,70 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <econio.h>
+#include <arena.h>
+#include <publish.h>
+#include <render.h>
+
+/* -------------------------------------------------------------------------- */
+/*      Viewer: watches a game that publishes its board (./main -P name)      */
+/* -------------------------------------------------------------------------- */
+
+// Time between two looks at the shared memory, in milliseconds
+#define VIEWER_REFRESH 50
+
+int main(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        printf("Usage: %s name\n", argv[0]);
+        printf("    Watch the game started with -P name, without slowing it down.\n");
+        return 1;
+    }
+
+    Viewer *viewer = viewerOpen(argv[1]);
+    if (viewer == NULL)
+    {
+        printf("No game publishes its board as %s.\n", argv[1]);
+        return 1;
+    }
+
+    int HEIGHT = viewerHeight(viewer);
+    int WIDTH = viewerWidth(viewer);
+
+    // The copy of the board lives in an arena, like the boards of the game
+    Arena *arena = arenaCreate(arenaBoardSize(HEIGHT, WIDTH), ARENA_NORMAL_PAGES);
+    int **board = arena != NULL ? arenaBoardAllocate(arena, HEIGHT, WIDTH) : NULL;
+    if (board == NULL)
+    {
+        printf("Not enough memory for a %dx%d board.\n", HEIGHT, WIDTH);
+        arenaFree(arena);
+        viewerClose(viewer);
+        return 1;
+    }
+
+    GenerationStats stats;
+
+    econio_rawmode();
+    while (1)
+    {
+        // The game never waits for us: only redraw when it published a new frame
+        if (viewerRead(viewer, board, &stats))
+        {
+            frameBoard(HEIGHT, WIDTH, board, stats.generation > 0 ? &stats : NULL);
+            econio_frame_printf("\nWatching %s | Press [ESC] to quit\n", argv[1]);
+            econio_frame_commit();
+        }
+
+        if (econio_kbhit() && econio_getch() == KEY_ESCAPE)
+        {
+            break;
+        }
+        usleep(VIEWER_REFRESH * 1000);
+    }
+    econio_normalmode();
+
+    arenaFree(arena);
+    viewerClose(viewer);
+    return 0;
+}
@@ -0,0 +1,280 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zboard.h>
+
+/* -------------------------------------------------------------------------- */
+/*            Board stored in square tiles placed in Z-order (Morton)         */
+/* -------------------------------------------------------------------------- */
+
+// Cells in one tile
+#define ZBOARD_TILE_CELLS (ZBOARD_TILE * ZBOARD_TILE)
+
+// Side of the local buffer a tile is stepped in: the tile and a one Cell halo
+#define ZBOARD_LOCAL (ZBOARD_TILE + 2)
+
+struct ZBoard
+{
+    int HEIGHT;
+    int WIDTH;
+    int tileRows;
+    int tileColumns;
+
+    // offsets[tile row * tileColumns + tile column]: where the tile starts in cells
+    size_t *offsets;
+
+    // Tile indices in Morton order, the order the tiles lie in memory
+    int *order;
+
+    unsigned char *cells;
+    unsigned char *next;
+};
+
+/* --------------------------- Utilities of a ZBoard ------------------------- */
+// Spread the lower 16 bits of a number to the even bits
+//    Param: (unsigned int) x (The number)
+//    Return: (unsigned int) The spread bits
+static unsigned int zboardSpread(unsigned int x)
+{
+    x &= 0xFFFF;
+    x = (x | (x << 8)) & 0x00FF00FF;
+    x = (x | (x << 4)) & 0x0F0F0F0F;
+    x = (x | (x << 2)) & 0x33333333;
+    x = (x | (x << 1)) & 0x55555555;
+    return x;
+}
+
+// Morton code of a tile, rows on the odd bits and columns on the even bits (Up to 65536 tiles per side)
+//    Param: (int) row (Tile row)
+//           (int) column (Tile column)
+//    Return: (unsigned long) The code
+static unsigned long zboardMorton(int row, int column)
+{
+    return (unsigned long)zboardSpread(row) << 1 | zboardSpread(column);
+}
+
+// Comparison of two tiles by Morton code, for qsort
+static int zboardCompare(const void *a, const void *b)
+{
+    const unsigned long *x = (const unsigned long *)a;
+    const unsigned long *y = (const unsigned long *)b;
+    return x[0] < y[0] ? -1 : (x[0] > y[0] ? 1 : 0);
+}
+
+// Address of a Cell in a buffer of the board
+//    Param: (ZBoard*) board (The board)
+//           (unsigned char*) cells (The buffer)
+//           (int) r (Row of the Cell)
+//           (int) c (Column of the Cell)
+//    Return: (unsigned char*) Address of the Cell
+static inline unsigned char *zboardCell(ZBoard *board, unsigned char *cells, int r, int c)
+{
+    size_t tile = board->offsets[(r / ZBOARD_TILE) * board->tileColumns + c / ZBOARD_TILE];
+    return cells + tile + (r % ZBOARD_TILE) * ZBOARD_TILE + c % ZBOARD_TILE;
+}
+
+/* ------------------------------- ZBoard API -------------------------------- */
+ZBoard *zboardCreate(int HEIGHT, int WIDTH)
+{
+    ZBoard *board = (ZBoard *)calloc(1, sizeof(ZBoard));
+    if (board == NULL)
+    {
+        return NULL;
+    }
+
+    board->HEIGHT = HEIGHT;
+    board->WIDTH = WIDTH;
+    board->tileRows = (HEIGHT + ZBOARD_TILE - 1) / ZBOARD_TILE;
+    board->tileColumns = (WIDTH + ZBOARD_TILE - 1) / ZBOARD_TILE;
+
+    int tiles = board->tileRows * board->tileColumns;
+    board->offsets = (size_t *)malloc(tiles * sizeof(size_t));
+    board->order = (int *)malloc(tiles * sizeof(int));
+    unsigned long *codes = (unsigned long *)malloc(tiles * 2 * sizeof(unsigned long));
+
+    // Tiles are page sized, so page alignment keeps every tile on a single page
+    board->cells = (unsigned char *)aligned_alloc(ZBOARD_TILE_CELLS, (size_t)tiles * ZBOARD_TILE_CELLS);
+    board->next = (unsigned char *)aligned_alloc(ZBOARD_TILE_CELLS, (size_t)tiles * ZBOARD_TILE_CELLS);
+
+    if (board->offsets == NULL || board->order == NULL || codes == NULL || board->cells == NULL || board->next == NULL)
+    {
+        free(codes);
+        zboardFree(board);
+        return NULL;
+    }
+
+    // Sort the tiles by Morton code, the rank of a tile is its place in memory
+    for (int t = 0; t < tiles; t++)
+    {
+        codes[2 * t] = zboardMorton(t / board->tileColumns, t % board->tileColumns);
+        codes[2 * t + 1] = t;
+    }
+    qsort(codes, tiles, 2 * sizeof(unsigned long), zboardCompare);
+    for (int rank = 0; rank < tiles; rank++)
+    {
+        int t = (int)codes[2 * rank + 1];
+        board->order[rank] = t;
+        board->offsets[t] = (size_t)rank * ZBOARD_TILE_CELLS;
+    }
+    free(codes);
+
+    // Cells past the edge of the board inside edge tiles stay dead forever
+    memset(board->cells, 0, (size_t)tiles * ZBOARD_TILE_CELLS);
+    memset(board->next, 0, (size_t)tiles * ZBOARD_TILE_CELLS);
+
+    return board;
+}
+
+void zboardFree(ZBoard *board)
+{
+    if (board == NULL)
+    {
+        return;
+    }
+
+    free(board->offsets);
+    free(board->order);
+    free(board->cells);
+    free(board->next);
+    free(board);
+}
+
+int zboardGet(ZBoard *board, int r, int c)
+{
+    return *zboardCell(board, board->cells, r, c);
+}
+
+void zboardSet(ZBoard *board, int r, int c, int value)
+{
+    *zboardCell(board, board->cells, r, c) = value == 1;
+}
+
+void zboardLoad(ZBoard *board, int **currentBoard)
+{
+    for (int i = 0; i < board->HEIGHT; i++)
+    {
+        for (int c = 0; c < board->tileColumns; c++)
+        {
+            // Every row of a tile is contiguous, so copy it in one run
+            int left = c * ZBOARD_TILE;
+            int right = left + ZBOARD_TILE < board->WIDTH ? left + ZBOARD_TILE : board->WIDTH;
+            unsigned char *target = zboardCell(board, board->cells, i, left);
+            for (int j = left; j < right; j++)
+            {
+                target[j - left] = currentBoard[i][j] == 1;
+            }
+        }
+    }
+}
+
+void zboardStore(ZBoard *board, int **currentBoard)
+{
+    for (int i = 0; i < board->HEIGHT; i++)
+    {
+        for (int c = 0; c < board->tileColumns; c++)
+        {
+            int left = c * ZBOARD_TILE;
+            int right = left + ZBOARD_TILE < board->WIDTH ? left + ZBOARD_TILE : board->WIDTH;
+            unsigned char *source = zboardCell(board, board->cells, i, left);
+            for (int j = left; j < right; j++)
+            {
+                currentBoard[i][j] = source[j - left];
+            }
+        }
+    }
+}
+
+/* ------------------------------- Tile Kernel ------------------------------- */
+// Copy a tile and the ring of Cells around it into a local buffer, Cells outside the board are dead
+//    Param: (ZBoard*) board (The board)
+//           (int) tileRow, tileColumn (The tile)
+//           (unsigned char*) local (Buffer of ZBOARD_LOCAL x ZBOARD_LOCAL)
+static void zboardLoadHalo(ZBoard *board, int tileRow, int tileColumn, unsigned char local[ZBOARD_LOCAL][ZBOARD_LOCAL])
+{
+    int top = tileRow * ZBOARD_TILE;
+    int left = tileColumn * ZBOARD_TILE;
+    unsigned char *tile = board->cells + board->offsets[tileRow * board->tileColumns + tileColumn];
+
+    for (int i = 0; i < ZBOARD_TILE; i++)
+    {
+        memcpy(&local[i + 1][1], tile + i * ZBOARD_TILE, ZBOARD_TILE);
+    }
+
+    // The ring comes from the 8 neighbour tiles, a few Cells each
+    for (int k = -1; k <= ZBOARD_TILE; k++)
+    {
+        int r = top + k;
+        int c = left + k;
+        int inRows = r >= 0 && r < board->HEIGHT;
+        int inColumns = c >= 0 && c < board->WIDTH;
+
+        local[k + 1][0] = inRows && left > 0 ? *zboardCell(board, board->cells, r, left - 1) : 0;
+        local[k + 1][ZBOARD_LOCAL - 1] = inRows && left + ZBOARD_TILE < board->WIDTH ? *zboardCell(board, board->cells, r, left + ZBOARD_TILE) : 0;
+        local[0][k + 1] = inColumns && top > 0 ? *zboardCell(board, board->cells, top - 1, c) : 0;
+        local[ZBOARD_LOCAL - 1][k + 1] = inColumns && top + ZBOARD_TILE < board->HEIGHT ? *zboardCell(board, board->cells, top + ZBOARD_TILE, c) : 0;
+    }
+}
+
+// Calculate the next generation of one tile into the next buffer
+//    Param: (ZBoard*) board (The board)
+//           (int) tile (Index of the tile)
+//           (GenerationStats*) stats (Statistics of the generation, or NULL)
+static void zboardStepTile(ZBoard *board, int tile, GenerationStats *stats)
+{
+    unsigned char local[ZBOARD_LOCAL][ZBOARD_LOCAL];
+    unsigned char columns[ZBOARD_LOCAL];
+    int tileRow = tile / board->tileColumns;
+    int tileColumn = tile % board->tileColumns;
+
+    zboardLoadHalo(board, tileRow, tileColumn, local);
+
+    // Only the part of an edge tile that lies on the board is calculated, the rest stays dead
+    int rows = board->HEIGHT - tileRow * ZBOARD_TILE < ZBOARD_TILE ? board->HEIGHT - tileRow * ZBOARD_TILE : ZBOARD_TILE;
+    int cols = board->WIDTH - tileColumn * ZBOARD_TILE < ZBOARD_TILE ? board->WIDTH - tileColumn * ZBOARD_TILE : ZBOARD_TILE;
+    unsigned char *out = board->next + board->offsets[tile];
+
+    for (int i = 1; i <= rows; i++)
+    {
+        for (int j = 0; j <= cols + 1; j++)
+        {
+            columns[j] = local[i - 1][j] + local[i][j] + local[i + 1][j];
+        }
+        for (int j = 1; j <= cols; j++)
+        {
+            unsigned char count = columns[j - 1] + columns[j] + columns[j + 1] - local[i][j];
+            out[(i - 1) * ZBOARD_TILE + j - 1] = (count == 3) | ((count == 2) & local[i][j]);
+        }
+
+        // The row just written is still in the cache, count it while it is there
+        if (stats != NULL)
+        {
+            statsAccountBytes(stats, &local[i][1], out + (i - 1) * ZBOARD_TILE, cols, tileRow * ZBOARD_TILE + i - 1, tileColumn * ZBOARD_TILE);
+        }
+    }
+}
+
+void zboardStep(ZBoard *board, int generations, StatsRecorder *recorder)
+{
+    int tiles = board->tileRows * board->tileColumns;
+    GenerationStats stats;
+
+    for (int g = 0; g < generations; g++)
+    {
+        statsReset(&stats, 0);
+
+        // Walk the tiles in memory order
+        for (int rank = 0; rank < tiles; rank++)
+        {
+            zboardStepTile(board, board->order[rank], recorder != NULL ? &stats : NULL);
+        }
+
+        if (recorder != NULL)
+        {
+            statsRecord(recorder, &stats);
+        }
+
+        unsigned char *swap = board->cells;
+        board->cells = board->next;
+        board->next = swap;
+    }
+}